@@ -0,0 +1,98 @@
+#include "data_generator.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace fusion {
+namespace bench {
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+const double SAMPLE_PERIOD = 0.01;            // 100 Hz
+
+// 모사하는 구조물 진동과 센서 잡음 (bin/input.csv의 값 범위에 맞춤)
+const double SWAY_FREQUENCY_Y = 0.20;         // Hz
+const double SWAY_FREQUENCY_Z = 0.05;         // Hz
+const double SWAY_ACCELERATION_Y = 2.0e-4;    // m/s^2
+const double SWAY_ACCELERATION_Z = 1.0e-4;    // m/s^2
+const double ACC_NOISE = 1.3e-4;              // m/s^2
+const double GNSS_NOISE_Y = 2.0e-3;           // m
+const double GNSS_NOISE_Z = 1.0e-3;           // m
+const double BASE_Y = 0.0;                    // m
+const double BASE_Z = 113.196;                // m
+
+// 2024-01-01 00:00:00.000부터 10 ms 간격
+int format_timestamp(char* out, size_t size, size_t index) {
+    unsigned long long total_ms = static_cast<unsigned long long>(index) * 10;
+    unsigned long long ms = total_ms % 1000;
+    unsigned long long total_s = total_ms / 1000;
+    unsigned long long s = total_s % 60;
+    unsigned long long m = (total_s / 60) % 60;
+    unsigned long long h = (total_s / 3600) % 24;
+    unsigned long long day = 1 + total_s / 86400;
+    return std::snprintf(out, size, "2024-01-%02llu %02llu:%02llu:%02llu.%03llu", day, h, m, s, ms);
+}
+
+} // namespace
+
+bool generate_synthetic_csv(const std::string& file_path, const SyntheticDataOptions& options) {
+    std::FILE* file = std::fopen(file_path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    std::mt19937_64 rng(options.seed);
+    std::normal_distribution<double> unit(0.0, 1.0);
+    const size_t gnss_interval = options.gnss_interval > 0 ? options.gnss_interval : 1;
+
+    std::vector<char> buffer;
+    buffer.reserve(1 << 20);
+    auto flush = [&]() {
+        bool ok = std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+        buffer.clear();
+        return ok;
+    };
+
+    static const char header[] = "DateTime,GPS_Y,GPS_Z,Acc_Y,Acc_Z,Fix\r\n";
+    buffer.insert(buffer.end(), header, header + sizeof(header) - 1);
+
+    const double omega_y = 2.0 * PI * SWAY_FREQUENCY_Y;
+    const double omega_z = 2.0 * PI * SWAY_FREQUENCY_Z;
+    bool ok = true;
+    char line[160];
+    for (size_t i = 0; i < options.rows && ok; i++) {
+        double t = static_cast<double>(i) * SAMPLE_PERIOD;
+
+        // a = A sin(wt) 이면 변위는 -A/w^2 sin(wt)
+        double acc_y = SWAY_ACCELERATION_Y * std::sin(omega_y * t);
+        double acc_z = SWAY_ACCELERATION_Z * std::sin(omega_z * t);
+        double position_y = BASE_Y - acc_y / (omega_y * omega_y);
+        double position_z = BASE_Z - acc_z / (omega_z * omega_z);
+
+        int length = format_timestamp(line, sizeof(line), i);
+        if (i % gnss_interval == 0) {
+            length += std::snprintf(line + length, sizeof(line) - length, ",%.6g,%.6f,%.6g,%.6g,3\r\n",
+                                    position_y + GNSS_NOISE_Y * unit(rng),
+                                    position_z + GNSS_NOISE_Z * unit(rng),
+                                    acc_y + ACC_NOISE * unit(rng),
+                                    acc_z + ACC_NOISE * unit(rng));
+        } else {
+            length += std::snprintf(line + length, sizeof(line) - length, ",,,%.6g,%.6g,\r\n",
+                                    acc_y + ACC_NOISE * unit(rng),
+                                    acc_z + ACC_NOISE * unit(rng));
+        }
+        buffer.insert(buffer.end(), line, line + length);
+        if (buffer.size() >= (1 << 20) - sizeof(line)) {
+            ok = flush();
+        }
+    }
+
+    ok = ok && flush();
+    ok = std::fclose(file) == 0 && ok;
+    return ok;
+}
+
+} // namespace bench
+} // namespace fusion
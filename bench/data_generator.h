@@ -0,0 +1,33 @@
+#ifndef DATA_GENERATOR_H
+#define DATA_GENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace fusion {
+namespace bench {
+
+// 합성 입력 데이터 설정 (bin/input.csv와 같은 컬럼/주기)
+struct SyntheticDataOptions {
+    size_t rows = 360000;         // 샘플 수 (100 Hz 기준 1시간)
+    size_t gnss_interval = 10;    // GNSS 측정 주기 (샘플 수, 10이면 10 Hz)
+    uint64_t seed = 42;           // 난수 시드 (같은 시드면 같은 파일)
+};
+
+/**
+ * 100 Hz 가속도 / 10 Hz GNSS 합성 입력 CSV 생성
+ *
+ * 구조물 진동을 모사한 저주파 가속도에 센서 잡음을 더하고, GNSS 행에만 위치와 Fix를 기록한다.
+ * GNSS가 없는 행은 bin/input.csv처럼 GPS_Y, GPS_Z, Fix 필드를 비워 둔다.
+ *
+ * @param file_path 출력 CSV 파일 경로
+ * @param options 생성 설정
+ * @return 성공 시 true, 실패 시 false
+ */
+bool generate_synthetic_csv(const std::string& file_path, const SyntheticDataOptions& options);
+
+} // namespace bench
+} // namespace fusion
+
+#endif // DATA_GENERATOR_H
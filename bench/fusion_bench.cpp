@@ -0,0 +1,278 @@
+// 파서, 필터, 라이터, C API 처리 모드 마이크로 벤치마크
+//
+// 사용법: fusion_bench [--rows N] [--repeat N] [--workdir DIR] [--json FILE]
+// 결과는 JSON으로 표준 출력(또는 --json 파일)에 기록한다.
+
+#include "data_generator.h"
+#include "fusion_api.h"
+#include "csv_parser.h"
+#include "kalman_filter.h"
+#include "kalman_models.h"
+#include "dual_axis_kalman_filter.h"
+#include "parallel_kalman_filter.h"
+#include "thread_pool.h"
+#include "data_structures.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace fusion;
+using namespace fusion::bench;
+
+namespace {
+
+struct BenchOptions {
+    size_t rows = 360000;
+    int repeat = 5;
+    std::string workdir;
+    std::string json_path;
+};
+
+struct BenchResult {
+    std::string name;
+    size_t rows;
+    double best_seconds;
+    double median_seconds;
+};
+
+// setup은 측정에서 제외하고 body만 repeat번 측정 (최솟값과 중앙값)
+BenchResult measure(const std::string& name, size_t rows, int repeat,
+                    const std::function<void()>& setup, const std::function<void()>& body) {
+    std::vector<double> seconds;
+    for (int i = 0; i < repeat; i++) {
+        if (setup) {
+            setup();
+        }
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto end = std::chrono::steady_clock::now();
+        seconds.push_back(std::chrono::duration<double>(end - start).count());
+    }
+    std::sort(seconds.begin(), seconds.end());
+    return BenchResult{name, rows, seconds.front(), seconds[seconds.size() / 2]};
+}
+
+std::string json_escape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out;
+}
+
+void write_json(std::ostream& out, const BenchOptions& options, const std::vector<BenchResult>& results) {
+    out << "{\n";
+    out << "  \"benchmark\": \"fusion_bench\",\n";
+    out << "  \"rows\": " << options.rows << ",\n";
+    out << "  \"repeat\": " << options.repeat << ",\n";
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        double rows_per_second = r.best_seconds > 0.0 ? static_cast<double>(r.rows) / r.best_seconds : 0.0;
+        double ns_per_sample = r.rows > 0 ? r.best_seconds * 1e9 / static_cast<double>(r.rows) : 0.0;
+        out << "    {\"name\": \"" << json_escape(r.name) << "\""
+            << ", \"rows\": " << r.rows
+            << ", \"seconds\": " << r.best_seconds
+            << ", \"median_seconds\": " << r.median_seconds
+            << ", \"rows_per_second\": " << rows_per_second
+            << ", \"ns_per_sample\": " << ns_per_sample
+            << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+bool parse_options(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--rows" && has_value) {
+            options.rows = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--repeat" && has_value) {
+            options.repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--workdir" && has_value) {
+            options.workdir = argv[++i];
+        } else if (arg == "--json" && has_value) {
+            options.json_path = argv[++i];
+        } else {
+            std::cerr << "Usage: fusion_bench [--rows N] [--repeat N] [--workdir DIR] [--json FILE]" << std::endl;
+            return false;
+        }
+    }
+    if (options.workdir.empty()) {
+        options.workdir = (fs::temp_directory_path() / "fusion_bench").string();
+    }
+    return options.rows >= 20;
+}
+
+// 모델별 KalmanFilterT로 Y축 전체 처리 (kalman_filter/process_batch/all과 같은 조건)
+template <typename Model>
+void run_model_filter(const KalmanParams& params, const SampleBlock& samples, std::vector<double>& displacement) {
+    KalmanFilterT<Model> filter(params);
+    filter.reset(samples.gps_y[0]);
+    filter.processBatch(samples.gps_y, samples.acc_y, samples.fix, displacement, true);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parse_options(argc, argv, options)) {
+        return 1;
+    }
+
+    fs::create_directories(options.workdir);
+    const std::string input_path = (fs::path(options.workdir) / "input.csv").string();
+    const std::string output_path = (fs::path(options.workdir) / "output.csv").string();
+    const std::string state_path = (fs::path(options.workdir) / "local_var_laststate.txt").string();
+
+    SyntheticDataOptions data_options;
+    data_options.rows = options.rows;
+    if (!generate_synthetic_csv(input_path, data_options)) {
+        std::cerr << "Error: Cannot create " << input_path << std::endl;
+        return 1;
+    }
+
+    const size_t n = options.rows;
+    const int repeat = options.repeat;
+    const KalmanParams params(0.1, 0.01);
+    std::vector<BenchResult> results;
+
+    // 파서
+    std::vector<InputData> rows;
+    results.push_back(measure("parse_csv/rows", n, repeat,
+        [&] { rows.clear(); rows.shrink_to_fit(); },
+        [&] { parse_csv(input_path, rows); }));
+
+    SampleBlock samples;
+    results.push_back(measure("parse_csv/columns", n, repeat,
+        [&] { samples = SampleBlock(); },
+        [&] { parse_csv(input_path, samples); }));
+
+    // 필터 (축 하나, 벡터 API)
+    std::vector<double> displacement_y;
+    results.push_back(measure("kalman_filter/process", n, repeat, nullptr, [&] {
+        KalmanFilter filter(params);
+        displacement_y = filter.process(samples.gps_y, samples.acc_y, samples.fix);
+    }));
+
+    // 배치 크기별 처리 (Span API, 출력 버퍼 재사용)
+    displacement_y.assign(n, 0.0);
+    std::vector<double> displacement_z(n, 0.0);
+    const size_t batch_sizes[] = {100, 1000, 10000, n};
+    for (size_t batch_size : batch_sizes) {
+        std::string suffix = batch_size == n ? "all" : std::to_string(batch_size);
+        results.push_back(measure("kalman_filter/process_batch/" + suffix, n, repeat, nullptr, [&] {
+            KalmanFilter filter(params);
+            filter.reset(samples.gps_y[0]);
+            for (size_t begin = 0; begin < n; begin += batch_size) {
+                size_t count = std::min(batch_size, n - begin);
+                filter.processBatch(Span<const double>(samples.gps_y).subspan(begin, count),
+                                    Span<const double>(samples.acc_y).subspan(begin, count),
+                                    Span<const int>(samples.fix).subspan(begin, count),
+                                    Span<double>(displacement_y).subspan(begin, count), begin == 0);
+            }
+        }));
+        results.push_back(measure("dual_axis_filter/process_batch/" + suffix, n, repeat, nullptr, [&] {
+            DualAxisKalmanFilter filter(params);
+            filter.reset(samples.gps_y[0], samples.gps_z[0]);
+            for (size_t begin = 0; begin < n; begin += batch_size) {
+                size_t count = std::min(batch_size, n - begin);
+                filter.processBatch(Span<const double>(samples.gps_y).subspan(begin, count),
+                                    Span<const double>(samples.gps_z).subspan(begin, count),
+                                    Span<const double>(samples.acc_y).subspan(begin, count),
+                                    Span<const double>(samples.acc_z).subspan(begin, count),
+                                    Span<const int>(samples.fix).subspan(begin, count),
+                                    Span<double>(displacement_y).subspan(begin, count),
+                                    Span<double>(displacement_z).subspan(begin, count), begin == 0);
+            }
+        }));
+    }
+
+    // 컴파일 시간 모델 (고정 dt 2상태, 가속도 바이어스 3상태, 등저크 4상태)
+    results.push_back(measure("kalman_filter_t/constant_velocity_fixed_dt", n, repeat, nullptr, [&] {
+        run_model_filter<FixedDt<ConstantVelocityModel, 10000>>(params, samples, displacement_y);
+    }));
+    results.push_back(measure("kalman_filter_t/accel_bias", n, repeat, nullptr, [&] {
+        run_model_filter<AccelBiasModel>(params, samples, displacement_y);
+    }));
+    results.push_back(measure("kalman_filter_t/constant_jerk", n, repeat, nullptr, [&] {
+        run_model_filter<ConstantJerkModel>(params, samples, displacement_y);
+    }));
+
+    // 시간 축 병렬 필터 (워커 수 = 하드웨어 스레드 수, 행이 적으면 순차 처리)
+    {
+        ThreadPool pool(ThreadPool::default_thread_count());
+        results.push_back(measure("parallel_filter/threads_" + std::to_string(pool.size()), n, repeat, nullptr, [&] {
+            DualAxisKalmanFilter filter(params);
+            filter.reset(samples.gps_y[0], samples.gps_z[0]);
+            process_parallel_in_time(filter, pool, samples.gps_y, samples.gps_z, samples.acc_y, samples.acc_z,
+                                     samples.fix, displacement_y, displacement_z, true);
+        }));
+    }
+
+    // 웜업 겹침 청크 병렬 처리 (청크 수 = 워커 수, 웜업 1000샘플)
+    {
+        ThreadPool pool(ThreadPool::default_thread_count());
+        size_t chunks = std::max<size_t>(pool.size(), 2);
+        results.push_back(measure("chunked_filter/chunks_" + std::to_string(chunks), n, repeat, nullptr, [&] {
+            DualAxisKalmanFilter filter(params);
+            filter.reset(samples.gps_y[0], samples.gps_z[0]);
+            process_chunked_overlap(filter, pool, chunks, 1000, samples.gps_y, samples.gps_z, samples.acc_y,
+                                    samples.acc_z, samples.fix, displacement_y, displacement_z, true);
+        }));
+    }
+
+    // 라이터
+    std::vector<OutputData> output_rows(n);
+    for (size_t i = 0; i < n; i++) {
+        output_rows[i].datetime = rows[i].datetime;
+        output_rows[i].displacement_y = displacement_y[i];
+        output_rows[i].displacement_z = displacement_z[i];
+    }
+    results.push_back(measure("save_csv/rows", n, repeat, nullptr, [&] {
+        save_csv(output_path, output_rows);
+    }));
+    results.push_back(measure("save_csv/columns", n, repeat, nullptr, [&] {
+        save_csv(output_path, samples.datetime, displacement_y, displacement_z);
+    }));
+
+    // C API 처리 모드 (파일 입력부터 출력까지, 로그 콜백이 없으므로 라이브러리는 출력하지 않음)
+    {
+        results.push_back(measure("api/fusion_process_csv", n, repeat, nullptr, [&] {
+            fusion_process_csv(input_path.c_str(), output_path.c_str(), 0.1, 0.01);
+        }));
+        results.push_back(measure("api/fusion_process_csv_batch", n, repeat, nullptr, [&] {
+            fusion_process_csv_batch(input_path.c_str(), output_path.c_str(), 0.1, 0.01, 100, 0);
+        }));
+        // 이전 실행의 상태 파일이 있으면 새 행이 없어 바로 끝나므로 매번 지움
+        results.push_back(measure("api/fusion_process_csv_realtime", n, repeat,
+            [&] { std::remove(state_path.c_str()); },
+            [&] { fusion_process_csv_realtime(input_path.c_str(), output_path.c_str(), 0.1, 0.01); }));
+    }
+
+    if (options.json_path.empty()) {
+        write_json(std::cout, options, results);
+    } else {
+        std::ofstream json(options.json_path);
+        write_json(json, options, results);
+        if (!json) {
+            std::cerr << "Error: Cannot write " << options.json_path << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -1,6 +1,9 @@
 #ifndef FUSION_API_H
 #define FUSION_API_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -25,6 +28,28 @@ typedef enum {
     FUSION_ERROR_UNKNOWN = -99
 } FusionErrorCode;
 
+// 처리 모드 (fusion_process_many)
+typedef enum {
+    FUSION_MODE_NORMAL = 0,    // fusion_process_csv 와 동일
+    FUSION_MODE_BATCH = 1,     // fusion_process_csv_batch 와 동일 (중간 결과 저장 안함)
+    FUSION_MODE_REALTIME = 2   // fusion_process_csv_realtime 와 동일 (출력 파일별 상태 파일 사용)
+} FusionMode;
+
+// fusion_convert_csv_to_binary로 만든 바이너리 입력 파일의 권장 확장자
+// (입력 형식은 파일 내용으로 판별하므로 확장자와 관계없이 모든 처리 함수에서 읽을 수 있음)
+#define FUSION_BINARY_INPUT_EXTENSION ".fcin"
+
+// 출력 경로가 이 확장자로 끝나면(대소문자 무시) CSV 대신 바이너리 컬럼 형식으로 저장
+// (fusion_process_csv, _batch, _many, fusion_sweep_parameters; 실시간 모드는 지원하지 않음)
+// 형식과 읽기 방법은 fusion_output_reader.h 참고
+#define FUSION_BINARY_OUTPUT_EXTENSION ".fcol"
+
+// 압축 CSV 입출력 (gzip은 zlib, zstd는 FUSION_WITH_ZSTD로 빌드한 경우)
+// 입력은 파일 앞의 매직으로 판별해 백그라운드 스레드에서 풀면서 읽고 (실시간 모드 입력은 지원하지 않음),
+// 출력 경로가 이 확장자로 끝나면(대소문자 무시) 기록하면서 압축한다 (예: "output.csv.gz")
+#define FUSION_GZIP_EXTENSION ".gz"
+#define FUSION_ZSTD_EXTENSION ".zst"
+
 /**
  * CSV 파일을 읽어서 GNSS-ACC 융합을 수행하고 결과를 저장
  * 
@@ -64,6 +89,15 @@ FUSION_API int fusion_process_csv_batch(
 /**
  * 실시간 모드로 CSV를 처리하고 상태를 파일로 저장/복원
  *
+ * 상태 파일에는 처리한 입력의 바이트 오프셋과 행 수도 기록된다. 같은 입력 파일에 행이 덧붙은 뒤
+ * 다시 호출하면 새 행만 처리해 기존 출력 파일 뒤에 추가한다 (이전 호출 이후 파일이 바뀌었으면
+ * 줄바꿈으로 끝나지 않은 마지막 줄은 기록 중인 것으로 보고 다음 호출에서 처리, 바뀌지 않았으면 그대로 처리).
+ * 입력 파일이 바뀌었거나 출력 파일이 없으면 저장된 상태에서 시작해 전체를 다시 처리한다.
+ *
+ * 상태 파일은 출력 디렉토리의 local_var_laststate.txt이다. 기존 경로와 호환되도록 이름은 .txt를 유지하지만
+ * 기본 형식은 바이너리 레코드이므로 텍스트 편집기로 열거나 고치지 말고
+ * fusion_export_snapshot_text로 내보내 확인한다 (텍스트로 저장하려면 fusion_set_snapshot_format).
+ *
  * @param input_file_path 입력 CSV 파일 경로 (DateTime, GPS_Y, GPS_Z, Acc_Y, Acc_Z, Fix)
  * @param output_file_path 출력 CSV 파일 경로 (DateTime, Displacement_Y, Displacement_Z)
  * @param Q 프로세스 노이즈 공분산
@@ -77,6 +111,448 @@ FUSION_API int fusion_process_csv_realtime(
     double R
 );
 
+/**
+ * 메모리 버퍼의 샘플을 처리하고 결과를 호출자 버퍼에 저장 (파일 입출력 없음)
+ *
+ * fusion_process_csv와 같은 초기화/처리 규칙을 사용하며, 내부 힙 할당을 하지 않는다
+ * (fusion_set_smoothing_lag로 평활을 사용하면 호출마다 O(lag) 크기의 버퍼를 할당).
+ * 간격(stride)은 바이트 단위이며 0이면 각 타입의 연속 배열로 본다.
+ * 구조체 배열이면 구조체 크기를 간격으로 주고 각 필드 주소를 포인터로 넘긴다.
+ *
+ * @param gps_y GPS Y 좌표 (n개)
+ * @param gps_z GPS Z 좌표 (n개)
+ * @param acc_y Y축 가속도 (n개)
+ * @param acc_z Z축 가속도 (n개)
+ * @param fix GPS Fix 상태 (n개, Fix >= 1일 때만 GPS 유효)
+ * @param n 샘플 수 (최소 20)
+ * @param out_y Y축 변위를 저장할 버퍼 (n개)
+ * @param out_z Z축 변위를 저장할 버퍼 (n개)
+ * @param input_stride 입력 배열 요소 간격 (바이트, 0이면 연속 배열)
+ * @param output_stride 출력 배열 요소 간격 (바이트, 0이면 연속 배열)
+ * @param Q 프로세스 노이즈 공분산
+ * @param R 측정 노이즈 공분산
+ * @return 성공 시 FUSION_SUCCESS, 실패 시 오류 코드
+ */
+FUSION_API int fusion_process_arrays(
+    const double* gps_y,
+    const double* gps_z,
+    const double* acc_y,
+    const double* acc_z,
+    const int* fix,
+    size_t n,
+    double* out_y,
+    double* out_z,
+    size_t input_stride,
+    size_t output_stride,
+    double Q,
+    double R
+);
+
+// 스트리밍 입력 샘플 (fusion_stream_push)
+typedef struct {
+    double gps_y;              // GPS Y 좌표
+    double gps_z;              // GPS Z 좌표
+    double acc_y;              // Y축 가속도
+    double acc_z;              // Z축 가속도
+    int fix;                   // GPS Fix 상태 (Fix >= 1일 때만 GPS 유효)
+} FusionSample;
+
+// 스트리밍 출력 (fusion_stream_push)
+typedef struct {
+    double displacement_y;     // Y축 변위
+    double displacement_z;     // Z축 변위
+} FusionDisplacement;
+
+// 스트리밍 필터 핸들 (내부 구조는 공개하지 않음)
+typedef struct FusionStream FusionStream;
+
+/**
+ * 스트리밍 필터 핸들 생성
+ *
+ * 필터 상태를 핸들 안에 유지하므로 샘플을 넣을 때마다 파일을 읽거나 쓰지 않는다.
+ * state_file_path의 상태 파일(fusion_process_csv_realtime / fusion_stream_snapshot 형식)이 있으면
+ * 그 상태에서 이어서 처리하고, 없으면 첫 번째 push의 첫 유효한 GPS 측정값으로 초기화한다.
+ *
+ * @param Q 프로세스 노이즈 공분산
+ * @param R 측정 노이즈 공분산
+ * @param state_file_path 복원할 상태 파일 경로 (NULL이면 새로 시작)
+ * @param stream 생성된 핸들을 저장할 포인터
+ * @return 성공 시 FUSION_SUCCESS, 실패 시 오류 코드
+ */
+FUSION_API int fusion_stream_create(
+    double Q,
+    double R,
+    const char* state_file_path,
+    FusionStream** stream
+);
+
+/**
+ * 스트리밍 필터에 샘플을 넣고 샘플별 변위를 받음
+ *
+ * 파일 입출력과 힙 할당이 없다. 새로 시작한 핸들은 첫 샘플에서 초기 상태를 그대로 출력하고,
+ * 이후 샘플은 매번 예측/업데이트한다 (같은 데이터를 나눠 넣어도 한 번에 넣은 결과와 같음).
+ * 핸들 하나를 여러 스레드에서 동시에 사용하면 안 된다.
+ *
+ * @param stream 스트리밍 필터 핸들
+ * @param samples 입력 샘플 배열 (n개)
+ * @param n 샘플 수
+ * @param out 변위를 저장할 배열 (n개)
+ * @return 성공 시 FUSION_SUCCESS, 실패 시 오류 코드
+ */
+FUSION_API int fusion_stream_push(
+    FusionStream* stream,
+    const FusionSample* samples,
+    size_t n,
+    FusionDisplacement* out
+);
+
+/**
+ * 스트리밍 필터의 현재 상태를 상태 파일로 저장
+ *
+ * fusion_stream_create 및 fusion_process_csv_realtime에서 복원할 수 있는 형식으로 저장한다.
+ *
+ * @param stream 스트리밍 필터 핸들
+ * @param state_file_path 상태 파일 경로
+ * @return 성공 시 FUSION_SUCCESS, 실패 시 오류 코드
+ */
+FUSION_API int fusion_stream_snapshot(
+    FusionStream* stream,
+    const char* state_file_path
+);
+
+/**
+ * 스트리밍 필터 핸들 해제 (NULL이면 아무것도 하지 않음)
+ *
+ * @param stream 스트리밍 필터 핸들
+ */
+FUSION_API void fusion_stream_destroy(FusionStream* stream);
+
+/**
+ * 여러 CSV 파일을 내부 스레드 풀에서 병렬로 처리
+ *
+ * 파일마다 결과 코드를 results에 기록한다. 여러 스레드에서 동시에 호출해도 안전하다.
+ * 실시간 모드에서는 출력 디렉토리 공용 상태 파일 대신 출력 파일마다
+ * "<출력 파일 이름>_laststate.txt"(확장자 포함, 예: out.csv_laststate.txt) 상태 파일을 사용하므로 같은 디렉토리의 파일끼리 상태가 섞이지 않는다
+ * (확장자와 관계없이 내용은 fusion_set_snapshot_format의 형식, 기본값 바이너리).
+ * 같은 출력 파일이 두 번 이상 나오면 뒤의 항목은 FUSION_ERROR_INVALID_DATA로 처리한다
+ * (경로는 정규화해서 비교하므로 "out.csv"와 "./out.csv"도 같은 파일이다).
+ *
+ * @param input_file_paths 입력 CSV 파일 경로 배열 (count개)
+ * @param output_file_paths 출력 CSV 파일 경로 배열 (count개)
+ * @param count 파일 수
+ * @param Q 프로세스 노이즈 공분산
+ * @param R 측정 노이즈 공분산
+ * @param mode 처리 모드 (FusionMode)
+ * @param batch_size 배치 모드 배치 크기 (0이면 기본값 100, 다른 모드에서는 무시)
+ * @param threads 워커 스레드 수 (0이면 하드웨어 스레드 수)
+ * @param results 파일별 결과 코드를 저장할 배열 (count개)
+ * @return 모두 성공 시 FUSION_SUCCESS, 아니면 입력 순서상 첫 번째 실패 파일의 오류 코드
+ */
+FUSION_API int fusion_process_many(
+    const char* const* input_file_paths,
+    const char* const* output_file_paths,
+    size_t count,
+    double Q,
+    double R,
+    int mode,
+    size_t batch_size,
+    int threads,
+    int* results
+);
+
+/**
+ * 정상 상태(steady-state) 칼만 게인 고속 경로 설정 (이후의 모든 fusion_process_* 호출에 적용)
+ *
+ * Q, R, dt가 고정이고 GPS 업데이트 간격이 일정하면 공분산이 수렴한 뒤부터는
+ * 캐시된 게인으로 상태 재귀만 수행한다. 간격이 달라지면 자동으로 전체 필터로 돌아간다.
+ * 결과는 전체 필터와 tolerance 수준에서 다를 수 있으며, 차이는 fusion_steady_state_deviation으로 확인한다.
+ *
+ * @param enable 1: 사용, 0: 사용 안함 (기본값)
+ * @param tolerance 공분산 수렴 판정 상대 허용 오차 (0이면 기본값 1e-12)
+ * @return 성공 시 FUSION_SUCCESS, tolerance가 음수면 FUSION_ERROR_INVALID_DATA
+ */
+FUSION_API int fusion_set_steady_state(int enable, double tolerance);
+
+/**
+ * 정상 상태 고속 경로와 전체 필터 결과의 최대 편차 측정
+ *
+ * 입력 파일을 일반 처리 모드 규칙으로 두 필터에 함께 통과시켜 Y/Z 변위의 최대 절대 차이를 구한다.
+ * 파일은 쓰지 않는다.
+ *
+ * @param input_file_path 입력 CSV 파일 경로
+ * @param Q 프로세스 노이즈 공분산
+ * @param R 측정 노이즈 공분산
+ * @param tolerance 공분산 수렴 판정 상대 허용 오차 (0이면 기본값 1e-12)
+ * @param max_deviation 최대 절대 편차 (미터)를 저장할 포인터
+ * @return 성공 시 FUSION_SUCCESS, 실패 시 오류 코드
+ */
+FUSION_API int fusion_steady_state_deviation(
+    const char* input_file_path,
+    double Q,
+    double R,
+    double tolerance,
+    double* max_deviation
+);
+
+/**
+ * 시간 축 병렬(parallel-in-time) 필터 설정 (이후의 fusion_process_csv, fusion_process_arrays 호출에 적용)
+ *
+ * 칼만 필터를 연관 스캔(associative scan) 형식으로 바꿔 긴 입력을 시간 구간으로 나누고 여러 스레드에서 처리한다.
+ * 구간마다 요소를 결합해 구간 시작 상태를 구한 뒤 각 구간을 병렬로 필터링하며, 결과는 순차 필터와
+ * 반올림 오차 수준에서 같다 (시험 데이터에서 상대 1e-11 이하). 전체 연산량은 순차 필터의 약 2~3배이므로
+ * 코어가 3개 이상이고 입력이 수백만 행일 때 효과가 있다.
+ * 일반 처리 모드는 한 번에 약 200만 행씩 읽어 처리하고, 스레드당 16384행보다 짧은 입력과
+ * 간격(stride)이 있는 fusion_process_arrays 버퍼는 순차 필터로 처리한다.
+ * 병렬로 처리하는 입력에는 정상 상태 고속 경로를 적용하지 않으며, 고정 지연 평활을 사용하면 이 설정은 무시된다.
+ *
+ * @param enable 1: 사용, 0: 사용 안함 (기본값)
+ * @param threads 스레드 수 (0이면 하드웨어 스레드 수)
+ * @return 성공 시 FUSION_SUCCESS, threads가 음수면 FUSION_ERROR_INVALID_DATA
+ */
+FUSION_API int fusion_set_parallel_filter(int enable, int threads);
+
+/**
+ * 웜업 겹침(warm-up overlap) 청크 병렬 처리 설정 (이후의 fusion_process_csv, fusion_process_arrays 호출에 적용)
+ *
+ * 입력을 chunks개 청크로 나눠 각 청크를 별도 스레드에서 필터링하고 출력을 순서대로 이어 붙인다.
+ * 첫 청크가 아닌 청크는 앞 청크 끝의 overlap개 샘플로 새 필터를 먼저 수렴시킨 뒤(웜업, 출력은 버림) 처리하므로
+ * 결과는 순차 필터의 근사이며, 차이는 청크 경계 직후에 생기고 overlap이 길수록 작아진다.
+ * fusion_chunked_deviation으로 허용 오차를 만족하는 overlap을 고른다. 추가 연산은 청크당 overlap개 샘플이다.
+ * 일반 처리 모드는 한 번에 약 200만 행씩 읽어 그 안에서 청크를 나눈다.
+ * 간격(stride)이 있는 fusion_process_arrays 버퍼는 순차 필터로 처리하며,
+ * 고정 지연 평활이나 시간 축 병렬 필터(fusion_set_parallel_filter)를 사용하면 이 설정은 무시된다.
+ *
+ * @param chunks 청크 수 (0 또는 1이면 사용 안함, 기본값 0), 스레드 수는 청크 수와 하드웨어 스레드 수 중 작은 값
+ * @param overlap 웜업 샘플 수
+ * @return 항상 FUSION_SUCCESS
+ */
+FUSION_API int fusion_set_chunked_filter(size_t chunks, size_t overlap);
+
+/**
+ * 청크 병렬 처리와 순차 필터 결과의 최대 편차 측정
+ *
+ * 입력 파일을 일반 처리 모드 규칙으로 순차 필터와 청크 병렬 처리(chunks, overlap)에 함께 통과시켜
+ * Y/Z 변위의 최대 절대 차이를 구한다. 차이는 청크 경계에서만 생기므로 경계 오차의 최대값이다.
+ * 전역 설정(fusion_set_chunked_filter, 정상 상태 고속 경로)과 관계없이 전체 필터로 비교하며 파일은 쓰지 않는다.
+ *
+ * @param input_file_path 입력 CSV 파일 경로
+ * @param Q 프로세스 노이즈 공분산
+ * @param R 측정 노이즈 공분산
+ * @param chunks 청크 수
+ * @param overlap 웜업 샘플 수
+ * @param max_deviation 최대 절대 편차 (미터)를 저장할 포인터
+ * @return 성공 시 FUSION_SUCCESS, 실패 시 오류 코드
+ */
+FUSION_API int fusion_chunked_deviation(
+    const char* input_file_path,
+    double Q,
+    double R,
+    size_t chunks,
+    size_t overlap,
+    double* max_deviation
+);
+
+/**
+ * 고정 지연(fixed-lag) 평활 설정 (이후의 fusion_process_csv, fusion_process_csv_batch,
+ * fusion_process_arrays, fusion_process_many 호출에 적용)
+ *
+ * 각 샘플의 변위를 그 뒤 lag개 샘플의 측정까지 반영한 RTS 평활 값으로 출력한다.
+ * 출력 행과 값의 개수는 평활하지 않을 때와 같으며, 입력 끝의 마지막 lag개 샘플은 마지막 샘플까지의
+ * 측정으로 평활한다. 최근 lag + 1개 샘플의 필터 상태만 보관하므로 메모리는 O(lag)이고,
+ * 샘플당 연산도 O(lag)로 늘어난다. 배치 모드의 중간 파일은 해당 배치까지 평활이 끝난 행을 담는다.
+ * 평활 중에는 정상 상태 고속 경로(fusion_set_steady_state)를 사용하지 않는다.
+ * 실시간 모드는 FUSION_ERROR_INVALID_DATA를 반환하고, 스트리밍 API(fusion_stream_*)와
+ * 파라미터 스윕은 평활하지 않는다.
+ *
+ * @param lag 지연 샘플 수 (0: 사용 안함, 기본값, 최대 100000)
+ * @return 성공 시 FUSION_SUCCESS, lag가 최대값보다 크면 FUSION_ERROR_INVALID_DATA
+ */
+FUSION_API int fusion_set_smoothing_lag(size_t lag);
+
+// 상태 파일 형식 (fusion_set_snapshot_format)
+typedef enum {
+    FUSION_SNAPSHOT_BINARY = 0,    // 고정 레이아웃 바이너리 레코드 (버전 헤더 + CRC-32, 기본값)
+    FUSION_SNAPSHOT_TEXT = 1       // "key value" 텍스트 12줄 (기존 형식)
+} FusionSnapshotFormat;
+
+/**
+ * 상태 파일 저장 형식 설정 (실시간 모드와 fusion_stream_snapshot에 적용)
+ *
+ * 읽을 때는 두 형식을 자동으로 판별하므로 기존 텍스트 상태 파일에서도 이어서 처리할 수 있다.
+ * 형식과 관계없이 파일 이름(local_var_laststate.txt, <출력 파일 이름>_laststate.txt)은 바뀌지 않으므로
+ * 바이너리 형식이면 .txt 파일에 바이너리 레코드가 저장된다.
+ * 어느 형식이든 임시 파일에 쓴 뒤 이름을 바꿔 원자적으로 교체한다. 호출이 끝날 때의 마지막 저장과
+ * fusion_stream_snapshot은 이름을 바꾸기 전에 디스크까지 기록(fsync / FlushFileBuffers)하고,
+ * 실시간 모드의 중간 체크포인트는 디스크 기록을 기다리지 않는다.
+ *
+ * @param format 상태 파일 형식 (FusionSnapshotFormat)
+ * @return 성공 시 FUSION_SUCCESS, 알 수 없는 형식이면 FUSION_ERROR_INVALID_DATA
+ */
+FUSION_API int fusion_set_snapshot_format(int format);
+
+/**
+ * 실시간 모드 상태 파일 저장(체크포인트) 간격 설정
+ *
+ * 두 기준 중 하나라도 만족하면 저장하며, 처리가 끝날 때는 항상 저장한다.
+ * 간격은 100행 배치가 끝날 때마다 확인한다.
+ *
+ * @param rows 저장 간격 (행 수, 기본값 100, 0이면 행 수 기준 사용 안함)
+ * @param seconds 저장 간격 (초, 기본값 0 = 시간 기준 사용 안함)
+ * @return 성공 시 FUSION_SUCCESS, seconds가 음수면 FUSION_ERROR_INVALID_DATA
+ */
+FUSION_API int fusion_set_checkpoint_interval(size_t rows, double seconds);
+
+/**
+ * 입력 CSV를 바이너리 컬럼 입력 파일로 변환
+ *
+ * 같은 파일을 여러 번 다시 처리할 때 텍스트 파싱을 건너뛰기 위한 형식이다.
+ * CSV는 처리 함수와 같은 규칙으로 한 번 파싱해 검증하며(잘못된 행은 건너뜀),
+ * GPS/가속도 값(double), Fix(int32), 타임스탬프 원문을 컬럼별로 저장한다.
+ * 모든 fusion_process_* 함수와 fusion_sweep_parameters, fusion_steady_state_deviation, fusion_chunked_deviation은
+ * 입력 경로에 이 파일을 주면 메모리 맵으로 열어 파싱 없이 읽으며, 결과는 원본 CSV를 처리한 것과 같다.
+ *
+ * @param input_file_path 입력 CSV 파일 경로
+ * @param output_file_path 바이너리 입력 파일 경로 (권장 확장자: FUSION_BINARY_INPUT_EXTENSION)
+ * @param rows_converted 변환한 행 수 (NULL 가능)
+ * @return 오류 코드 (0: 성공)
+ */
+FUSION_API int fusion_convert_csv_to_binary(
+    const char* input_file_path,
+    const char* output_file_path,
+    size_t* rows_converted
+);
+
+/**
+ * 상태 파일을 텍스트 형식으로 내보내기 (확인/디버깅용)
+ *
+ * @param state_file_path 상태 파일 경로 (바이너리 또는 텍스트)
+ * @param text_file_path 저장할 텍스트 파일 경로
+ * @return 성공 시 FUSION_SUCCESS, 실패 시 오류 코드
+ */
+FUSION_API int fusion_export_snapshot_text(
+    const char* state_file_path,
+    const char* text_file_path
+);
+
+// 파라미터 스윕 결과 (fusion_sweep_parameters)
+typedef struct {
+    double Q;                  // 프로세스 노이즈 공분산
+    double R;                  // 측정 노이즈 공분산
+    double log_likelihood;     // GPS 업데이트 혁신(innovation)의 가우시안 로그 우도 합 (Y+Z, 클수록 좋음)
+    double innovation_rms_y;   // Y축 GPS 측정값 대비 예측 잔차 RMS (미터)
+    double innovation_rms_z;   // Z축 GPS 측정값 대비 예측 잔차 RMS (미터)
+    size_t updates;            // GPS 업데이트 수 (Y+Z)
+} FusionSweepResult;
+
+/**
+ * 여러 (Q, R) 조합을 한 번의 파싱으로 평가 (필터 튜닝용)
+ *
+ * 입력 파일을 한 번만 읽고 모든 파라미터 세트를 SIMD 레인에 나눠 같은 데이터에 나란히 통과시킨다.
+ * 각 세트의 필터 결과는 같은 Q, R로 fusion_process_csv를 호출한 것과 동일하다.
+ *
+ * @param input_file_path 입력 CSV 파일 경로
+ * @param Q_values 프로세스 노이즈 공분산 배열 (count개)
+ * @param R_values 측정 노이즈 공분산 배열 (count개)
+ * @param count 파라미터 세트 수
+ * @param results 세트별 결과를 저장할 배열 (count개)
+ * @param best_output_file_path 로그 우도가 가장 큰 세트의 결과를 저장할 CSV 경로 (NULL이면 저장 안함)
+ * @param best_index 로그 우도가 가장 큰 세트의 인덱스를 저장할 포인터 (NULL 가능)
+ * @return 성공 시 FUSION_SUCCESS, 실패 시 오류 코드
+ */
+FUSION_API int fusion_sweep_parameters(
+    const char* input_file_path,
+    const double* Q_values,
+    const double* R_values,
+    size_t count,
+    FusionSweepResult* results,
+    const char* best_output_file_path,
+    size_t* best_index
+);
+
+/**
+ * 출력 CSV 변위 값의 자릿수 설정 (이후의 모든 fusion_process_* 호출에 적용)
+ *
+ * @param precision 유효 숫자 자릿수 (1~17, 기본값 6 = 기존 출력과 동일),
+ *                  0이면 값을 손실 없이 되읽을 수 있는 최단 표현으로 출력
+ * @return 성공 시 FUSION_SUCCESS, 범위를 벗어나면 FUSION_ERROR_INVALID_DATA
+ */
+FUSION_API int fusion_set_output_precision(int precision);
+
+/**
+ * 현재 출력 CSV 변위 값 자릿수 조회
+ *
+ * @return 유효 숫자 자릿수 (0이면 최단 왕복 표현)
+ */
+FUSION_API int fusion_get_output_precision(void);
+
+/**
+ * 로그 심각도 (fusion_set_log_callback)
+ */
+typedef enum {
+    FUSION_LOG_DEBUG = 0,               // 배치별 진행 상황
+    FUSION_LOG_INFO = 1,                // 처리 시작/완료 요약
+    FUSION_LOG_WARNING = 2,             // 건너뛴 입력 행, 상태 파일 저장 실패 등
+    FUSION_LOG_ERROR = 3                // 호출이 실패한 원인
+} FusionLogLevel;
+
+/**
+ * 로그 콜백
+ *
+ * @param level 심각도 (FusionLogLevel)
+ * @param message 줄바꿈 없는 메시지 (콜백이 끝나면 유효하지 않음)
+ * @param user_data fusion_set_log_callback에 전달한 포인터
+ */
+typedef void (*FusionLogCallback)(int level, const char* message, void* user_data);
+
+/**
+ * 로그 콜백 설정
+ *
+ * 기본값은 콜백 없음으로, 라이브러리는 콘솔에 아무것도 출력하지 않는다.
+ * 같은 종류의 경고(잘못된 입력 행, 상태 파일 저장 실패 등)는 호출마다 처음 5개만 개별로 전달하고,
+ * 나머지는 호출이 끝날 때 생략된 개수를 담은 경고 하나로 모아 전달한다.
+ * 콜백 호출은 라이브러리 내부에서 직렬화되지만 여러 스레드에서 호출될 수 있으며,
+ * 콜백 안에서 fusion_set_log_callback을 호출하면 안 된다.
+ *
+ * @param min_level 전달할 최소 심각도 (FusionLogLevel)
+ * @param callback 로그 콜백 (NULL이면 로그 끔)
+ * @param user_data 콜백에 그대로 전달할 사용자 포인터
+ * @return 오류 코드 (0: 성공)
+ */
+FUSION_API int fusion_set_log_callback(int min_level, FusionLogCallback callback, void* user_data);
+
+/**
+ * 처리 단계별 시간과 카운터 (fusion_get_last_stats)
+ *
+ * 시간은 나노초 단위이다. fusion_process_many에서 단계별 시간은 모든 작업 스레드의 합계이고,
+ * total_ns만 호출 전체의 경과 시간이다.
+ */
+typedef struct {
+    uint64_t total_ns;              // 호출 전체 경과 시간
+    uint64_t parse_ns;              // CSV 읽기/파싱
+    uint64_t filter_ns;             // 칼만 필터 처리
+    uint64_t write_ns;              // 출력 CSV 포맷/쓰기
+    uint64_t snapshot_ns;           // 상태 파일 읽기/쓰기
+    uint64_t rows_parsed;           // 파싱한 데이터 행 수
+    uint64_t rows_rejected;         // 형식 오류로 건너뛴 행 수
+    uint64_t gps_updates;           // GPS 업데이트를 적용한 샘플 수
+    uint64_t predict_only_steps;    // 예측만 수행한 샘플 수
+    uint64_t bytes_read;            // 파싱한 입력 바이트 수
+    uint64_t bytes_written;         // 출력한 바이트 수
+    uint64_t snapshot_writes;       // 저장한 상태 파일 수 (체크포인트 포함)
+} FusionStats;
+
+/**
+ * 현재 스레드에서 마지막으로 호출한 처리 함수의 통계 조회
+ *
+ * fusion_process_csv, _batch, _realtime, _arrays, _many, fusion_sweep_parameters,
+ * fusion_steady_state_deviation이 호출될 때마다 해당 스레드의 통계를 새로 집계한다.
+ * 스트림 API(fusion_stream_push)는 호출 비용을 늘리지 않도록 집계하지 않는다.
+ *
+ * @param stats 통계를 받을 구조체
+ * @return 오류 코드 (0: 성공)
+ */
+FUSION_API int fusion_get_last_stats(FusionStats* stats);
+
 /**
  * 오류 코드를 문자열로 변환
  * 
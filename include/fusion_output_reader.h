@@ -0,0 +1,405 @@
+#ifndef FUSION_OUTPUT_READER_H
+#define FUSION_OUTPUT_READER_H
+
+/**
+ * 바이너리 컬럼 형식 출력 파일(FUSION_BINARY_OUTPUT_EXTENSION) 읽기 (헤더 전용, C++17)
+ *
+ * 파일을 메모리 맵으로 열고 컬럼을 그대로 가리키므로 파싱이나 복사가 없다.
+ * 파일 레이아웃 (리틀 엔디언, 오프셋은 파일 처음 기준, 8바이트 정렬):
+ *   [0, 4)     매직 "FCOL"
+ *   [4, 6)     버전 (uint16, 2)
+ *   [6, 8)     변위 값 크기 (uint16, 4 = float, 8 = double)
+ *   [8, 16)    행 수 (uint64)
+ *   [16, 24)   타임스탬프 구간 수 (uint64, 원문 구간 방식일 때만)
+ *   [24, 32)   Displacement_Y 컬럼 오프셋
+ *   [32, 40)   Displacement_Z 컬럼 오프셋
+ *   [40, 48)   구간 시작 행 배열 오프셋 (uint32 × (구간 수 + 1), 마지막 값 = 행 수)
+ *   [48, 56)   구간 텍스트 오프셋 배열 오프셋 (uint32 × (구간 수 + 1))
+ *   [56, 64)   타임스탬프 텍스트 오프셋
+ *   [64, 72)   타임스탬프 정수 컬럼 오프셋 (int64 마이크로초 × 행 수, 정수 컬럼 방식일 때만)
+ *   [72]       타임스탬프 저장 방식 (0 = 원문 구간, 1 = 정수 컬럼)
+ *   [73]       형식 종류 (1 = yyyy-mm-dd HH:MM:SS[.f], 2 = H:MM:SS[.f], 3 = M:SS[.f])
+ *   [74, 76)   날짜 구분자('-' 또는 '/'), 날짜/시간 구분자(' ' 또는 'T')
+ *   [76, 78)   첫 필드(시 또는 분) 자릿수, 소수 자릿수 (0 ~ 6)
+ * 정수 컬럼은 종류 1이면 1970-01-01 00:00:00 기준, 2이면 0시 기준, 3이면 0분 기준 마이크로초이며
+ * 형식대로 다시 포맷하면 입력 원문과 같다. 입력 타임스탬프를 해석할 수 없거나 형식이 섞이면
+ * 같은 값이 연속된 구간마다 원문을 한 번만 저장한다.
+ * 버전 1 파일(64바이트 헤더, 항상 원문 구간)도 읽을 수 있다.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace fusion {
+
+class ColumnarOutputReader {
+public:
+    ColumnarOutputReader() = default;
+    ~ColumnarOutputReader() { close(); }
+
+    ColumnarOutputReader(const ColumnarOutputReader&) = delete;
+    ColumnarOutputReader& operator=(const ColumnarOutputReader&) = delete;
+
+    /**
+     * 파일을 매핑하고 헤더와 컬럼 범위 검증
+     *
+     * @return 형식이 맞지 않거나 열 수 없으면 false
+     */
+    bool open(const char* file_path) {
+        close();
+        if (!map(file_path) || !parse()) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+        unmap();
+        rows_ = 0;
+        runs_ = 0;
+        value_size_ = 0;
+        y_ = z_ = text_ = nullptr;
+        run_rows_ = run_text_ = nullptr;
+        micros_ = nullptr;
+        kind_ = 0;
+    }
+
+    // 행 수
+    size_t size() const { return static_cast<size_t>(rows_); }
+
+    // 변위 값 크기 (4 = float, 8 = double)
+    size_t value_size() const { return value_size_; }
+
+    // 변위 컬럼 (값 크기가 맞지 않으면 nullptr)
+    const float* float_displacement_y() const { return value_size_ == sizeof(float) ? as<float>(y_) : nullptr; }
+    const float* float_displacement_z() const { return value_size_ == sizeof(float) ? as<float>(z_) : nullptr; }
+    const double* double_displacement_y() const { return value_size_ == sizeof(double) ? as<double>(y_) : nullptr; }
+    const double* double_displacement_z() const { return value_size_ == sizeof(double) ? as<double>(z_) : nullptr; }
+
+    // 값 크기와 관계없이 double로 조회
+    double displacement_y(size_t row) const { return value_at(y_, row); }
+    double displacement_z(size_t row) const { return value_at(z_, row); }
+
+    // 타임스탬프 원문 최대 길이 (timestamp()에 넘기는 버퍼 크기)
+    static constexpr size_t TIMESTAMP_CHARS = 32;
+
+    // 타임스탬프 정수 컬럼 (원문 구간 방식이면 nullptr)
+    const int64_t* timestamp_micros() const { return micros_; }
+
+    // 행의 타임스탬프 원문 (정수 컬럼이면 buffer에 포맷, 반환값은 buffer나 파일이 바뀌기 전까지 유효)
+    std::string_view timestamp(size_t row, char (&buffer)[TIMESTAMP_CHARS]) const {
+        if (micros_) {
+            return std::string_view(buffer, format_micros(micros_[row], buffer));
+        }
+        return run_timestamp(run_of(row));
+    }
+
+    // 타임스탬프 구간 (같은 값이 연속된 행 묶음, 원문 구간 방식일 때만)
+    size_t timestamp_runs() const { return static_cast<size_t>(runs_); }
+    size_t run_first_row(size_t run) const { return run_rows_[run]; }
+    size_t run_end_row(size_t run) const { return run_rows_[run + 1]; }
+    std::string_view run_timestamp(size_t run) const {
+        return std::string_view(text_ + run_text_[run], run_text_[run + 1] - run_text_[run]);
+    }
+
+private:
+    static constexpr size_t HEADER_SIZE_V1 = 64;
+    static constexpr size_t HEADER_SIZE = 80;
+    static constexpr int64_t MICROS_PER_SECOND = 1000000;
+    static constexpr int64_t SECONDS_PER_DAY = 86400;
+
+    // 형식 종류 (src/timestamp.h의 TimestampKind와 같은 값)
+    static constexpr uint8_t KIND_DATE_TIME = 1;
+    static constexpr uint8_t KIND_HOUR_MINUTE_SECOND = 2;
+    static constexpr uint8_t KIND_MINUTE_SECOND = 3;
+
+    // 행이 속한 구간 (구간 이진 탐색)
+    size_t run_of(size_t row) const {
+        size_t low = 0;
+        size_t high = static_cast<size_t>(runs_);
+        while (high - low > 1) {
+            size_t mid = low + (high - low) / 2;
+            if (run_rows_[mid] <= row) {
+                low = mid;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    static int64_t floor_div(int64_t value, int64_t divisor) {
+        int64_t quotient = value / divisor;
+        return (value % divisor < 0) ? quotient - 1 : quotient;
+    }
+
+    // width자리 이상으로 0을 채워 기록 (value >= 0)
+    static char* write_number(char* out, int64_t value, size_t width) {
+        char digits[20];
+        size_t count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        for (size_t i = count; i < width; i++) {
+            *out++ = '0';
+        }
+        while (count > 0) {
+            *out++ = digits[--count];
+        }
+        return out;
+    }
+
+    // 정수 타임스탬프를 헤더의 형식으로 포맷 (라이브러리의 format_timestamp와 같은 결과)
+    size_t format_micros(int64_t micros, char* out) const {
+        const int64_t seconds = floor_div(micros, MICROS_PER_SECOND);
+        const int64_t fraction = micros - seconds * MICROS_PER_SECOND;
+        int64_t clock = seconds;
+        char* p = out;
+        if (kind_ == KIND_DATE_TIME) {
+            // 1970-01-01 기준 일 수 -> 그레고리력 날짜 (H. Hinnant의 civil 알고리즘)
+            const int64_t days = floor_div(seconds, SECONDS_PER_DAY);
+            clock = seconds - days * SECONDS_PER_DAY;
+            const int64_t shifted = days + 719468;
+            const int64_t era = floor_div(shifted, 146097);
+            const int64_t day_of_era = shifted - era * 146097;
+            const int64_t year_of_era =
+                (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+            const int64_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+            const int64_t mp = (5 * day_of_year + 2) / 153;
+            const int64_t day = day_of_year - (153 * mp + 2) / 5 + 1;
+            const int64_t month = mp < 10 ? mp + 3 : mp - 9;
+            const int64_t year = year_of_era + era * 400 + (month <= 2);
+            if (year < 0 || year > 9999) {
+                return 0;
+            }
+            p = write_number(p, year, 4);
+            *p++ = date_separator_;
+            p = write_number(p, month, 2);
+            *p++ = date_separator_;
+            p = write_number(p, day, 2);
+            *p++ = time_separator_;
+            p = write_number(p, clock / 3600, 2);
+            *p++ = ':';
+            p = write_number(p, clock / 60 % 60, 2);
+        } else if (seconds < 0) {
+            return 0;
+        } else if (kind_ == KIND_HOUR_MINUTE_SECOND) {
+            p = write_number(p, clock / 3600, lead_width_);
+            *p++ = ':';
+            p = write_number(p, clock / 60 % 60, 2);
+        } else {
+            p = write_number(p, clock / 60, lead_width_);
+        }
+        *p++ = ':';
+        p = write_number(p, clock % 60, 2);
+        if (fraction_digits_ > 0) {
+            int64_t scaled = fraction;
+            for (size_t i = fraction_digits_; i < 6; i++) {
+                scaled /= 10;
+            }
+            *p++ = '.';
+            p = write_number(p, scaled, fraction_digits_);
+        }
+        return static_cast<size_t>(p - out);
+    }
+
+    template <typename T>
+    static const T* as(const char* p) { return reinterpret_cast<const T*>(p); }
+
+    static uint64_t read_u64(const char* p) {
+        uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    double value_at(const char* column, size_t row) const {
+        return value_size_ == sizeof(float) ? static_cast<double>(as<float>(column)[row]) : as<double>(column)[row];
+    }
+
+    // offset부터 count개 요소가 파일 안에 있고 정렬되어 있는지 확인
+    bool in_range(uint64_t offset, uint64_t count, uint64_t element_size) const {
+        if (offset % element_size != 0 || offset > size_ || count > (size_ - offset) / element_size) {
+            return false;
+        }
+        return true;
+    }
+
+    bool parse() {
+        if (size_ < HEADER_SIZE_V1 || std::memcmp(data_, "FCOL", 4) != 0) {
+            return false;
+        }
+        uint16_t version;
+        uint16_t value_size;
+        std::memcpy(&version, data_ + 4, 2);
+        std::memcpy(&value_size, data_ + 6, 2);
+        if ((version != 1 && version != 2) || (version == 2 && size_ < HEADER_SIZE) ||
+            (value_size != sizeof(float) && value_size != sizeof(double))) {
+            return false;
+        }
+        uint64_t rows = read_u64(data_ + 8);
+        uint64_t runs = read_u64(data_ + 16);
+        uint64_t y_offset = read_u64(data_ + 24);
+        uint64_t z_offset = read_u64(data_ + 32);
+        uint64_t run_rows_offset = read_u64(data_ + 40);
+        uint64_t run_text_offset = read_u64(data_ + 48);
+        uint64_t text_offset = read_u64(data_ + 56);
+        if (version == 2 && static_cast<uint8_t>(data_[72]) != 0) {
+            // 정수 컬럼 방식
+            uint64_t micros_offset = read_u64(data_ + 64);
+            uint8_t kind = static_cast<uint8_t>(data_[73]);
+            uint8_t lead_width = static_cast<uint8_t>(data_[76]);
+            uint8_t fraction_digits = static_cast<uint8_t>(data_[77]);
+            if (!in_range(y_offset, rows, value_size) || !in_range(z_offset, rows, value_size) ||
+                !in_range(micros_offset, rows, sizeof(int64_t)) || (rows > 0 && (kind < KIND_DATE_TIME ||
+                kind > KIND_MINUTE_SECOND || lead_width < 1 || lead_width > 9 || fraction_digits > 6))) {
+                return false;
+            }
+            rows_ = rows;
+            value_size_ = value_size;
+            y_ = data_ + y_offset;
+            z_ = data_ + z_offset;
+            micros_ = as<int64_t>(data_ + micros_offset);
+            kind_ = kind;
+            date_separator_ = data_[74];
+            time_separator_ = data_[75];
+            lead_width_ = lead_width;
+            fraction_digits_ = fraction_digits;
+            return true;
+        }
+        if (runs >= size_ || !in_range(y_offset, rows, value_size) || !in_range(z_offset, rows, value_size) ||
+            !in_range(run_rows_offset, runs + 1, sizeof(uint32_t)) ||
+            !in_range(run_text_offset, runs + 1, sizeof(uint32_t))) {
+            return false;
+        }
+        const uint32_t* run_rows = as<uint32_t>(data_ + run_rows_offset);
+        const uint32_t* run_text = as<uint32_t>(data_ + run_text_offset);
+        if (run_rows[runs] != rows || (rows > 0 && runs == 0) || !in_range(text_offset, run_text[runs], 1)) {
+            return false;
+        }
+        // 구간 경계가 증가 순서인지 확인 (조회 시 범위 검사를 생략하기 위함)
+        for (uint64_t r = 0; r < runs; r++) {
+            if (run_rows[r] >= run_rows[r + 1] || run_text[r] > run_text[r + 1]) {
+                return false;
+            }
+        }
+        rows_ = rows;
+        runs_ = runs;
+        value_size_ = value_size;
+        y_ = data_ + y_offset;
+        z_ = data_ + z_offset;
+        run_rows_ = run_rows;
+        run_text_ = run_text;
+        text_ = data_ + text_offset;
+        return true;
+    }
+
+#ifdef _WIN32
+    bool map(const char* file_path) {
+        file_ = CreateFileA(file_path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            file_ = nullptr;
+            return false;
+        }
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file_, &file_size) || file_size.QuadPart < static_cast<LONGLONG>(HEADER_SIZE_V1)) {
+            return false;
+        }
+        size_ = static_cast<uint64_t>(file_size.QuadPart);
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_) {
+            return false;
+        }
+        data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        return data_ != nullptr;
+    }
+
+    void unmap() {
+        if (data_) {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_) {
+            CloseHandle(mapping_);
+        }
+        if (file_) {
+            CloseHandle(file_);
+        }
+        data_ = nullptr;
+        mapping_ = nullptr;
+        file_ = nullptr;
+        size_ = 0;
+    }
+
+    HANDLE file_ = nullptr;
+    HANDLE mapping_ = nullptr;
+#else
+    bool map(const char* file_path) {
+        int fd = ::open(file_path, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(HEADER_SIZE_V1)) {
+            ::close(fd);
+            return false;
+        }
+        size_ = static_cast<uint64_t>(st.st_size);
+        void* view = mmap(nullptr, static_cast<size_t>(size_), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED) {
+            size_ = 0;
+            return false;
+        }
+        data_ = static_cast<const char*>(view);
+        return true;
+    }
+
+    void unmap() {
+        if (data_) {
+            munmap(const_cast<char*>(data_), static_cast<size_t>(size_));
+        }
+        data_ = nullptr;
+        size_ = 0;
+    }
+#endif
+
+    const char* data_ = nullptr;
+    uint64_t size_ = 0;
+    uint64_t rows_ = 0;
+    uint64_t runs_ = 0;
+    size_t value_size_ = 0;
+    const char* y_ = nullptr;
+    const char* z_ = nullptr;
+    const char* text_ = nullptr;
+    const uint32_t* run_rows_ = nullptr;
+    const uint32_t* run_text_ = nullptr;
+    const int64_t* micros_ = nullptr;
+    uint8_t kind_ = 0;
+    char date_separator_ = '-';
+    char time_separator_ = ' ';
+    size_t lead_width_ = 2;
+    size_t fraction_digits_ = 0;
+};
+
+} // namespace fusion
+
+#endif // FUSION_OUTPUT_READER_H
@@ -0,0 +1,114 @@
+#include "batch_writer.h"
+#include "fusion_log.h"
+#include <exception>
+#include <utility>
+
+namespace fusion {
+
+AsyncBatchWriter::AsyncBatchWriter(OutputWriter& output, int precision, size_t max_pending)
+    : output_(output),
+      precision_(precision),
+      max_pending_(max_pending > 0 ? max_pending : 1),
+      thread_(&AsyncBatchWriter::run, this) {}
+
+AsyncBatchWriter::~AsyncBatchWriter() {
+    finish();
+}
+
+OutputBatch AsyncBatchWriter::acquire() {
+    OutputBatch batch;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_.empty()) {
+            batch = std::move(free_.back());
+            free_.pop_back();
+        }
+    }
+    batch.datetime.clear();
+    batch.displacement_y.clear();
+    batch.displacement_z.clear();
+    batch.intermediate_path.clear();
+    return batch;
+}
+
+void AsyncBatchWriter::submit(OutputBatch&& batch) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [this] { return pending_.size() < max_pending_; });
+    pending_.push_back(std::move(batch));
+    not_empty_.notify_one();
+}
+
+bool AsyncBatchWriter::finish() {
+    if (finished_) {
+        return !failed_;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closing_ = true;
+    }
+    not_empty_.notify_one();
+    thread_.join();
+    finished_ = true;
+    run_stats().add(thread_stats_);
+    return !failed_;
+}
+
+void AsyncBatchWriter::run() {
+    RunStats& stats = clear_run_stats();
+    WarningLimiter intermediate_warnings("Failed intermediate result saves");
+
+    for (;;) {
+        OutputBatch batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_empty_.wait(lock, [this] { return closing_ || !pending_.empty(); });
+            if (pending_.empty()) {
+                break;
+            }
+            batch = std::move(pending_.front());
+            pending_.pop_front();
+        }
+        not_full_.notify_one();
+
+        try {
+            bool saved = true;
+            CsvWriter* csv_output = output_.csv();
+            if (batch.intermediate_path.empty()) {
+                output_.write_rows(batch.datetime, batch.displacement_y, batch.displacement_z);
+            } else {
+                CsvWriter intermediate;
+                if (csv_output && intermediate.open(batch.intermediate_path, precision_)) {
+                    // 중간 파일에 포맷한 바이트를 최종 파일에도 복사
+                    intermediate.set_mirror(csv_output);
+                    intermediate.write_rows(batch.datetime, batch.displacement_y, batch.displacement_z);
+                    saved = intermediate.close();
+                } else {
+                    // 바이너리 컬럼 형식은 컬럼별로 모아 쓰므로 중간 파일을 따로 기록
+                    // (CSV 중간 파일을 열지 못한 경우에는 최종 파일에만 기록)
+                    output_.write_rows(batch.datetime, batch.displacement_y, batch.displacement_z);
+                    saved = !csv_output && save_output(batch.intermediate_path, batch.datetime,
+                                                       batch.displacement_y, batch.displacement_z, precision_);
+                }
+                if (saved) {
+                    LogLine(LogLevel::Debug) << "Intermediate result saved: " << batch.intermediate_path;
+                } else if (intermediate_warnings.should_report()) {
+                    LogLine(LogLevel::Warning) << "Failed to save intermediate result: "
+                                               << batch.intermediate_path;
+                }
+            }
+        } catch (const std::exception& e) {
+            // 최종 파일에 빠진 행이 생겼으므로 실패로 기록하고 남은 배치는 계속 비움
+            LogLine(LogLevel::Error) << "Exception in batch writer: " << e.what();
+            std::lock_guard<std::mutex> lock(mutex_);
+            failed_ = true;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(std::move(batch));
+    }
+
+    intermediate_warnings.flush();
+    thread_stats_ = stats;
+}
+
+} // namespace fusion
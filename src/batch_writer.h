@@ -0,0 +1,94 @@
+#ifndef BATCH_WRITER_H
+#define BATCH_WRITER_H
+
+#include "csv_parser.h"
+#include "output_writer.h"
+#include "data_structures.h"
+#include "run_stats.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fusion {
+
+// 배치 하나의 출력
+struct OutputBatch {
+    TimestampColumn datetime;
+    std::vector<double> displacement_y;
+    std::vector<double> displacement_z;
+    std::string intermediate_path;      // 비어 있으면 중간 파일을 만들지 않음
+};
+
+// 기록을 기다리는 최대 배치 수 (가득 차면 필터 쪽이 기다림)
+constexpr size_t DEFAULT_MAX_PENDING_BATCHES = 4;
+
+/**
+ * 배치 출력을 백그라운드 스레드에서 기록하는 라이터
+ *
+ * 필터가 다음 배치를 처리하는 동안 이전 배치의 포맷과 파일 쓰기를 수행한다.
+ * CSV 출력에서 중간 파일이 지정된 배치는 중간 파일에 한 번 포맷한 바이트를 최종 파일에도
+ * 그대로 이어 붙이므로 같은 행을 두 번 포맷하지 않는다. 대기 배치 수는 max_pending으로 제한되어 메모리 사용량이 일정하다.
+ *
+ * 기록 스레드의 단계별 통계(write_ns, bytes_written)는 finish()에서 호출 스레드의 통계에 더한다.
+ */
+class AsyncBatchWriter {
+public:
+    /**
+     * @param output 열어 둔 최종 출력 라이터 (finish() 전까지 다른 스레드에서 쓰면 안 됨)
+     * @param precision 중간 파일 변위 값 유효 숫자 자릿수
+     * @param max_pending 기록을 기다리는 최대 배치 수 (1 이상)
+     */
+    AsyncBatchWriter(OutputWriter& output, int precision, size_t max_pending = DEFAULT_MAX_PENDING_BATCHES);
+
+    /**
+     * 남은 배치를 모두 기록한 뒤 스레드 종료
+     */
+    ~AsyncBatchWriter();
+
+    AsyncBatchWriter(const AsyncBatchWriter&) = delete;
+    AsyncBatchWriter& operator=(const AsyncBatchWriter&) = delete;
+
+    /**
+     * 기록이 끝난 배치 버퍼를 재사용해 빈 배치 반환 (용량 유지)
+     */
+    OutputBatch acquire();
+
+    /**
+     * 배치를 기록 대기열에 추가 (대기열이 가득 차면 자리가 날 때까지 기다림)
+     */
+    void submit(OutputBatch&& batch);
+
+    /**
+     * 남은 배치를 모두 기록하고 스레드 종료
+     *
+     * @return 모든 배치가 최종 출력 라이터에 전달되었으면 true (최종 파일 쓰기 결과는 output.close()로 확인)
+     */
+    bool finish();
+
+private:
+    void run();
+
+    OutputWriter& output_;
+    int precision_;
+    size_t max_pending_;
+
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<OutputBatch> pending_;
+    std::vector<OutputBatch> free_;
+    bool closing_ = false;
+    bool failed_ = false;
+    bool finished_ = false;
+
+    RunStats thread_stats_;
+    std::thread thread_;
+};
+
+} // namespace fusion
+
+#endif // BATCH_WRITER_H
@@ -0,0 +1,441 @@
+#include "columnar_input.h"
+#include "csv_parser.h"
+#include "fusion_log.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+namespace fusion {
+
+namespace {
+
+const char COLUMNAR_INPUT_MAGIC[4] = {'F', 'C', 'I', 'N'};
+const uint16_t COLUMNAR_INPUT_VERSION = 2;
+const size_t COLUMNAR_INPUT_HEADER_SIZE = 112;
+const size_t COLUMNAR_INPUT_V1_HEADER_SIZE = 96;
+
+// 타임스탬프 저장 방식 (헤더 104번째 바이트, FCOL과 같은 값)
+const uint8_t TIMESTAMP_TEXT_RUNS = 0;
+const uint8_t TIMESTAMP_MICROS = 1;
+const uint8_t MAX_FRACTION_DIGITS = 6;
+const uint8_t MAX_LEAD_WIDTH = 9;
+const size_t COLUMNAR_INPUT_ALIGNMENT = 8;
+
+// 변환 시 한 번에 읽는 행 수
+const size_t CONVERT_CHUNK_ROWS = 65536;
+
+inline uint64_t read_u64(const char* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t align_up(uint64_t offset) {
+    return (offset + COLUMNAR_INPUT_ALIGNMENT - 1) / COLUMNAR_INPUT_ALIGNMENT * COLUMNAR_INPUT_ALIGNMENT;
+}
+
+// 파일 안에 offset부터 count개 요소가 들어가고 정렬되어 있는지 확인
+bool in_range(uint64_t file_size, uint64_t offset, uint64_t count, uint64_t element_size) {
+    return offset % std::min<uint64_t>(element_size, COLUMNAR_INPUT_ALIGNMENT) == 0 &&
+           offset <= file_size && count <= (file_size - offset) / element_size;
+}
+
+// 줄 수 (마지막 줄이 줄바꿈으로 끝나지 않으면 unterminated_tail로 한 줄 추가)
+uint64_t count_lines(std::string_view text, bool unterminated_tail) {
+    return static_cast<uint64_t>(std::count(text.begin(), text.end(), '\n')) + (unterminated_tail ? 1 : 0);
+}
+
+// 압축된 입력을 풀면서 줄 수와 압축을 푼 크기를 셈
+bool count_decompressed_lines(std::string_view compressed, uint64_t& lines, uint64_t& size) {
+    DecompressStream stream;
+    stream.start(compressed, detect_compression(compressed));
+    std::string block;
+    lines = 0;
+    size = 0;
+    char last = '\n';
+    while (stream.next(block)) {
+        lines += count_lines(block, false);
+        size += block.size();
+        if (!block.empty()) {
+            last = block.back();
+        }
+    }
+    lines += (last != '\n') ? 1 : 0;
+    return !stream.failed();
+}
+
+// 원문 구간 배열 (같은 원문이 이어지면 구간 하나)
+class TimestampRuns {
+public:
+    TimestampRuns() : run_text_{0} {}
+
+    void push_back(std::string_view timestamp, uint64_t row) {
+        if (run_rows_.empty() ||
+            std::string_view(text_.data() + last_begin_, text_.size() - last_begin_) != timestamp) {
+            last_begin_ = text_.size();
+            run_rows_.push_back(static_cast<uint32_t>(row));
+            text_.append(timestamp.data(), timestamp.size());
+            run_text_.push_back(static_cast<uint32_t>(text_.size()));
+        }
+    }
+
+    std::vector<uint32_t>& run_rows() { return run_rows_; }
+    const std::vector<uint32_t>& run_text() const { return run_text_; }
+    const std::string& text() const { return text_; }
+
+private:
+    std::vector<uint32_t> run_rows_;
+    std::vector<uint32_t> run_text_;
+    std::string text_;
+    size_t last_begin_ = 0;     // 마지막 구간 원문의 시작 위치
+};
+
+// 2GB를 넘는 위치로 이동 (Windows의 fseek는 long 오프셋)
+bool seek_to(std::FILE* file, uint64_t offset) {
+#ifdef _WIN32
+    return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+// 컬럼 영역 하나에 청크를 이어 씀
+class ColumnSink {
+public:
+    ColumnSink(std::FILE* file, bool& failed) : file_(file), failed_(failed) {}
+
+    void write_at(uint64_t offset, const void* data, size_t size) {
+        if (size == 0 || failed_) {
+            return;
+        }
+        if (!seek_to(file_, offset) || std::fwrite(data, 1, size, file_) != size) {
+            failed_ = true;
+        }
+    }
+
+private:
+    std::FILE* file_;
+    bool& failed_;
+};
+
+} // namespace
+
+bool is_columnar_input(std::string_view contents) {
+    return contents.size() >= 4 && std::memcmp(contents.data(), COLUMNAR_INPUT_MAGIC, 4) == 0;
+}
+
+bool ColumnarInput::open(std::string_view contents) {
+    const char* data = contents.data();
+    const uint64_t size = contents.size();
+    if (size < COLUMNAR_INPUT_V1_HEADER_SIZE || !is_columnar_input(contents)) {
+        return false;
+    }
+    uint16_t version;
+    std::memcpy(&version, data + 4, 2);
+    if ((version != 1 && version != COLUMNAR_INPUT_VERSION) ||
+        (version == COLUMNAR_INPUT_VERSION && size < COLUMNAR_INPUT_HEADER_SIZE)) {
+        return false;
+    }
+    const uint64_t rows = read_u64(data + 8);
+    const uint64_t runs = read_u64(data + 16);
+    uint64_t column_offsets[5];
+    for (int i = 0; i < 5; i++) {
+        column_offsets[i] = read_u64(data + 24 + 8 * i);
+    }
+    const uint64_t run_rows_offset = read_u64(data + 64);
+    const uint64_t run_text_offset = read_u64(data + 72);
+    const uint64_t text_offset = read_u64(data + 80);
+
+    if (rows > std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+    for (int i = 0; i < 4; i++) {
+        if (!in_range(size, column_offsets[i], rows, sizeof(double))) {
+            return false;
+        }
+    }
+    if (!in_range(size, column_offsets[4], rows, sizeof(int32_t))) {
+        return false;
+    }
+
+    const int64_t* micros = nullptr;
+    TimestampLayout layout;
+    const uint32_t* run_rows = nullptr;
+    const uint32_t* run_text = nullptr;
+    const uint8_t encoding = version == 1 ? TIMESTAMP_TEXT_RUNS : static_cast<uint8_t>(data[104]);
+    if (encoding == TIMESTAMP_MICROS) {
+        // 정수 컬럼: 형식이 포맷 가능한 범위인지 확인
+        const uint64_t micros_offset = read_u64(data + 96);
+        const uint8_t kind = static_cast<uint8_t>(data[105]);
+        layout.kind = static_cast<TimestampKind>(kind);
+        layout.date_separator = data[106];
+        layout.time_separator = data[107];
+        layout.lead_width = static_cast<uint8_t>(data[108]);
+        layout.fraction_digits = static_cast<uint8_t>(data[109]);
+        if (kind < static_cast<uint8_t>(TimestampKind::DateTime) ||
+            kind > static_cast<uint8_t>(TimestampKind::MinuteSecond) ||
+            layout.lead_width == 0 || layout.lead_width > MAX_LEAD_WIDTH ||
+            layout.fraction_digits > MAX_FRACTION_DIGITS ||
+            !in_range(size, micros_offset, rows, sizeof(int64_t))) {
+            return false;
+        }
+        micros = reinterpret_cast<const int64_t*>(data + micros_offset);
+    } else if (encoding == TIMESTAMP_TEXT_RUNS) {
+        if (runs >= size ||
+            !in_range(size, run_rows_offset, runs + 1, sizeof(uint32_t)) ||
+            !in_range(size, run_text_offset, runs + 1, sizeof(uint32_t))) {
+            return false;
+        }
+        run_rows = reinterpret_cast<const uint32_t*>(data + run_rows_offset);
+        run_text = reinterpret_cast<const uint32_t*>(data + run_text_offset);
+        // 원문이 없으면 (빈 입력) 텍스트 오프셋이 파일 끝을 넘을 수 있음
+        if (run_rows[runs] != rows || (rows > 0 && runs == 0) || run_rows[0] != 0 || run_text[0] != 0 ||
+            (run_text[runs] > 0 && !in_range(size, text_offset, run_text[runs], 1))) {
+            return false;
+        }
+        // 구간 경계가 증가 순서인지 확인 (읽을 때 범위 검사를 생략하기 위함)
+        for (uint64_t r = 0; r < runs; r++) {
+            if (run_rows[r] >= run_rows[r + 1] || run_text[r] > run_text[r + 1]) {
+                return false;
+            }
+        }
+    } else {
+        return false;
+    }
+
+    micros_ = micros;
+    layout_ = layout;
+    rows_ = rows;
+    runs_ = micros ? 0 : runs;
+    gps_y_ = reinterpret_cast<const double*>(data + column_offsets[0]);
+    gps_z_ = reinterpret_cast<const double*>(data + column_offsets[1]);
+    acc_y_ = reinterpret_cast<const double*>(data + column_offsets[2]);
+    acc_z_ = reinterpret_cast<const double*>(data + column_offsets[3]);
+    fix_ = reinterpret_cast<const int32_t*>(data + column_offsets[4]);
+    run_rows_ = run_rows;
+    run_text_ = run_text;
+    text_ = data + text_offset;
+    return true;
+}
+
+size_t ColumnarInput::find_run(size_t row) const {
+    const uint32_t* end = run_rows_ + runs_;
+    return static_cast<size_t>(std::upper_bound(run_rows_, end, static_cast<uint32_t>(row)) - run_rows_) - 1;
+}
+
+std::string_view ColumnarInput::run_timestamp(size_t run) const {
+    return std::string_view(text_ + run_text_[run], run_text_[run + 1] - run_text_[run]);
+}
+
+void ColumnarInput::append_rows(size_t first, size_t count, SampleBlock& block) const {
+    if (count == 0) {
+        return;
+    }
+    const size_t last = first + count;
+    block.gps_y.insert(block.gps_y.end(), gps_y_ + first, gps_y_ + last);
+    block.gps_z.insert(block.gps_z.end(), gps_z_ + first, gps_z_ + last);
+    block.acc_y.insert(block.acc_y.end(), acc_y_ + first, acc_y_ + last);
+    block.acc_z.insert(block.acc_z.end(), acc_z_ + first, acc_z_ + last);
+    block.fix.insert(block.fix.end(), fix_ + first, fix_ + last);
+
+    if (micros_) {
+        block.datetime.append(micros_ + first, count, layout_);
+        return;
+    }
+
+    // 타임스탬프는 구간마다 한 번 해석해 구간의 행 수만큼 추가
+    for (size_t run = find_run(first), row = first; row < last; run++) {
+        size_t run_end = std::min<size_t>(run_rows_[run + 1], last);
+        block.datetime.append(run_timestamp(run), run_end - row);
+        row = run_end;
+    }
+}
+
+void ColumnarInput::append_rows(size_t first, size_t count, std::vector<InputData>& rows) const {
+    if (count == 0) {
+        return;
+    }
+    size_t run = micros_ ? 0 : find_run(first);
+    RowTimestamp timestamp;
+    if (micros_) {
+        timestamp.timestamp.layout = layout_;
+    } else {
+        timestamp.assign(run_timestamp(run));
+    }
+    for (size_t row = first; row < first + count; row++) {
+        if (micros_) {
+            timestamp.timestamp.micros = micros_[row];
+        } else {
+            while (run_rows_[run + 1] <= row) {
+                run++;
+                timestamp.assign(run_timestamp(run));
+            }
+        }
+        InputData data;
+        data.datetime = timestamp;
+        data.gps_y = gps_y_[row];
+        data.gps_z = gps_z_[row];
+        data.acc_y = acc_y_[row];
+        data.acc_z = acc_z_[row];
+        data.fix = fix_[row];
+        rows.push_back(std::move(data));
+    }
+}
+
+bool convert_csv_to_columnar(const std::string& csv_path, const std::string& output_path, size_t* rows_written) {
+    if (rows_written) {
+        *rows_written = 0;
+    }
+    CsvReader reader;
+    if (!reader.open(csv_path)) {
+        return false;
+    }
+
+    // 데이터 행 수는 줄 수를 넘지 않으므로 줄 수만큼 컬럼 자리를 잡음 (이미 바이너리면 행 수 그대로)
+    std::string_view contents = reader.contents();
+    uint64_t max_rows = 0;
+    uint64_t source_size = contents.size();
+    ColumnarInput columnar;
+    if (reader.is_compressed()) {
+        // 압축된 입력은 줄 수를 미리 알 수 없으므로 한 번 풀어서 셈
+        if (!count_decompressed_lines(contents, max_rows, source_size)) {
+            LogLine(LogLevel::Error) << "Corrupt or truncated compressed input: " << csv_path;
+            return false;
+        }
+    } else if (is_columnar_input(contents) && columnar.open(contents)) {
+        max_rows = columnar.size();
+    } else {
+        max_rows = count_lines(contents, contents.size() > 0 && contents.back() != '\n');
+    }
+    if (max_rows > std::numeric_limits<uint32_t>::max()) {
+        LogLine(LogLevel::Error) << "Too many rows for binary input: " << csv_path;
+        return false;
+    }
+
+    uint64_t column_offsets[5];
+    column_offsets[0] = COLUMNAR_INPUT_HEADER_SIZE;
+    for (int i = 1; i < 5; i++) {
+        column_offsets[i] = column_offsets[i - 1] + max_rows * sizeof(double);
+    }
+    const uint64_t columns_end = align_up(column_offsets[4] + max_rows * sizeof(int32_t));
+
+    std::FILE* file = std::fopen(output_path.c_str(), "wb");
+    if (!file) {
+        LogLine(LogLevel::Error) << "Cannot create file " << output_path;
+        return false;
+    }
+    std::setvbuf(file, nullptr, _IOFBF, 1 << 20);
+
+    bool failed = false;
+    ColumnSink sink(file, failed);
+    SampleBlock chunk;
+    chunk.reserve(CONVERT_CHUNK_ROWS);
+    std::vector<int64_t> micros;    // 모든 행이 layout 형식이면 정수 컬럼
+    TimestampLayout layout;
+    TimestampRuns runs;             // 아니면 원문 구간
+    bool text_timestamps = false;
+    uint64_t rows = 0;
+    TimestampBuffer timestamp_buffer;
+
+    while (reader.read(chunk, CONVERT_CHUNK_ROWS) > 0) {
+        const size_t n = chunk.size();
+        sink.write_at(column_offsets[0] + rows * sizeof(double), chunk.gps_y.data(), n * sizeof(double));
+        sink.write_at(column_offsets[1] + rows * sizeof(double), chunk.gps_z.data(), n * sizeof(double));
+        sink.write_at(column_offsets[2] + rows * sizeof(double), chunk.acc_y.data(), n * sizeof(double));
+        sink.write_at(column_offsets[3] + rows * sizeof(double), chunk.acc_z.data(), n * sizeof(double));
+        static_assert(sizeof(int) == sizeof(int32_t), "Fix column is stored as int32");
+        sink.write_at(column_offsets[4] + rows * sizeof(int32_t), chunk.fix.data(), n * sizeof(int32_t));
+
+        // 지금까지와 같은 형식의 정수 컬럼이면 정수만 이어 붙이고, 아니면 원문 구간 방식으로 전환
+        const TimestampColumn& datetime = chunk.datetime;
+        if (!text_timestamps && (!datetime.compact() || (!micros.empty() && datetime.layout() != layout))) {
+            for (size_t row = 0; row < micros.size(); row++) {
+                runs.push_back(timestamp_buffer.format(Timestamp{micros[row], layout}), row);
+            }
+            std::vector<int64_t>().swap(micros);
+            text_timestamps = true;
+        }
+        if (text_timestamps) {
+            for (size_t i = 0; i < n; i++) {
+                runs.push_back(datetime.text(i, timestamp_buffer), rows + i);
+            }
+        } else {
+            if (micros.empty()) {
+                layout = datetime.layout();
+            }
+            for (size_t i = 0; i < n; i++) {
+                micros.push_back(datetime.micros(i));
+            }
+        }
+        rows += n;
+        chunk.clear();
+    }
+    if (runs.text().size() > std::numeric_limits<uint32_t>::max()) {
+        LogLine(LogLevel::Error) << "Timestamp text too large for binary input: " << csv_path;
+        failed = true;
+    }
+
+    // 타임스탬프 정수 컬럼 또는 구간 배열과 원문은 숫자 컬럼 영역 뒤에 기록 (빈 입력은 형식이 없으므로 구간 방식)
+    if (micros.empty()) {
+        text_timestamps = true;
+    }
+    uint64_t run_count = 0;
+    uint64_t run_rows_offset = 0;
+    uint64_t run_text_offset = 0;
+    uint64_t text_offset = 0;
+    uint64_t micros_offset = 0;
+    if (text_timestamps) {
+        std::vector<uint32_t>& run_rows = runs.run_rows();
+        const std::vector<uint32_t>& run_text = runs.run_text();
+        run_rows.push_back(static_cast<uint32_t>(rows));
+        run_count = run_rows.size() - 1;
+        run_rows_offset = columns_end;
+        run_text_offset = align_up(run_rows_offset + run_rows.size() * sizeof(uint32_t));
+        text_offset = align_up(run_text_offset + run_text.size() * sizeof(uint32_t));
+        sink.write_at(run_rows_offset, run_rows.data(), run_rows.size() * sizeof(uint32_t));
+        sink.write_at(run_text_offset, run_text.data(), run_text.size() * sizeof(uint32_t));
+        sink.write_at(text_offset, runs.text().data(), runs.text().size());
+    } else {
+        micros_offset = columns_end;
+        sink.write_at(micros_offset, micros.data(), micros.size() * sizeof(int64_t));
+    }
+
+    if (reader.failed()) {
+        failed = true;
+    }
+
+    char header[COLUMNAR_INPUT_HEADER_SIZE] = {};
+    std::memcpy(header, COLUMNAR_INPUT_MAGIC, 4);
+    std::memcpy(header + 4, &COLUMNAR_INPUT_VERSION, 2);
+    std::memcpy(header + 8, &rows, 8);
+    std::memcpy(header + 16, &run_count, 8);
+    std::memcpy(header + 24, column_offsets, sizeof(column_offsets));
+    std::memcpy(header + 64, &run_rows_offset, 8);
+    std::memcpy(header + 72, &run_text_offset, 8);
+    std::memcpy(header + 80, &text_offset, 8);
+    std::memcpy(header + 88, &source_size, 8);
+    std::memcpy(header + 96, &micros_offset, 8);
+    header[104] = static_cast<char>(text_timestamps ? TIMESTAMP_TEXT_RUNS : TIMESTAMP_MICROS);
+    header[105] = static_cast<char>(layout.kind);
+    header[106] = layout.date_separator;
+    header[107] = layout.time_separator;
+    header[108] = static_cast<char>(layout.lead_width);
+    header[109] = static_cast<char>(layout.fraction_digits);
+    sink.write_at(0, header, sizeof(header));
+
+    if (std::fclose(file) != 0) {
+        failed = true;
+    }
+    if (failed) {
+        LogLine(LogLevel::Error) << "Failed to write binary input file " << output_path;
+        std::remove(output_path.c_str());
+        return false;
+    }
+    if (rows_written) {
+        *rows_written = static_cast<size_t>(rows);
+    }
+    return true;
+}
+
+} // namespace fusion
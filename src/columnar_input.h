@@ -0,0 +1,104 @@
+#ifndef COLUMNAR_INPUT_H
+#define COLUMNAR_INPUT_H
+
+#include "data_structures.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fusion {
+
+/**
+ * 바이너리 컬럼 입력 파일 (convert_csv_to_columnar로 생성)
+ *
+ * 파일 레이아웃 (호스트 바이트 순서, 리틀 엔디언 대상, 모든 오프셋은 파일 처음 기준, 8바이트 정렬):
+ *   [0, 4)     매직 "FCIN"
+ *   [4, 6)     버전 (uint16)
+ *   [6, 8)     예약 (0)
+ *   [8, 16)    행 수 (uint64)
+ *   [16, 24)   타임스탬프 구간 수 (uint64, 원문 구간 방식일 때만)
+ *   [24, 64)   GPS_Y, GPS_Z, Acc_Y, Acc_Z (double), Fix (int32) 컬럼 오프셋 (uint64 × 5)
+ *   [64, 72)   구간 시작 행 배열 오프셋 (uint32 × (구간 수 + 1), 마지막 값 = 행 수)
+ *   [72, 80)   구간 텍스트 오프셋 배열 오프셋 (uint32 × (구간 수 + 1))
+ *   [80, 88)   타임스탬프 텍스트 오프셋
+ *   [88, 96)   변환한 원본 CSV 크기 (바이트, 압축된 입력이면 압축을 푼 크기, 참고용)
+ *   [96, 104)  타임스탬프 정수 컬럼 오프셋 (int64 마이크로초 × 행 수, 정수 저장 방식일 때만)
+ *   [104]      타임스탬프 저장 방식 (0 = 원문 구간, 1 = 정수 컬럼)
+ *   [105, 110) 타임스탬프 형식 (TimestampLayout: kind, 날짜 구분자, 날짜/시간 구분자, 첫 필드 자릿수, 소수 자릿수)
+ *   [110, 112) 예약 (0)
+ * 값은 CSV 파서가 검증한 결과 그대로이므로 같은 CSV를 읽은 것과 비트 단위로 같은 샘플이 된다.
+ * 타임스탬프는 모든 행이 같은 형식으로 해석되면 TimestampColumn과 같이 정수 컬럼 하나와 형식으로 저장하고,
+ * 해석할 수 없거나 형식이 바뀌는 입력이면 같은 값이 연속된 구간마다 원문을 한 번만 저장한다.
+ * 버전 1 파일(96바이트 헤더, 항상 원문 구간)도 읽는다.
+ */
+class ColumnarInput {
+public:
+    /**
+     * 매핑된 파일 내용의 헤더와 컬럼 범위 검증
+     *
+     * @return 형식이 맞지 않으면 false
+     */
+    bool open(std::string_view contents);
+
+    // 행 수
+    size_t size() const { return static_cast<size_t>(rows_); }
+
+    // 행 하나가 차지하는 컬럼 바이트 수 (타임스탬프 제외)
+    static constexpr size_t ROW_BYTES = 4 * sizeof(double) + sizeof(int32_t);
+
+    /**
+     * [first, first + count) 행을 block의 각 컬럼 뒤에 추가
+     */
+    void append_rows(size_t first, size_t count, SampleBlock& block) const;
+
+    /**
+     * [first, first + count) 행을 rows 뒤에 추가
+     */
+    void append_rows(size_t first, size_t count, std::vector<InputData>& rows) const;
+
+private:
+    // row가 속한 타임스탬프 구간
+    size_t find_run(size_t row) const;
+    std::string_view run_timestamp(size_t run) const;
+
+    // 정수 컬럼 방식이면 micros_, 원문 구간 방식이면 nullptr
+    const int64_t* micros_ = nullptr;
+    TimestampLayout layout_;
+
+    uint64_t rows_ = 0;
+    uint64_t runs_ = 0;
+    const double* gps_y_ = nullptr;
+    const double* gps_z_ = nullptr;
+    const double* acc_y_ = nullptr;
+    const double* acc_z_ = nullptr;
+    const int32_t* fix_ = nullptr;
+    const uint32_t* run_rows_ = nullptr;
+    const uint32_t* run_text_ = nullptr;
+    const char* text_ = nullptr;
+};
+
+/**
+ * 파일 내용이 바이너리 컬럼 입력 형식인지 여부 (매직만 확인)
+ */
+bool is_columnar_input(std::string_view contents);
+
+/**
+ * 입력 CSV를 바이너리 컬럼 입력 파일로 변환
+ *
+ * CSV는 다른 처리 함수와 같은 파서(CsvReader)로 한 번 읽으며, 잘못된 행은 같은 규칙으로 건너뛴다.
+ * 숫자 컬럼은 최대 행 수(줄 수)만큼 자리를 잡아 두고 청크 단위로 바로 채우며,
+ * 타임스탬프(정수 컬럼 또는 원문 구간)만 끝까지 메모리에 모은다.
+ * 압축된 CSV(gzip/zstd)는 줄 수를 세기 위해 한 번 더 푼다.
+ *
+ * @param csv_path 입력 CSV 파일 경로
+ * @param output_path 출력 파일 경로
+ * @param rows_written 변환한 행 수 (nullptr 가능)
+ * @return 입력을 열 수 없거나 출력 쓰기에 실패하면 false
+ */
+bool convert_csv_to_columnar(const std::string& csv_path, const std::string& output_path, size_t* rows_written);
+
+} // namespace fusion
+
+#endif // COLUMNAR_INPUT_H
@@ -0,0 +1,461 @@
+#include "compressed_stream.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <utility>
+
+#ifdef FUSION_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef FUSION_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace fusion {
+
+namespace {
+
+// zlib은 한 번에 uInt 크기까지만 받으므로 입력을 나누어 넘김
+constexpr size_t MAX_CODEC_INPUT = 1u << 30;
+
+// 압축한 바이트를 모아 파일에 기록하는 버퍼 크기
+constexpr size_t COMPRESS_OUTPUT_SIZE = 1 << 18;
+
+// 압축 수준: gzip은 기록이 처리 시간을 좌우하지 않도록 가장 빠른 수준 (기본값 6보다 약 3배 빠르고 30% 정도 큼),
+// zstd는 기본 수준으로도 충분히 빠름
+constexpr int GZIP_LEVEL = 1;
+constexpr int ZSTD_LEVEL = 3;
+
+bool ends_with_ignore_case(std::string_view text, std::string_view suffix) {
+    if (text.size() < suffix.size()) {
+        return false;
+    }
+    return std::equal(suffix.begin(), suffix.end(), text.end() - suffix.size(), [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+    });
+}
+
+bool has_gzip_magic(std::string_view contents) {
+    return contents.size() >= 2 && static_cast<unsigned char>(contents[0]) == 0x1f &&
+           static_cast<unsigned char>(contents[1]) == 0x8b;
+}
+
+bool has_zstd_magic(std::string_view contents) {
+    static const unsigned char magic[4] = {0x28, 0xb5, 0x2f, 0xfd};
+    return contents.size() >= 4 && std::memcmp(contents.data(), magic, 4) == 0;
+}
+
+#ifdef FUSION_HAVE_ZLIB
+// gzip 입력을 풀어 BLOCK_SIZE 단위로 publish에 넘김 (publish가 false면 중단)
+// @return 손상되거나 잘린 입력이면 false
+template <typename Publish>
+bool inflate_gzip(std::string_view source, std::string& block, Publish publish) {
+    z_stream stream{};
+    if (inflateInit2(&stream, 15 + 16) != Z_OK) {
+        return false;
+    }
+    const size_t block_size = DecompressStream::BLOCK_SIZE;
+    const char* next = source.data();
+    size_t remaining = source.size();
+    size_t filled = 0;
+    bool ok = true;
+    bool stopped = false;
+    block.resize(block_size);
+
+    for (;;) {
+        if (stream.avail_in == 0 && remaining > 0) {
+            size_t size = std::min(remaining, MAX_CODEC_INPUT);
+            stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(next));
+            stream.avail_in = static_cast<uInt>(size);
+            next += size;
+            remaining -= size;
+        }
+        stream.next_out = reinterpret_cast<Bytef*>(&block[filled]);
+        stream.avail_out = static_cast<uInt>(block_size - filled);
+        int ret = inflate(&stream, Z_NO_FLUSH);
+        filled = block_size - stream.avail_out;
+        if (filled == block_size) {
+            if (!publish(block)) {
+                stopped = true;
+                break;
+            }
+            block.resize(block_size);
+            filled = 0;
+        }
+        if (ret == Z_STREAM_END) {
+            // 뒤에 다른 gzip 멤버가 이어지면 계속 풀고, 아니면 남은 내용은 무시 (gzip 도구와 동일)
+            size_t position = source.size() - remaining - stream.avail_in;
+            if (!has_gzip_magic(source.substr(position)) || inflateReset(&stream) != Z_OK) {
+                break;
+            }
+            continue;
+        }
+        if (ret != Z_OK) {
+            // Z_BUF_ERROR: 출력 공간은 항상 있으므로 입력이 멤버 중간에서 끝난 경우
+            ok = false;
+            break;
+        }
+    }
+    inflateEnd(&stream);
+
+    if (ok && !stopped && filled > 0) {
+        block.resize(filled);
+        publish(block);
+    }
+    return ok;
+}
+#endif
+
+#ifdef FUSION_HAVE_ZSTD
+// zstd 입력을 풀어 BLOCK_SIZE 단위로 publish에 넘김 (publish가 false면 중단)
+// @return 손상되거나 잘린 입력이면 false
+template <typename Publish>
+bool decompress_zstd(std::string_view source, std::string& block, Publish publish) {
+    ZSTD_DCtx* context = ZSTD_createDCtx();
+    if (!context) {
+        return false;
+    }
+    const size_t block_size = DecompressStream::BLOCK_SIZE;
+    ZSTD_inBuffer input{source.data(), source.size(), 0};
+    size_t filled = 0;
+    bool ok = true;
+    bool stopped = false;
+    block.resize(block_size);
+
+    for (;;) {
+        ZSTD_outBuffer output{&block[0], block_size, filled};
+        size_t ret = ZSTD_decompressStream(context, &output, &input);
+        if (ZSTD_isError(ret)) {
+            ok = false;
+            break;
+        }
+        filled = output.pos;
+        if (filled == block_size) {
+            if (!publish(block)) {
+                stopped = true;
+                break;
+            }
+            block.resize(block_size);
+            filled = 0;
+            continue;
+        }
+        if (input.pos == input.size) {
+            // 0이 아니면 마지막 프레임이 중간에서 끝난 경우
+            ok = (ret == 0);
+            break;
+        }
+    }
+    ZSTD_freeDCtx(context);
+
+    if (ok && !stopped && filled > 0) {
+        block.resize(filled);
+        publish(block);
+    }
+    return ok;
+}
+#endif
+
+} // namespace
+
+Compression compression_for_path(std::string_view path) {
+    // FUSION_GZIP_EXTENSION, FUSION_ZSTD_EXTENSION과 같은 값
+    if (ends_with_ignore_case(path, ".gz")) {
+        return Compression::Gzip;
+    }
+    if (ends_with_ignore_case(path, ".zst")) {
+        return Compression::Zstd;
+    }
+    return Compression::None;
+}
+
+Compression detect_compression(std::string_view contents) {
+    if (has_gzip_magic(contents)) {
+        return Compression::Gzip;
+    }
+    if (has_zstd_magic(contents)) {
+        return Compression::Zstd;
+    }
+    return Compression::None;
+}
+
+bool compression_available(Compression compression) {
+    switch (compression) {
+    case Compression::None:
+        return true;
+    case Compression::Gzip:
+#ifdef FUSION_HAVE_ZLIB
+        return true;
+#else
+        return false;
+#endif
+    case Compression::Zstd:
+#ifdef FUSION_HAVE_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+const char* compression_name(Compression compression) {
+    switch (compression) {
+    case Compression::Gzip:
+        return "gzip";
+    case Compression::Zstd:
+        return "zstd";
+    default:
+        return "uncompressed";
+    }
+}
+
+DecompressStream::~DecompressStream() {
+    stop();
+}
+
+void DecompressStream::start(std::string_view source, Compression compression) {
+    stop();
+    std::lock_guard<std::mutex> lock(mutex_);
+    done_ = false;
+    failed_ = false;
+    stopping_ = false;
+    // 이전 실행에서 남은 블록은 버퍼만 재사용
+    while (!pending_.empty()) {
+        free_.push_back(std::move(pending_.front()));
+        pending_.pop_front();
+    }
+    thread_ = std::thread(&DecompressStream::run, this, source, compression);
+}
+
+bool DecompressStream::next(std::string& block) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] { return done_ || !pending_.empty(); });
+    if (pending_.empty()) {
+        return false;
+    }
+    free_.push_back(std::move(block));
+    block = std::move(pending_.front());
+    pending_.pop_front();
+    not_full_.notify_one();
+    return true;
+}
+
+bool DecompressStream::failed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_;
+}
+
+void DecompressStream::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    not_full_.notify_one();
+    thread_.join();
+}
+
+bool DecompressStream::publish(std::string& block) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [this] { return stopping_ || pending_.size() < MAX_PENDING_BLOCKS; });
+    if (stopping_) {
+        return false;
+    }
+    pending_.push_back(std::move(block));
+    if (!free_.empty()) {
+        block = std::move(free_.back());
+        free_.pop_back();
+    } else {
+        block = std::string();
+    }
+    not_empty_.notify_one();
+    return true;
+}
+
+void DecompressStream::run([[maybe_unused]] std::string_view source, Compression compression) {
+    std::string block;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_.empty()) {
+            block = std::move(free_.back());
+            free_.pop_back();
+        }
+    }
+    // 지원하는 형식이 없는 빌드에서는 사용하지 않음
+    [[maybe_unused]] auto publish_block = [this](std::string& filled) { return publish(filled); };
+
+    bool ok = false;
+    switch (compression) {
+#ifdef FUSION_HAVE_ZLIB
+    case Compression::Gzip:
+        ok = inflate_gzip(source, block, publish_block);
+        break;
+#endif
+#ifdef FUSION_HAVE_ZSTD
+    case Compression::Zstd:
+        ok = decompress_zstd(source, block, publish_block);
+        break;
+#endif
+    default:
+        break;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    done_ = true;
+    failed_ = !ok && !stopping_;
+    free_.push_back(std::move(block));
+    not_empty_.notify_one();
+}
+
+struct CompressStream::Codec {
+    Compression compression = Compression::None;
+#ifdef FUSION_HAVE_ZLIB
+    z_stream gzip{};
+#endif
+#ifdef FUSION_HAVE_ZSTD
+    ZSTD_CCtx* zstd = nullptr;
+#endif
+
+    ~Codec() { release(); }
+
+    void release() {
+#ifdef FUSION_HAVE_ZLIB
+        if (compression == Compression::Gzip) {
+            deflateEnd(&gzip);
+        }
+#endif
+#ifdef FUSION_HAVE_ZSTD
+        if (zstd) {
+            ZSTD_freeCCtx(zstd);
+            zstd = nullptr;
+        }
+#endif
+        compression = Compression::None;
+    }
+};
+
+CompressStream::CompressStream() : codec_(new Codec) {}
+
+CompressStream::~CompressStream() = default;
+
+bool CompressStream::open(std::FILE* file, Compression compression) {
+    codec_->release();
+    file_ = nullptr;
+    failed_ = false;
+    switch (compression) {
+#ifdef FUSION_HAVE_ZLIB
+    case Compression::Gzip:
+        codec_->gzip = z_stream{};
+        if (deflateInit2(&codec_->gzip, GZIP_LEVEL, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            return false;
+        }
+        break;
+#endif
+#ifdef FUSION_HAVE_ZSTD
+    case Compression::Zstd:
+        codec_->zstd = ZSTD_createCCtx();
+        if (!codec_->zstd ||
+            ZSTD_isError(ZSTD_CCtx_setParameter(codec_->zstd, ZSTD_c_compressionLevel, ZSTD_LEVEL))) {
+            codec_->release();
+            return false;
+        }
+        break;
+#endif
+    default:
+        return false;
+    }
+    codec_->compression = compression;
+    file_ = file;
+    output_.resize(COMPRESS_OUTPUT_SIZE);
+    return true;
+}
+
+bool CompressStream::write_output(size_t size) {
+    if (size > 0 && !failed_ && std::fwrite(output_.data(), 1, size, file_) != size) {
+        failed_ = true;
+    }
+    return !failed_;
+}
+
+bool CompressStream::write(const char* data, size_t size) {
+    if (!file_) {
+        return false;
+    }
+    while (size > 0 && !failed_) {
+        size_t part = std::min(size, MAX_CODEC_INPUT);
+#ifdef FUSION_HAVE_ZLIB
+        if (codec_->compression == Compression::Gzip) {
+            z_stream& stream = codec_->gzip;
+            stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+            stream.avail_in = static_cast<uInt>(part);
+            do {
+                stream.next_out = reinterpret_cast<Bytef*>(output_.data());
+                stream.avail_out = static_cast<uInt>(output_.size());
+                deflate(&stream, Z_NO_FLUSH);
+                write_output(output_.size() - stream.avail_out);
+            } while (stream.avail_out == 0 && !failed_);
+        }
+#endif
+#ifdef FUSION_HAVE_ZSTD
+        if (codec_->compression == Compression::Zstd) {
+            ZSTD_inBuffer input{data, part, 0};
+            while (input.pos < input.size && !failed_) {
+                ZSTD_outBuffer output{output_.data(), output_.size(), 0};
+                if (ZSTD_isError(ZSTD_compressStream2(codec_->zstd, &output, &input, ZSTD_e_continue))) {
+                    failed_ = true;
+                    break;
+                }
+                write_output(output.pos);
+            }
+        }
+#endif
+        data += part;
+        size -= part;
+    }
+    return !failed_;
+}
+
+bool CompressStream::finish() {
+    if (!file_) {
+        return false;
+    }
+#ifdef FUSION_HAVE_ZLIB
+    if (codec_->compression == Compression::Gzip) {
+        z_stream& stream = codec_->gzip;
+        stream.next_in = nullptr;
+        stream.avail_in = 0;
+        int ret = Z_OK;
+        while (ret == Z_OK && !failed_) {
+            stream.next_out = reinterpret_cast<Bytef*>(output_.data());
+            stream.avail_out = static_cast<uInt>(output_.size());
+            ret = deflate(&stream, Z_FINISH);
+            write_output(output_.size() - stream.avail_out);
+        }
+        if (ret != Z_STREAM_END) {
+            failed_ = true;
+        }
+    }
+#endif
+#ifdef FUSION_HAVE_ZSTD
+    if (codec_->compression == Compression::Zstd) {
+        ZSTD_inBuffer input{nullptr, 0, 0};
+        size_t remaining = 1;
+        while (remaining != 0 && !failed_) {
+            ZSTD_outBuffer output{output_.data(), output_.size(), 0};
+            remaining = ZSTD_compressStream2(codec_->zstd, &output, &input, ZSTD_e_end);
+            if (ZSTD_isError(remaining)) {
+                failed_ = true;
+                break;
+            }
+            write_output(output.pos);
+        }
+    }
+#endif
+    codec_->release();
+    file_ = nullptr;
+    return !failed_;
+}
+
+} // namespace fusion
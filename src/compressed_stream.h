@@ -0,0 +1,158 @@
+#ifndef COMPRESSED_STREAM_H
+#define COMPRESSED_STREAM_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace fusion {
+
+// 입출력 압축 형식
+enum class Compression {
+    None,
+    Gzip,   // .gz (zlib, FUSION_HAVE_ZLIB)
+    Zstd    // .zst (FUSION_HAVE_ZSTD)
+};
+
+/**
+ * 출력 경로의 확장자로 압축 형식 선택 (".gz", ".zst", 대소문자 무시)
+ */
+Compression compression_for_path(std::string_view path);
+
+/**
+ * 파일 앞부분의 매직 바이트로 압축 형식 판별 (입력용)
+ */
+Compression detect_compression(std::string_view contents);
+
+/**
+ * 이 빌드에서 해당 압축 형식을 지원하는지 여부
+ */
+bool compression_available(Compression compression);
+
+/**
+ * 로그 메시지용 이름 ("gzip", "zstd")
+ */
+const char* compression_name(Compression compression);
+
+/**
+ * 압축된 입력을 백그라운드 스레드에서 풀어 블록 단위로 넘겨주는 스트림
+ *
+ * 압축 해제와 호출자의 파싱이 겹쳐 수행되며, 대기 중인 블록 수를 제한하므로
+ * 입력 크기와 관계없이 메모리 사용량이 일정하다.
+ * gzip 멤버나 zstd 프레임이 여러 개 이어진 입력은 하나의 스트림으로 읽는다.
+ */
+class DecompressStream {
+public:
+    // 한 블록의 최대 크기 (압축 해제 후)
+    static constexpr size_t BLOCK_SIZE = 1 << 20;
+
+    // 파싱을 기다리는 최대 블록 수
+    static constexpr size_t MAX_PENDING_BLOCKS = 4;
+
+    DecompressStream() = default;
+    ~DecompressStream();
+
+    DecompressStream(const DecompressStream&) = delete;
+    DecompressStream& operator=(const DecompressStream&) = delete;
+
+    /**
+     * 압축 해제 스레드 시작 (이미 실행 중이면 멈추고 처음부터 다시 시작)
+     *
+     * @param source 압축된 입력 전체 (stop() 또는 소멸 전까지 유효해야 함)
+     * @param compression 압축 형식 (compression_available()이어야 함)
+     */
+    void start(std::string_view source, Compression compression);
+
+    /**
+     * 다음 블록을 block과 교환 (넘겨준 block의 버퍼는 다음 블록에 재사용)
+     *
+     * @return 블록을 받았으면 true, 입력 끝이거나 오류면 false
+     */
+    bool next(std::string& block);
+
+    /**
+     * 손상되거나 잘린 입력 때문에 중간에 멈췄는지 여부 (next()가 false를 반환한 뒤 확인)
+     */
+    bool failed() const;
+
+    /**
+     * 압축 해제 스레드 중단
+     */
+    void stop();
+
+private:
+    void run(std::string_view source, Compression compression);
+    // 블록 하나를 넘김 (대기 중인 블록이 가득 차면 대기), 중단 요청이면 false
+    bool publish(std::string& block);
+
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<std::string> pending_;
+    std::vector<std::string> free_;
+    bool done_ = false;
+    bool failed_ = false;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+/**
+ * 출력 파일에 쓰는 바이트를 바로 압축해 기록하는 스트림
+ *
+ * 기존 파일 뒤에 이어서 쓰면 새 gzip 멤버/zstd 프레임이 추가되며, 이어진 파일도 표준 도구로 한 번에 풀린다.
+ */
+class CompressStream {
+public:
+    CompressStream();
+    ~CompressStream();
+
+    CompressStream(const CompressStream&) = delete;
+    CompressStream& operator=(const CompressStream&) = delete;
+
+    /**
+     * 압축 시작
+     *
+     * @param file 압축한 바이트를 기록할 파일 (finish() 전까지 열려 있어야 함)
+     * @param compression 압축 형식 (compression_available()이어야 함)
+     * @return 압축기를 초기화하지 못하면 false
+     */
+    bool open(std::FILE* file, Compression compression);
+
+    bool is_open() const { return file_ != nullptr; }
+
+    /**
+     * 데이터를 압축해 기록 (압축기 내부에 일부가 남아 있을 수 있음)
+     *
+     * @return 지금까지의 모든 쓰기가 성공했으면 true
+     */
+    bool write(const char* data, size_t size);
+
+    /**
+     * 남은 데이터와 스트림 끝을 기록하고 압축 종료 (파일은 닫지 않음)
+     *
+     * @return 모든 쓰기가 성공했으면 true
+     */
+    bool finish();
+
+private:
+    struct Codec;
+
+    // 압축기가 내놓은 바이트를 파일에 기록
+    bool write_output(size_t size);
+
+    std::unique_ptr<Codec> codec_;
+    std::FILE* file_ = nullptr;
+    std::vector<char> output_;
+    bool failed_ = false;
+};
+
+} // namespace fusion
+
+#endif // COMPRESSED_STREAM_H
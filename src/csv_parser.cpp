@@ -1,116 +1,631 @@
 #include "csv_parser.h"
-#include <fstream>
-#include <sstream>
-#include <iostream>
+#include "fusion_log.h"
+#include "run_stats.h"
 #include <algorithm>
+#include <charconv>
 #include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 
 namespace fusion {
 
-bool parse_csv(const std::string& file_path, std::vector<InputData>& data) {
-    std::ifstream file(file_path);
-    if (!file.is_open()) {
-        std::cerr << "Error: Cannot open file " << file_path << std::endl;
+namespace {
+
+// 토큰 앞뒤에서 제거하는 공백 문자 (" \t\r\n")
+inline bool is_trim_char(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// strtod/strtol이 건너뛰는 선행 공백 문자
+inline bool is_leading_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+struct FieldView {
+    const char* begin;
+    const char* end;
+};
+
+inline void trim_field(FieldView& field) {
+    while (field.begin < field.end && is_trim_char(*field.begin)) {
+        ++field.begin;
+    }
+    while (field.end > field.begin && is_trim_char(*(field.end - 1))) {
+        --field.end;
+    }
+}
+
+// 줄 전체가 공백 문자로만 이루어져 있는지 확인
+inline bool is_blank_line(const char* begin, const char* end) {
+    for (const char* p = begin; p < end; ++p) {
+        if (!is_trim_char(*p)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 대소문자 구분 없이 "datetime" 포함 여부 확인 (헤더 판별용)
+bool contains_datetime_keyword(const char* begin, const char* end) {
+    static const char keyword[] = "datetime";
+    const size_t keyword_len = sizeof(keyword) - 1;
+    if (static_cast<size_t>(end - begin) < keyword_len) {
         return false;
     }
-    
-    std::string line;
-    bool is_first_line = true;
-    
-    while (std::getline(file, line)) {
-        // 빈 줄 건너뛰기
-        if (line.empty() || line.find_first_not_of(" \t\r\n") == std::string::npos) {
-            continue;
+    for (const char* p = begin; p + keyword_len <= end; ++p) {
+        size_t k = 0;
+        while (k < keyword_len &&
+               static_cast<char>(std::tolower(static_cast<unsigned char>(p[k]))) == keyword[k]) {
+            ++k;
         }
-        
-        // 헤더 줄 건너뛰기
-        if (is_first_line) {
-            is_first_line = false;
-            // 헤더인지 확인 (DateTime으로 시작하는지)
-            std::string lower_line = line;
-            std::transform(lower_line.begin(), lower_line.end(), lower_line.begin(), ::tolower);
-            if (lower_line.find("datetime") != std::string::npos) {
-                continue;
+        if (k == keyword_len) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// std::stod 와 같은 규칙으로 필드를 double로 변환 (앞부분만 숫자여도 허용)
+bool parse_double_field(const char* begin, const char* end, double& out) {
+    while (begin < end && is_leading_space(*begin)) {
+        ++begin;
+    }
+    if (begin < end && *begin == '+') {
+        ++begin;
+        if (begin < end && (*begin == '+' || *begin == '-')) {
+            return false;
+        }
+    }
+    const char* digits = (begin < end && *begin == '-') ? begin + 1 : begin;
+    if (end - digits >= 2 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X')) {
+        // 16진수 부동소수점은 from_chars(general)가 지원하지 않으므로 strtod로 처리
+        std::string text(begin, end);
+        char* parse_end = nullptr;
+        errno = 0;
+        out = std::strtod(text.c_str(), &parse_end);
+        return parse_end != text.c_str() && errno != ERANGE;
+    }
+    auto result = std::from_chars(begin, end, out);
+    // strtod는 비정규수(subnormal)를 ERANGE로 보고하므로 stod와 동일하게 실패 처리
+    return result.ec == std::errc() && std::fpclassify(out) != FP_SUBNORMAL;
+}
+
+// std::stoi 와 같은 규칙으로 필드를 int로 변환
+bool parse_int_field(const char* begin, const char* end, int& out) {
+    while (begin < end && is_leading_space(*begin)) {
+        ++begin;
+    }
+    if (begin < end && *begin == '+') {
+        ++begin;
+        if (begin < end && (*begin == '+' || *begin == '-')) {
+            return false;
+        }
+    }
+    auto result = std::from_chars(begin, end, out);
+    return result.ec == std::errc();
+}
+
+// 한 줄의 파싱 결과 (datetime은 원본 또는 unquoted 버퍼를 가리키므로 다음 줄 파싱 전까지만 유효)
+struct ParsedRow {
+    std::string_view datetime;
+    double gps_y;
+    double gps_z;
+    double acc_y;
+    double acc_z;
+    int fix;
+};
+
+// 데이터 한 줄을 파싱하여 row에 저장
+// warnings가 nullptr이면 잘못된 줄에 대한 경고를 전달하지 않는다
+bool parse_data_line(const char* line_begin, const char* line_end,
+                     std::string& unquoted, WarningLimiter* warnings, ParsedRow& row) {
+    // CSV 파싱 (쉼표로 구분, 따옴표 안의 쉼표는 무시하고 따옴표 문자는 제거)
+    FieldView fields[6];
+    size_t field_count = 0;
+    
+    if (!std::memchr(line_begin, '"', static_cast<size_t>(line_end - line_begin))) {
+        // 따옴표가 없는 줄: 원본 바이트를 그대로 참조
+        const char* field_begin = line_begin;
+        while (field_count < 6) {
+            const char* comma = static_cast<const char*>(
+                std::memchr(field_begin, ',', static_cast<size_t>(line_end - field_begin)));
+            const char* field_end = comma ? comma : line_end;
+            fields[field_count++] = FieldView{field_begin, field_end};
+            if (!comma) {
+                break;
             }
+            field_begin = comma + 1;
         }
-        
-        std::istringstream iss(line);
-        std::string token;
-        InputData row;
-        
-        // CSV 파싱 (쉼표로 구분)
-        std::vector<std::string> tokens;
-        std::string current_token;
+    } else {
+        // 따옴표가 있는 줄: 따옴표를 제거한 내용을 버퍼에 모은 뒤 참조
+        unquoted.clear();
+        size_t offsets[7];
+        offsets[0] = 0;
         bool in_quotes = false;
-        
-        for (char c : line) {
+        for (const char* p = line_begin; p < line_end && field_count < 6; ++p) {
+            char c = *p;
             if (c == '"') {
                 in_quotes = !in_quotes;
             } else if (c == ',' && !in_quotes) {
-                tokens.push_back(current_token);
-                current_token.clear();
+                offsets[++field_count] = unquoted.size();
             } else {
-                current_token += c;
+                unquoted.push_back(c);
             }
         }
-        tokens.push_back(current_token); // 마지막 토큰
-        
-        // 토큰 정리 (앞뒤 공백 제거)
-        for (auto& t : tokens) {
-            // 앞뒤 공백 제거
-            t.erase(0, t.find_first_not_of(" \t\r\n"));
-            t.erase(t.find_last_not_of(" \t\r\n") + 1);
-            // 따옴표 제거
-            if (!t.empty() && t.front() == '"' && t.back() == '"') {
-                t = t.substr(1, t.length() - 2);
+        if (field_count < 6) {
+            offsets[++field_count] = unquoted.size();
+        }
+        for (size_t i = 0; i < field_count; i++) {
+            fields[i] = FieldView{unquoted.data() + offsets[i], unquoted.data() + offsets[i + 1]};
+        }
+    }
+    
+    // 최소 6개 컬럼 필요
+    if (field_count < 6) {
+        if (warnings && warnings->should_report()) {
+            LogLine(LogLevel::Warning) << "Insufficient columns in line: "
+                                       << std::string(line_begin, line_end);
+        }
+        return false;
+    }
+    
+    // 토큰 정리 (앞뒤 공백 제거)
+    for (auto& field : fields) {
+        trim_field(field);
+    }
+    
+    double values[4];
+    int fix = 0;
+    const char* failed_function = nullptr;
+    for (size_t i = 0; i < 4 && !failed_function; i++) {
+        values[i] = 0.0;
+        if (fields[i + 1].begin != fields[i + 1].end &&
+            !parse_double_field(fields[i + 1].begin, fields[i + 1].end, values[i])) {
+            failed_function = "stod";
+        }
+    }
+    if (!failed_function && fields[5].begin != fields[5].end &&
+        !parse_int_field(fields[5].begin, fields[5].end, fix)) {
+        failed_function = "stoi";
+    }
+    if (failed_function) {
+        if (warnings && warnings->should_report()) {
+            LogLine(LogLevel::Warning) << "Error parsing line: " << std::string(line_begin, line_end)
+                                       << " - " << failed_function;
+        }
+        return false;
+    }
+    
+    row.datetime = std::string_view(fields[0].begin, static_cast<size_t>(fields[0].end - fields[0].begin));
+    row.gps_y = values[0];
+    row.gps_z = values[1];
+    row.acc_y = values[2];
+    row.acc_z = values[3];
+    row.fix = fix;
+    return true;
+}
+
+} // namespace
+
+bool CsvReader::open(const std::string& file_path) {
+    row_warnings_.flush();
+    // 압축 해제 스레드가 이전 파일의 매핑을 읽고 있으므로 먼저 멈춤
+    decompressor_.stop();
+    offset_ = 0;
+    reported_until_ = 0;
+    is_first_line_ = true;
+    is_columnar_ = false;
+    compression_ = Compression::None;
+    buffer_.clear();
+    buffer_offset_ = 0;
+    stream_ended_ = false;
+    failed_ = false;
+    path_ = file_path;
+    if (!file_.open(file_path)) {
+        LogLine(LogLevel::Error) << "Cannot open file " << file_path;
+        return false;
+    }
+    Compression compression = detect_compression(contents());
+    if (compression != Compression::None) {
+        if (!compression_available(compression)) {
+            LogLine(LogLevel::Error) << "Cannot read " << compression_name(compression)
+                                     << " input (not supported in this build): " << file_path;
+            file_.close();
+            return false;
+        }
+        compression_ = compression;
+        decompressor_.start(contents(), compression_);
+        return true;
+    }
+    if (is_columnar_input(contents())) {
+        if (!columnar_.open(contents())) {
+            LogLine(LogLevel::Error) << "Invalid binary input file " << file_path;
+            file_.close();
+            return false;
+        }
+        is_columnar_ = true;
+    }
+    return true;
+}
+
+bool CsvReader::eof() const {
+    if (is_compressed()) {
+        return stream_ended_ && offset_ >= buffer_offset_ + buffer_.size();
+    }
+    return offset_ >= (is_columnar_ ? columnar_.size() : file_.size());
+}
+
+bool CsvReader::fill_buffer() {
+    if (!is_compressed() || stream_ended_) {
+        return false;
+    }
+    // 이미 읽은 부분은 버리고 블록 경계에 걸친 줄만 남김
+    size_t consumed = std::min(offset_ - buffer_offset_, buffer_.size());
+    buffer_.erase(0, consumed);
+    buffer_offset_ += consumed;
+    if (!decompressor_.next(block_)) {
+        stream_ended_ = true;
+        if (decompressor_.failed()) {
+            failed_ = true;
+            LogLine(LogLevel::Error) << "Corrupt or truncated " << compression_name(compression_)
+                                     << " input: " << path_;
+        }
+        return false;
+    }
+    buffer_.append(block_);
+    return true;
+}
+
+template <typename Rows>
+size_t CsvReader::read_columnar(Rows& rows, size_t max_rows) {
+    RunStats& stats = run_stats();
+    StageTimer timer(stats.parse_ns);
+    size_t count = std::min(max_rows, columnar_.size() - std::min(offset_, columnar_.size()));
+    columnar_.append_rows(offset_, count, rows);
+    offset_ += count;
+    
+    // 이미 지나간 구간을 다시 읽을 때는 통계를 반복하지 않음
+    if (offset_ > reported_until_) {
+        size_t new_rows = offset_ - std::max(reported_until_, offset_ - count);
+        stats.rows_parsed += new_rows;
+        stats.bytes_read += new_rows * ColumnarInput::ROW_BYTES;
+        reported_until_ = offset_;
+    }
+    return count;
+}
+
+template <typename AppendRow>
+size_t CsvReader::read_rows(size_t max_rows, AppendRow append_row) {
+    RunStats& stats = run_stats();
+    StageTimer timer(stats.parse_ns);
+    size_t appended = 0;
+    ParsedRow row;
+    
+    while (appended < max_rows) {
+        std::string_view input = buffered();
+        size_t position = offset_ - buffer_offset_;
+        if (position >= input.size()) {
+            if (fill_buffer()) {
+                continue;
             }
+            break;
         }
-        
-        // 최소 6개 컬럼 필요
-        if (tokens.size() < 6) {
-            std::cerr << "Warning: Insufficient columns in line: " << line << std::endl;
+        const char* const input_begin = input.data();
+        const char* const input_end = input_begin + input.size();
+        const char* cursor = input_begin + position;
+        const char* newline = static_cast<const char*>(
+            std::memchr(cursor, '\n', static_cast<size_t>(input_end - cursor)));
+        if (!newline && fill_buffer()) {
+            // 압축된 입력에서 줄이 블록 경계에 걸친 경우: 다음 블록을 붙여 다시 찾음
             continue;
         }
+        const char* line_begin = cursor;
+        if (!newline && complete_lines_only_) {
+            break;
+        }
+        const char* line_end = newline ? newline : input_end;
+        size_t line_offset = offset_;
+        offset_ = buffer_offset_ + static_cast<size_t>((newline ? newline + 1 : input_end) - input_begin);
         
-        try {
-            row.datetime = tokens[0];
-            row.gps_y = tokens[1].empty() ? 0.0 : std::stod(tokens[1]);
-            row.gps_z = tokens[2].empty() ? 0.0 : std::stod(tokens[2]);
-            row.acc_y = tokens[3].empty() ? 0.0 : std::stod(tokens[3]);
-            row.acc_z = tokens[4].empty() ? 0.0 : std::stod(tokens[4]);
-            row.fix = tokens[5].empty() ? 0 : std::stoi(tokens[5]);
-            
-            data.push_back(row);
-        } catch (const std::exception& e) {
-            std::cerr << "Warning: Error parsing line: " << line << " - " << e.what() << std::endl;
+        // 이미 지나간 구간을 다시 읽을 때는 같은 경고와 통계를 반복하지 않음
+        bool first_pass = offset_ > reported_until_;
+        if (first_pass) {
+            stats.bytes_read += offset_ - std::max(reported_until_, line_offset);
+            reported_until_ = offset_;
+        }
+        
+        // 빈 줄 건너뛰기
+        if (is_blank_line(line_begin, line_end)) {
             continue;
         }
+        
+        // 헤더 줄 건너뛰기 (DateTime 포함 여부로 판별)
+        if (is_first_line_) {
+            is_first_line_ = false;
+            if (contains_datetime_keyword(line_begin, line_end)) {
+                continue;
+            }
+        }
+        
+        if (parse_data_line(line_begin, line_end, unquoted_, first_pass ? &row_warnings_ : nullptr, row)) {
+            append_row(row);
+            appended++;
+            if (first_pass) {
+                stats.rows_parsed++;
+            }
+        } else if (first_pass) {
+            stats.rows_rejected++;
+        }
     }
     
-    file.close();
-    return true;
+    return appended;
+}
+
+size_t CsvReader::read(SampleBlock& block, size_t max_rows) {
+    if (is_columnar_) {
+        return read_columnar(block, max_rows);
+    }
+    return read_rows(max_rows, [&block](const ParsedRow& row) {
+        block.datetime.push_back(row.datetime);
+        block.gps_y.push_back(row.gps_y);
+        block.gps_z.push_back(row.gps_z);
+        block.acc_y.push_back(row.acc_y);
+        block.acc_z.push_back(row.acc_z);
+        block.fix.push_back(row.fix);
+    });
+}
+
+size_t CsvReader::read(std::vector<InputData>& rows, size_t max_rows) {
+    if (is_columnar_) {
+        return read_columnar(rows, max_rows);
+    }
+    return read_rows(max_rows, [&rows](const ParsedRow& row) {
+        InputData data;
+        data.datetime.assign(row.datetime);
+        data.gps_y = row.gps_y;
+        data.gps_z = row.gps_z;
+        data.acc_y = row.acc_y;
+        data.acc_z = row.acc_z;
+        data.fix = row.fix;
+        rows.push_back(std::move(data));
+    });
+}
+
+void CsvReader::seek(size_t offset) {
+    if (is_compressed()) {
+        if (offset < buffer_offset_) {
+            // 이미 버린 부분으로 돌아가려면 처음부터 다시 풂 (앞으로 이동하면 읽으면서 건너뜀)
+            decompressor_.start(contents(), compression_);
+            buffer_.clear();
+            buffer_offset_ = 0;
+            stream_ended_ = false;
+            failed_ = false;
+        }
+        offset_ = offset;
+    } else {
+        size_t end = is_columnar_ ? columnar_.size() : file_.size();
+        offset_ = offset < end ? offset : end;
+    }
+    is_first_line_ = (offset_ == 0);
+}
+
+bool parse_csv(const std::string& file_path, std::vector<InputData>& data) {
+    CsvReader reader;
+    if (!reader.open(file_path)) {
+        return false;
+    }
+    reader.read(data, static_cast<size_t>(-1));
+    return !reader.failed();
 }
 
-bool save_csv(const std::string& file_path, const std::vector<OutputData>& data) {
-    std::ofstream file(file_path);
-    if (!file.is_open()) {
-        std::cerr << "Error: Cannot create file " << file_path << std::endl;
+bool parse_csv(const std::string& file_path, SampleBlock& block) {
+    CsvReader reader;
+    if (!reader.open(file_path)) {
         return false;
     }
+    reader.read(block, static_cast<size_t>(-1));
+    return !reader.failed();
+}
+
+namespace {
+
+// 출력 줄바꿈 (기존 텍스트 모드 std::ofstream 출력과 동일하게 Windows에서는 CRLF)
+#ifdef _WIN32
+const char OUTPUT_NEWLINE[] = "\r\n";
+#else
+const char OUTPUT_NEWLINE[] = "\n";
+#endif
+const size_t OUTPUT_NEWLINE_LEN = sizeof(OUTPUT_NEWLINE) - 1;
+
+// 변위 값 하나의 최대 출력 길이 (부호, 17자리, 소수점, 지수 포함)
+const size_t MAX_DOUBLE_CHARS = 32;
+
+} // namespace
+
+CsvWriter::~CsvWriter() {
+    if (file_) {
+        close();
+    }
+}
+
+bool CsvWriter::open(const std::string& file_path, int precision, bool append_existing) {
+    if (file_) {
+        close();
+    }
+    failed_ = false;
+    used_ = 0;
+    precision_ = precision;
+    mirror_ = nullptr;
+    mirror_from_ = 0;
+    
+    Compression compression = compression_for_path(file_path);
+    if (!compression_available(compression)) {
+        LogLine(LogLevel::Error) << "Cannot write " << compression_name(compression)
+                                 << " output (not supported in this build): " << file_path;
+        return false;
+    }
+    
+    StageTimer timer(run_stats().write_ns);
+    file_ = std::fopen(file_path.c_str(), append_existing ? "ab" : "wb");
+    if (!file_) {
+        LogLine(LogLevel::Error) << "Cannot create file " << file_path;
+        return false;
+    }
+    // 기존 압축 파일 뒤에 이어 쓰면 새 gzip 멤버/zstd 프레임으로 추가됨
+    if (compression != Compression::None && !compressor_.open(file_, compression)) {
+        LogLine(LogLevel::Error) << "Cannot initialize " << compression_name(compression)
+                                 << " compression for " << file_path;
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+    // 자체 버퍼를 사용하므로 stdio 버퍼링은 끔
+    std::setvbuf(file_, nullptr, _IONBF, 0);
+    buffer_.resize(BUFFER_SIZE);
+    
+    if (append_existing) {
+        return true;
+    }
     
     // 헤더 작성
-    file << "DateTime,Displacement_Y,Displacement_Z\n";
+    static const char header[] = "DateTime,Displacement_Y,Displacement_Z";
+    append(header, sizeof(header) - 1);
+    append(OUTPUT_NEWLINE, OUTPUT_NEWLINE_LEN);
+    return true;
+}
+
+bool CsvWriter::write_buffer() {
+    if (mirror_ && used_ > mirror_from_) {
+        mirror_->append(buffer_.data() + mirror_from_, used_ - mirror_from_);
+    }
+    mirror_from_ = 0;
+    if (used_ > 0 && !failed_) {
+        write_out(buffer_.data(), used_);
+        if (!failed_) {
+            run_stats().bytes_written += used_;
+        }
+    }
+    used_ = 0;
+    return !failed_;
+}
+
+void CsvWriter::write_out(const char* data, size_t size) {
+    if (failed_) {
+        return;
+    }
+    if (compressor_.is_open()) {
+        failed_ = !compressor_.write(data, size);
+    } else if (std::fwrite(data, 1, size, file_) != size) {
+        failed_ = true;
+    }
+}
+
+bool CsvWriter::flush() {
+    StageTimer timer(run_stats().write_ns);
+    return write_buffer();
+}
+
+void CsvWriter::set_mirror(CsvWriter* mirror) {
+    if (mirror_ && used_ > mirror_from_) {
+        mirror_->append(buffer_.data() + mirror_from_, used_ - mirror_from_);
+    }
+    mirror_ = mirror;
+    mirror_from_ = used_;
+}
+
+void CsvWriter::append(const char* data, size_t size) {
+    if (buffer_.size() - used_ < size) {
+        write_buffer();
+        if (size > buffer_.size()) {
+            // 버퍼보다 큰 데이터는 바로 기록
+            if (mirror_) {
+                mirror_->append(data, size);
+            }
+            write_out(data, size);
+            return;
+        }
+    }
+    std::memcpy(buffer_.data() + used_, data, size);
+    used_ += size;
+}
+
+void CsvWriter::append_double(double value) {
+    if (buffer_.size() - used_ < MAX_DOUBLE_CHARS) {
+        write_buffer();
+    }
+    char* first = buffer_.data() + used_;
+    char* last = buffer_.data() + buffer_.size();
+    std::to_chars_result result = (precision_ == SHORTEST_OUTPUT_PRECISION)
+        ? std::to_chars(first, last, value)
+        : std::to_chars(first, last, value, std::chars_format::general, precision_);
+    used_ = static_cast<size_t>(result.ptr - buffer_.data());
+}
+
+void CsvWriter::write_row(std::string_view datetime, double displacement_y, double displacement_z) {
+    append(datetime.data(), datetime.size());
+    append(",", 1);
+    append_double(displacement_y);
+    append(",", 1);
+    append_double(displacement_z);
+    append(OUTPUT_NEWLINE, OUTPUT_NEWLINE_LEN);
+}
+
+void CsvWriter::write_rows(const TimestampColumn& datetime,
+                           Span<const double> displacement_y, Span<const double> displacement_z) {
+    StageTimer timer(run_stats().write_ns);
+    TimestampBuffer buffer;
+    for (size_t i = 0; i < displacement_y.size(); i++) {
+        write_row(datetime.text(i, buffer), displacement_y[i], displacement_z[i]);
+    }
+}
+
+bool CsvWriter::close() {
+    if (!file_) {
+        return false;
+    }
+    StageTimer timer(run_stats().write_ns);
+    write_buffer();
+    mirror_ = nullptr;
+    if (compressor_.is_open() && !compressor_.finish()) {
+        failed_ = true;
+    }
+    if (std::fclose(file_) != 0) {
+        failed_ = true;
+    }
+    file_ = nullptr;
+    return !failed_;
+}
+
+bool save_csv(const std::string& file_path, const TimestampColumn& datetime,
+              Span<const double> displacement_y, Span<const double> displacement_z,
+              int precision) {
+    CsvWriter writer;
+    if (!writer.open(file_path, precision)) {
+        return false;
+    }
+    
+    writer.write_rows(datetime, displacement_y, displacement_z);
+    return writer.close();
+}
+
+bool save_csv(const std::string& file_path, const std::vector<OutputData>& data, int precision) {
+    CsvWriter writer;
+    if (!writer.open(file_path, precision)) {
+        return false;
+    }
     
     // 데이터 작성
-    for (const auto& row : data) {
-        file << row.datetime << ","
-             << row.displacement_y << ","
-             << row.displacement_z << "\n";
+    {
+        StageTimer timer(run_stats().write_ns);
+        TimestampBuffer buffer;
+        for (const auto& row : data) {
+            writer.write_row(row.datetime.text(buffer), row.displacement_y, row.displacement_z);
+        }
     }
     
-    file.close();
-    return true;
+    return writer.close();
 }
 
 } // namespace fusion
-
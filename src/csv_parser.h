@@ -1,7 +1,12 @@
 #ifndef CSV_PARSER_H
 #define CSV_PARSER_H
 
+#include "columnar_input.h"
+#include "compressed_stream.h"
 #include "data_structures.h"
+#include "fusion_log.h"
+#include "mapped_file.h"
+#include <cstdio>
 #include <vector>
 #include <string>
 
@@ -10,20 +15,256 @@ namespace fusion {
 /**
  * CSV 파일을 파싱하여 InputData 벡터로 변환
  * 
+ * 파일을 메모리 맵으로 열어 원본 바이트에서 구분자를 찾고,
+ * 숫자 필드는 std::from_chars로 제자리 변환한다 (행마다 토큰 문자열을 만들지 않음).
+ * 
  * @param file_path CSV 파일 경로
  * @param data 파싱된 데이터를 저장할 벡터
  * @return 성공 시 true, 실패 시 false
  */
 bool parse_csv(const std::string& file_path, std::vector<InputData>& data);
 
+/**
+ * CSV 파일을 파싱하여 컬럼 단위 SampleBlock에 추가
+ * 
+ * @param file_path CSV 파일 경로
+ * @param block 파싱된 데이터를 추가할 블록
+ * @return 성공 시 true, 실패 시 false
+ */
+bool parse_csv(const std::string& file_path, SampleBlock& block);
+
+/**
+ * 입력 CSV를 청크 단위로 읽는 스트리밍 리더 (pull 방식)
+ * 
+ * 파일은 메모리 맵으로 열고, read()를 호출할 때마다 요청한 행 수만큼만 파싱한다.
+ * 호출자는 청크 버퍼를 재사용하므로 입력 크기와 무관하게 메모리 사용량이 일정하다.
+ * 파싱 규칙(빈 줄, 헤더, 따옴표, 빈 필드)은 parse_csv와 동일하다.
+ * 
+ * 바이너리 컬럼 입력 파일(ColumnarInput)도 매직으로 판별해 같은 인터페이스로 읽는다.
+ * 이때는 텍스트 파싱 없이 컬럼을 복사하며, 읽기 위치는 바이트 오프셋 대신 행 번호이다.
+ * 
+ * gzip/zstd로 압축된 CSV도 매직으로 판별해 읽는다. 압축은 DecompressStream이 백그라운드 스레드에서
+ * 블록 단위로 풀고, 리더는 아직 파싱하지 않은 부분만 버퍼에 유지한다 (읽기 위치는 압축을 푼 바이트 기준).
+ */
+class CsvReader {
+public:
+    /**
+     * 입력 파일 열기
+     * 
+     * @param file_path CSV 파일 경로
+     * @return 성공 시 true, 실패 시 false
+     */
+    bool open(const std::string& file_path);
+    
+    /**
+     * 최대 max_rows개의 데이터 행을 읽어 rows 뒤에 추가
+     * 
+     * @param rows 파싱된 행을 추가할 벡터 (기존 내용은 유지)
+     * @param max_rows 읽을 최대 행 수
+     * @return 추가된 행 수 (파일 끝이면 0)
+     */
+    size_t read(std::vector<InputData>& rows, size_t max_rows);
+    
+    /**
+     * 최대 max_rows개의 데이터 행을 읽어 block의 각 컬럼 뒤에 추가
+     * 
+     * @param block 파싱된 행을 추가할 컬럼 버퍼 (기존 내용은 유지)
+     * @param max_rows 읽을 최대 행 수
+     * @return 추가된 행 수 (파일 끝이면 0)
+     */
+    size_t read(SampleBlock& block, size_t max_rows);
+    
+    /**
+     * 현재 읽기 위치 (파일 시작 기준 바이트 오프셋, 바이너리 입력이면 행 번호)
+     */
+    size_t tell() const { return offset_; }
+    
+    /**
+     * 읽기 위치 이동 (tell()로 얻은 오프셋을 사용)
+     * 오프셋 0이 아니면 헤더 줄은 이미 지나간 것으로 간주한다.
+     */
+    void seek(size_t offset);
+    
+    bool eof() const;
+    
+    /**
+     * 바이너리 컬럼 입력 파일인지 여부
+     */
+    bool is_columnar() const { return is_columnar_; }
+    
+    /**
+     * 압축된 입력인지 여부
+     */
+    bool is_compressed() const { return compression_ != Compression::None; }
+    
+    /**
+     * 압축된 입력이 손상되었거나 중간에서 잘려 끝까지 읽지 못했는지 여부
+     */
+    bool failed() const { return failed_; }
+    
+    /**
+     * 줄바꿈으로 끝나지 않은 마지막 줄 처리 방식 (기본값: false = 일반 행으로 읽음)
+     * true면 아직 기록 중인 줄로 보고 읽지 않으며, 읽기 위치도 그 줄 앞에 머문다.
+     * 다른 프로세스가 계속 덧붙이는 파일을 읽을 때 사용한다.
+     */
+    void set_complete_lines_only(bool enable) { complete_lines_only_ = enable; }
+    
+    /**
+     * 매핑된 파일 전체 내용 (압축된 입력이면 압축된 바이트)
+     */
+    std::string_view contents() const { return std::string_view(file_.data(), file_.size()); }
+    
+    /**
+     * 파일을 열 때의 마지막 수정 시각 (MappedFile::modified_time)
+     */
+    int64_t modified_time() const { return file_.modified_time(); }
+
+private:
+    template <typename AppendRow>
+    size_t read_rows(size_t max_rows, AppendRow append_row);
+    
+    template <typename Rows>
+    size_t read_columnar(Rows& rows, size_t max_rows);
+    
+    // 압축된 입력에서 다음 블록을 버퍼 뒤에 붙임 (이미 읽은 부분은 버림), 더 읽을 내용이 없으면 false
+    bool fill_buffer();
+    
+    // 파싱할 수 있는 입력 (buffer_offset_부터 시작)
+    std::string_view buffered() const {
+        return is_compressed() ? std::string_view(buffer_) : contents();
+    }
+    
+    MappedFile file_;
+    size_t offset_ = 0;
+    size_t reported_until_ = 0;
+    bool is_first_line_ = true;
+    bool complete_lines_only_ = false;
+    std::string unquoted_;
+    WarningLimiter row_warnings_{"Malformed input rows"};
+    ColumnarInput columnar_;
+    bool is_columnar_ = false;
+    Compression compression_ = Compression::None;
+    DecompressStream decompressor_;
+    std::string buffer_;            // 압축을 푼 입력 중 아직 읽지 않은 부분
+    std::string block_;             // 압축 해제 스트림과 교환하는 블록
+    size_t buffer_offset_ = 0;      // buffer_ 첫 바이트의 읽기 위치
+    bool stream_ended_ = false;
+    bool failed_ = false;
+    std::string path_;
+};
+
+// 출력 변위 값 기본 유효 숫자 자릿수 (기존 std::ostream 기본 출력과 동일)
+constexpr int DEFAULT_OUTPUT_PRECISION = 6;
+
+// 최단 왕복(round-trip) 표현으로 출력
+constexpr int SHORTEST_OUTPUT_PRECISION = 0;
+
+// 최대 유효 숫자 자릿수 (double을 손실 없이 표현하는 데 충분)
+constexpr int MAX_OUTPUT_PRECISION = 17;
+
+/**
+ * 출력 CSV를 기록하는 스트리밍 라이터
+ * 
+ * 값은 std::to_chars로 재사용 버퍼에 직접 포맷하고, 버퍼가 찰 때마다 큰 블록 단위로 기록한다.
+ * 출력 경로가 .gz/.zst로 끝나면 기록하는 블록을 바로 압축한다 (compression_for_path).
+ */
+class CsvWriter {
+public:
+    // 한 번에 기록하는 버퍼 크기
+    static constexpr size_t BUFFER_SIZE = 1 << 20;
+    
+    CsvWriter() = default;
+    ~CsvWriter();
+    
+    CsvWriter(const CsvWriter&) = delete;
+    CsvWriter& operator=(const CsvWriter&) = delete;
+    
+    /**
+     * 출력 파일을 만들고 헤더 작성
+     * 
+     * @param file_path 출력 CSV 파일 경로 (.gz/.zst면 압축, 이 빌드에서 지원하지 않는 형식이면 실패)
+     * @param precision 변위 값 유효 숫자 자릿수 (1~17, SHORTEST_OUTPUT_PRECISION이면 최단 왕복 표현)
+     * @param append_existing true면 기존 파일 뒤에 이어서 기록 (헤더 생략)
+     * @return 성공 시 true, 실패 시 false
+     */
+    bool open(const std::string& file_path, int precision = DEFAULT_OUTPUT_PRECISION, bool append_existing = false);
+    
+    /**
+     * 한 행 기록
+     */
+    void write_row(std::string_view datetime, double displacement_y, double displacement_z);
+    
+    /**
+     * 여러 행 기록
+     */
+    void write_rows(const TimestampColumn& datetime,
+                    Span<const double> displacement_y, Span<const double> displacement_z);
+    
+    /**
+     * 버퍼에 모인 행을 파일에 기록 (파일은 열린 상태 유지)
+     * 
+     * @return 지금까지의 모든 쓰기가 성공했으면 true
+     */
+    bool flush();
+    
+    /**
+     * 이후 기록하는 내용을 다른 라이터에도 그대로 복사
+     * 
+     * 포맷한 바이트를 버퍼 단위로 복사하므로 같은 행을 두 파일에 쓸 때 포맷은 한 번만 수행한다.
+     * 이미 기록한 헤더는 복사하지 않으며, close()하면 복사를 멈춘다.
+     * 
+     * @param mirror 복사 대상 (nullptr이면 복사 중단)
+     */
+    void set_mirror(CsvWriter* mirror);
+    
+    /**
+     * 남은 버퍼를 기록하고 파일 닫기
+     * 
+     * @return 모든 쓰기가 성공했으면 true
+     */
+    bool close();
+
+private:
+    void append(const char* data, size_t size);
+    void append_double(double value);
+    bool write_buffer();
+    // 파일에 기록 (압축 출력이면 압축해서 기록)
+    void write_out(const char* data, size_t size);
+    
+    std::FILE* file_ = nullptr;
+    CompressStream compressor_;
+    std::vector<char> buffer_;
+    size_t used_ = 0;
+    int precision_ = DEFAULT_OUTPUT_PRECISION;
+    bool failed_ = false;
+    CsvWriter* mirror_ = nullptr;
+    size_t mirror_from_ = 0;        // 버퍼에서 복사를 시작할 위치
+};
+
 /**
  * OutputData 벡터를 CSV 파일로 저장
  * 
  * @param file_path 출력 CSV 파일 경로
  * @param data 저장할 데이터 벡터
+ * @param precision 변위 값 유효 숫자 자릿수 (CsvWriter::open 참고)
+ * @return 성공 시 true, 실패 시 false
+ */
+bool save_csv(const std::string& file_path, const std::vector<OutputData>& data,
+              int precision = DEFAULT_OUTPUT_PRECISION);
+
+/**
+ * 컬럼 데이터를 CSV 파일로 저장
+ * 
+ * @param file_path 출력 CSV 파일 경로
+ * @param datetime 타임스탬프 컬럼
+ * @param displacement_y Y축 변위
+ * @param displacement_z Z축 변위
+ * @param precision 변위 값 유효 숫자 자릿수 (CsvWriter::open 참고)
  * @return 성공 시 true, 실패 시 false
  */
-bool save_csv(const std::string& file_path, const std::vector<OutputData>& data);
+bool save_csv(const std::string& file_path, const TimestampColumn& datetime,
+              Span<const double> displacement_y, Span<const double> displacement_z,
+              int precision = DEFAULT_OUTPUT_PRECISION);
 
 } // namespace fusion
 
@@ -1,14 +1,49 @@
 #ifndef DATA_STRUCTURES_H
 #define DATA_STRUCTURES_H
 
+#include "timestamp.h"
 #include <vector>
 #include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
 
 namespace fusion {
 
+/**
+ * 연속 메모리 구간에 대한 뷰 (소유권 없음)
+ * 
+ * 필터가 std::vector, SampleBlock 컬럼, 호출자 버퍼를 복사 없이 같은 방식으로 읽도록 한다.
+ */
+template <typename T>
+class Span {
+public:
+    Span() : data_(nullptr), size_(0) {}
+    Span(T* data, size_t size) : data_(data), size_(size) {}
+    
+    template <typename U>
+    Span(std::vector<U>& v) : data_(v.data()), size_(v.size()) {}
+    
+    template <typename U>
+    Span(const std::vector<U>& v) : data_(v.data()), size_(v.size()) {}
+    
+    T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    T& operator[](size_t i) const { return data_[i]; }
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+    
+    Span subspan(size_t offset, size_t count) const { return Span(data_ + offset, count); }
+
+private:
+    T* data_;
+    size_t size_;
+};
+
 // CSV 입력 데이터 구조 (6개 컬럼)
 struct InputData {
-    std::string datetime;  // yyyy-mm-dd HH:MM:SS.fff
+    RowTimestamp datetime; // yyyy-mm-dd HH:MM:SS.fff (정수로 해석, 지원하지 않는 형식은 원문 그대로)
     double gps_y;          // GPS_Y
     double gps_z;          // GPS_Z
     double acc_y;          // Acc_Y
@@ -16,6 +51,39 @@ struct InputData {
     int fix;               // Fix
 };
 
+// 컬럼 단위(SoA) 샘플 버퍼
+// 파서가 직접 채우고 필터는 Span으로 읽는다 (디스크 → 칼만 루프 사이 복사 최대 1회)
+struct SampleBlock {
+    TimestampColumn datetime;     // DateTime (정수 또는 원문)
+    std::vector<double> gps_y;    // GPS_Y
+    std::vector<double> gps_z;    // GPS_Z
+    std::vector<double> acc_y;    // Acc_Y
+    std::vector<double> acc_z;    // Acc_Z
+    std::vector<int> fix;         // Fix
+    
+    size_t size() const { return gps_y.size(); }
+    bool empty() const { return gps_y.empty(); }
+    
+    // 용량은 유지한 채 비움 (청크 간 재사용)
+    void clear() {
+        datetime.clear();
+        gps_y.clear();
+        gps_z.clear();
+        acc_y.clear();
+        acc_z.clear();
+        fix.clear();
+    }
+    
+    void reserve(size_t rows) {
+        datetime.reserve(rows);
+        gps_y.reserve(rows);
+        gps_z.reserve(rows);
+        acc_y.reserve(rows);
+        acc_z.reserve(rows);
+        fix.reserve(rows);
+    }
+};
+
 // 칼만 필터 상태 벡터 [위치, 속도]
 struct KalmanState {
     double position;  // 위치 (displacement)
@@ -30,7 +98,7 @@ struct KalmanCovariance {
 
 // 출력 데이터 구조
 struct OutputData {
-    std::string datetime;
+    RowTimestamp datetime;
     double displacement_y;
     double displacement_z;
 };
@@ -0,0 +1,248 @@
+#include "dual_axis_kalman_filter.h"
+#include "fusion_log.h"
+#include "kalman_lanes.h"
+#include <cmath>
+
+namespace fusion {
+
+namespace {
+
+const int BOTH_LANES = 3;
+
+inline bool converged(double current, double previous, double tolerance) {
+    double scale = std::fabs(previous) > 1e-300 ? std::fabs(previous) : 1e-300;
+    return std::fabs(current - previous) <= tolerance * scale;
+}
+
+} // namespace
+
+DualAxisKalmanFilter::DualAxisKalmanFilter(const KalmanParams& params)
+    : params_(params) {
+    // 초기 상태는 나중에 reset()에서 설정됨
+    reset(0.0, 0.0);
+}
+
+void DualAxisKalmanFilter::reset(double initial_y, double initial_z) {
+    position_[0] = initial_y;
+    position_[1] = initial_z;
+
+    for (int lane = 0; lane < 2; lane++) {
+        velocity_[lane] = 0.0;
+
+        // 초기 공분산 행렬 (단위 행렬)
+        p00_[lane] = 1.0;
+        p01_[lane] = 0.0;
+        p10_[lane] = 0.0;
+        p11_[lane] = 1.0;
+    }
+    pending_covariance_steps_ = 0;
+    clearSteadyState();
+}
+
+KalmanCovariance DualAxisKalmanFilter::laneCovariance(int lane) const {
+    Covariance2 p{load2(p00_), load2(p01_), load2(p10_), load2(p11_)};
+    predict_covariance_steps(p, pending_covariance_steps_, FilterConstants(params_));
+    alignas(16) double terms[4][2];
+    store2(terms[0], p.p00);
+    store2(terms[1], p.p01);
+    store2(terms[2], p.p10);
+    store2(terms[3], p.p11);
+    return KalmanCovariance{terms[0][lane], terms[1][lane], terms[2][lane], terms[3][lane]};
+}
+
+void DualAxisKalmanFilter::setState(const KalmanState& state_y, const KalmanState& state_z) {
+    position_[0] = state_y.position;
+    velocity_[0] = state_y.velocity;
+    position_[1] = state_z.position;
+    velocity_[1] = state_z.velocity;
+}
+
+void DualAxisKalmanFilter::setCovariance(const KalmanCovariance& cov_y, const KalmanCovariance& cov_z) {
+    p00_[0] = cov_y.p00;
+    p01_[0] = cov_y.p01;
+    p10_[0] = cov_y.p10;
+    p11_[0] = cov_y.p11;
+    p00_[1] = cov_z.p00;
+    p01_[1] = cov_z.p01;
+    p10_[1] = cov_z.p10;
+    p11_[1] = cov_z.p11;
+    pending_covariance_steps_ = 0;
+    clearSteadyState();
+}
+
+void DualAxisKalmanFilter::enableSteadyState(bool enable, double tolerance) {
+    steady_enabled_ = enable;
+    steady_tolerance_ = tolerance;
+    clearSteadyState();
+}
+
+void DualAxisKalmanFilter::clearSteadyState() {
+    steady_ = false;
+    has_previous_update_ = false;
+    steps_since_update_ = 0;
+    previous_gap_ = 0;
+    steady_gap_ = 0;
+}
+
+bool DualAxisKalmanFilter::processBatch(
+    Span<const double> gps_y,
+    Span<const double> gps_z,
+    Span<const double> acc_y,
+    Span<const double> acc_z,
+    Span<const int> fix_data,
+    Span<double> displacement_y,
+    Span<double> displacement_z,
+    bool hold_first) {
+
+    size_t n = fix_data.size();
+    if (gps_y.size() != n || gps_z.size() != n || acc_y.size() != n || acc_z.size() != n ||
+        displacement_y.size() != n || displacement_z.size() != n) {
+        LogLine(LogLevel::Error) << "GPS, ACC, and Fix data size mismatch";
+        return false;
+    }
+
+    if (n == 0) {
+        return true;
+    }
+
+    size_t start = 0;
+    if (hold_first) {
+        // 첫 번째 데이터는 현재 상태 사용 (초기화 없음)
+        displacement_y[0] = position_[0];
+        displacement_z[0] = position_[1];
+        start = 1;
+    }
+
+    const FilterConstants c(params_);
+    Vec2 pos = load2(position_);
+    Vec2 vel = load2(velocity_);
+    Covariance2 p{load2(p00_), load2(p01_), load2(p10_), load2(p11_)};
+    Vec2 k0 = load2(steady_k0_);
+    Vec2 k1 = load2(steady_k1_);
+    size_t updates = 0;
+
+    size_t deferred = pending_covariance_steps_;
+
+    if (!steady_enabled_) {
+        // 전체 필터: 상태는 매 샘플, 공분산은 GPS 업데이트 직전에 미룬 예측을 한 번에 적용
+        for (size_t i = start; i < n; i++) {
+            predict_state(pos, vel, make2(acc_y[i], acc_z[i]), c);
+            deferred++;
+
+            // 업데이트 단계: Fix >= 1이고 해당 축 GPS 값이 유한한 레인에만 적용
+            if (fix_data[i] >= 1) {
+                Vec2 gps = make2(gps_y[i], gps_z[i]);
+                Mask2 valid = finite2(gps);
+                if (bits2(valid) != 0) {
+                    predict_covariance_steps(p, deferred, c);
+                    deferred = 0;
+                    update_full(pos, vel, p, gps, valid, c, k0, k1);
+                    updates++;
+                }
+            }
+
+            displacement_y[i] = lane0(pos);
+            displacement_z[i] = lane1(pos);
+        }
+    } else {
+        // 정상 상태 모드는 매 샘플 공분산을 갱신하므로 미룬 예측을 먼저 적용
+        predict_covariance_steps(p, deferred, c);
+        deferred = 0;
+
+        // 정상 상태 모드: 공분산이 수렴하면 캐시된 게인으로 상태 재귀만 수행
+        Covariance2 steady_p{load2(steady_p00_), load2(steady_p01_), load2(steady_p10_), load2(steady_p11_)};
+
+        for (size_t i = start; i < n; i++) {
+            steps_since_update_++;
+            if (steady_) {
+                predict_state_reassociated(pos, vel, make2(acc_y[i], acc_z[i]), c);
+            } else {
+                predict_state(pos, vel, make2(acc_y[i], acc_z[i]), c);
+                predict_covariance(p, c);
+            }
+
+            if (fix_data[i] >= 1) {
+                Vec2 gps = make2(gps_y[i], gps_z[i]);
+                Mask2 valid = finite2(gps);
+                int valid_bits = bits2(valid);
+
+                if (steady_ && valid_bits == BOTH_LANES && steps_since_update_ == steady_gap_) {
+                    update_cached(pos, vel, gps, k0, k1);
+                    steps_since_update_ = 0;
+                    updates++;
+                } else if (valid_bits != 0) {
+                    updates++;
+                    if (steady_) {
+                        // 주기가 어긋남: 고정점에서 공분산을 복원한 뒤 전체 필터로 복귀
+                        p = steady_p;
+                        predict_covariance_steps(p, steps_since_update_, c);
+                        steady_ = false;
+                        has_previous_update_ = false;
+                    }
+
+                    update_full(pos, vel, p, gps, valid, c, k0, k1);
+
+                    if (valid_bits == BOTH_LANES) {
+                        // 같은 간격의 연속된 업데이트 후 공분산이 변하지 않으면 수렴으로 판단
+                        alignas(16) double now[4][2];
+                        store2(now[0], p.p00);
+                        store2(now[1], p.p01);
+                        store2(now[2], p.p10);
+                        store2(now[3], p.p11);
+                        bool is_converged = has_previous_update_ && steps_since_update_ == previous_gap_;
+                        for (int term = 0; term < 4 && is_converged; term++) {
+                            for (int lane = 0; lane < 2 && is_converged; lane++) {
+                                is_converged = converged(now[term][lane], previous_update_[term][lane],
+                                                         steady_tolerance_);
+                            }
+                        }
+                        for (int term = 0; term < 4; term++) {
+                            previous_update_[term][0] = now[term][0];
+                            previous_update_[term][1] = now[term][1];
+                        }
+                        previous_gap_ = steps_since_update_;
+                        has_previous_update_ = true;
+
+                        if (is_converged) {
+                            steady_ = true;
+                            steady_gap_ = steps_since_update_;
+                            steady_p = p;
+                        }
+                    } else {
+                        has_previous_update_ = false;
+                    }
+                    steps_since_update_ = 0;
+                }
+            }
+
+            displacement_y[i] = lane0(pos);
+            displacement_z[i] = lane1(pos);
+        }
+
+        if (steady_) {
+            // 공분산 조회/스냅샷을 위해 현재 시점의 공분산을 고정점에서 복원
+            p = steady_p;
+            predict_covariance_steps(p, steps_since_update_, c);
+        }
+        store2(steady_p00_, steady_p.p00);
+        store2(steady_p01_, steady_p.p01);
+        store2(steady_p10_, steady_p.p10);
+        store2(steady_p11_, steady_p.p11);
+    }
+
+    store2(position_, pos);
+    store2(velocity_, vel);
+    store2(p00_, p.p00);
+    store2(p01_, p.p01);
+    store2(p10_, p.p10);
+    store2(p11_, p.p11);
+    pending_covariance_steps_ = deferred;
+    store2(steady_k0_, k0);
+    store2(steady_k1_, k1);
+    update_steps_ += updates;
+    predict_only_steps_ += (n - start) - updates;
+
+    return true;
+}
+
+} // namespace fusion
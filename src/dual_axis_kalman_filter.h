@@ -0,0 +1,142 @@
+#ifndef DUAL_AXIS_KALMAN_FILTER_H
+#define DUAL_AXIS_KALMAN_FILTER_H
+
+#include "data_structures.h"
+
+namespace fusion {
+
+/**
+ * Y/Z 두 축을 한 루프에서 함께 처리하는 칼만 필터
+ *
+ * 두 축은 dt, Q, R, Fix를 공유하므로 예측/업데이트 연산을 SIMD 레인(레인 0 = Y, 레인 1 = Z)에
+ * 그대로 대응시킨다. 연산 순서는 KalmanFilter::predict/update와 같아서
+ * 축별 KalmanFilter 두 개로 처리한 결과와 비트 단위로 동일하다.
+ * SSE2를 사용할 수 없는 환경에서는 같은 연산을 스칼라 코드로 수행한다.
+ *
+ * 공분산은 GPS 업데이트 직전에만 필요하므로 예측만 하는 구간은 상태만 샘플마다 갱신하고,
+ * 공분산은 업데이트 직전에 구간 길이만큼 닫힌 형식으로 한 번에 예측한다 (처리 호출 경계를 넘어서도 유지).
+ * 단계별 예측과는 반올림 오차 수준에서 다르며, 매 샘플 GPS가 있으면 비트 단위로 같다.
+ */
+class DualAxisKalmanFilter {
+public:
+    explicit DualAxisKalmanFilter(const KalmanParams& params);
+
+    /**
+     * 필터 상태 초기화
+     */
+    void reset(double initial_y, double initial_z);
+
+    KalmanState getStateY() const { return KalmanState{position_[0], velocity_[0]}; }
+    KalmanState getStateZ() const { return KalmanState{position_[1], velocity_[1]}; }
+    KalmanCovariance getCovarianceY() const { return laneCovariance(0); }
+    KalmanCovariance getCovarianceZ() const { return laneCovariance(1); }
+
+    const KalmanParams& getParams() const { return params_; }
+
+    /**
+     * 상태/공분산 설정하기
+     */
+    void setState(const KalmanState& state_y, const KalmanState& state_z);
+    void setCovariance(const KalmanCovariance& cov_y, const KalmanCovariance& cov_z);
+
+    /**
+     * 정상 상태(steady-state) 게인 모드 설정 (기본값: 사용 안함)
+     *
+     * Q, R, dt가 고정이고 GPS 업데이트 간격이 일정하면 공분산 재귀는 곧 고정점에 수렴한다.
+     * 같은 간격의 연속된 두 업데이트 직후 공분산 네 항의 상대 변화가 모두 tolerance 이하가 되면
+     * 그 시점의 게인을 캐시하고, 이후에는 공분산 계산 없이 상태 재귀만 수행한다.
+     * 업데이트 간격이 달라지거나 한 축만 유효한 업데이트가 오면 고정점에서 공분산을 복원해
+     * 전체 필터로 돌아간 뒤 다시 수렴을 기다린다.
+     *
+     * @param enable 사용 여부
+     * @param tolerance 수렴 판정 상대 허용 오차
+     */
+    void enableSteadyState(bool enable, double tolerance = 1e-12);
+
+    /**
+     * 현재 캐시된 정상 상태 게인으로 동작 중인지 여부
+     */
+    bool isSteadyState() const { return steady_; }
+
+    /**
+     * 지금까지 처리한 샘플 중 GPS 업데이트를 적용한 샘플 수 (한 축이라도 적용되면 포함)
+     */
+    size_t getUpdateSteps() const { return update_steps_; }
+
+    /**
+     * 지금까지 처리한 샘플 중 예측만 수행한 샘플 수
+     */
+    size_t getPredictOnlySteps() const { return predict_only_steps_; }
+
+    /**
+     * 다른 인스턴스가 이 필터 대신 처리한 단계 수를 통계에 더함 (시간 축 병렬 처리의 구간 필터)
+     */
+    void addStepCounts(size_t updates, size_t predict_only) {
+        update_steps_ += updates;
+        predict_only_steps_ += predict_only;
+    }
+
+    /**
+     * 두 축을 함께 배치 처리 (KalmanFilter::processBatch와 같은 규칙)
+     *
+     * @param gps_y Y축 GNSS 측정값
+     * @param gps_z Z축 GNSS 측정값
+     * @param acc_y Y축 가속도
+     * @param acc_z Z축 가속도
+     * @param fix_data Fix 값 (Fix >= 1일 때만 GPS 유효)
+     * @param displacement_y Y축 변위 출력 버퍼 (입력과 같은 크기)
+     * @param displacement_z Z축 변위 출력 버퍼 (입력과 같은 크기)
+     * @param hold_first true면 첫 샘플은 현재 상태를 그대로 출력, false면 첫 샘플부터 예측/업데이트
+     * @return 입력/출력 크기가 맞지 않으면 false
+     */
+    bool processBatch(
+        Span<const double> gps_y,
+        Span<const double> gps_z,
+        Span<const double> acc_y,
+        Span<const double> acc_z,
+        Span<const int> fix_data,
+        Span<double> displacement_y,
+        Span<double> displacement_z,
+        bool hold_first
+    );
+
+private:
+    void clearSteadyState();
+    // 미룬 공분산 예측을 적용한 현재 공분산
+    KalmanCovariance laneCovariance(int lane) const;
+
+    KalmanParams params_;
+
+    // 레인 0 = Y축, 레인 1 = Z축
+    alignas(16) double position_[2];
+    alignas(16) double velocity_[2];
+    alignas(16) double p00_[2];
+    alignas(16) double p01_[2];
+    alignas(16) double p10_[2];
+    alignas(16) double p11_[2];
+    size_t pending_covariance_steps_ = 0;   // p00_~p11_에 아직 적용하지 않은 공분산 예측 횟수
+
+    // 처리 통계 (reset으로 초기화하지 않음)
+    size_t update_steps_ = 0;
+    size_t predict_only_steps_ = 0;
+
+    // 정상 상태 모드
+    bool steady_enabled_ = false;
+    double steady_tolerance_ = 1e-12;
+    bool steady_ = false;
+    size_t steady_gap_ = 0;             // 수렴 시점의 업데이트 간격 (샘플 수)
+    size_t steps_since_update_ = 0;     // 마지막 업데이트 이후 예측 횟수
+    size_t previous_gap_ = 0;
+    bool has_previous_update_ = false;
+    double previous_update_[4][2] = {}; // 직전 업데이트 직후 공분산 (p00, p01, p10, p11)
+    alignas(16) double steady_k0_[2] = {};
+    alignas(16) double steady_k1_[2] = {};
+    alignas(16) double steady_p00_[2] = {}; // 업데이트 직후 고정점 공분산
+    alignas(16) double steady_p01_[2] = {};
+    alignas(16) double steady_p10_[2] = {};
+    alignas(16) double steady_p11_[2] = {};
+};
+
+} // namespace fusion
+
+#endif // DUAL_AXIS_KALMAN_FILTER_H
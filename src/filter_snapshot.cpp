@@ -0,0 +1,306 @@
+#include "filter_snapshot.h"
+#include "fusion_log.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace fusion {
+
+namespace {
+
+// 바이너리 레코드 레이아웃 (호스트 바이트 순서, 리틀 엔디언 대상)
+//   [0, 4)     매직 "FKSN"
+//   [4, 8)     버전 (uint32)
+//   [8, 12)    페이로드 크기 (uint32, 바이트)
+//   [12, 16)   예약 (0)
+//   [16, 112)  double 12개 (Y 상태, Y 공분산, Z 상태, Z 공분산)
+//   [112, 120) 입력 바이트 오프셋 (uint64)
+//   [120, 128) 처리한 행 수 (uint64)
+//   [128, 132) 입력 파일 지문 (uint32)
+//   [132, 136) 플래그 (bit 0: 입력 위치 기록됨)
+//   [136, 144) 입력 파일 크기 (uint64)
+//   [144, 152) 입력 파일 수정 시각 (int64)
+//   [152, 156) CRC-32 (레코드 처음부터 페이로드 끝까지)
+const char SNAPSHOT_MAGIC[4] = {'F', 'K', 'S', 'N'};
+const uint32_t SNAPSHOT_VERSION = 1;
+const size_t SNAPSHOT_HEADER_SIZE = 16;
+const size_t SNAPSHOT_VALUE_COUNT = 12;
+const size_t SNAPSHOT_VALUES_SIZE = SNAPSHOT_VALUE_COUNT * sizeof(double);
+const size_t SNAPSHOT_PAYLOAD_SIZE = SNAPSHOT_VALUES_SIZE + 40;
+const uint32_t SNAPSHOT_FLAG_INPUT_POSITION = 1;
+
+// 입력 파일 지문 계산 범위
+const size_t FINGERPRINT_SIZE = 4096;
+
+// 텍스트 형식 키 (값 순서는 바이너리 페이로드와 같음)
+const char* const SNAPSHOT_KEYS[SNAPSHOT_VALUE_COUNT] = {
+    "state_y_position", "state_y_velocity",
+    "cov_y_p00", "cov_y_p01", "cov_y_p10", "cov_y_p11",
+    "state_z_position", "state_z_velocity",
+    "cov_z_p00", "cov_z_p01", "cov_z_p10", "cov_z_p11"
+};
+
+uint32_t crc32(const unsigned char* data, size_t size) {
+    static uint32_t table[256];
+    static bool table_ready = [] {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+        return true;
+    }();
+    (void)table_ready;
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+void to_values(const FilterSnapshot& snapshot, double* values) {
+    values[0] = snapshot.state_y.position;
+    values[1] = snapshot.state_y.velocity;
+    values[2] = snapshot.cov_y.p00;
+    values[3] = snapshot.cov_y.p01;
+    values[4] = snapshot.cov_y.p10;
+    values[5] = snapshot.cov_y.p11;
+    values[6] = snapshot.state_z.position;
+    values[7] = snapshot.state_z.velocity;
+    values[8] = snapshot.cov_z.p00;
+    values[9] = snapshot.cov_z.p01;
+    values[10] = snapshot.cov_z.p10;
+    values[11] = snapshot.cov_z.p11;
+}
+
+void from_values(const double* values, FilterSnapshot& snapshot) {
+    snapshot.state_y = KalmanState{values[0], values[1]};
+    snapshot.cov_y = KalmanCovariance{values[2], values[3], values[4], values[5]};
+    snapshot.state_z = KalmanState{values[6], values[7]};
+    snapshot.cov_z = KalmanCovariance{values[8], values[9], values[10], values[11]};
+}
+
+std::string encode_binary(const FilterSnapshot& snapshot) {
+    std::string record(SNAPSHOT_HEADER_SIZE + SNAPSHOT_PAYLOAD_SIZE + sizeof(uint32_t), '\0');
+    char* out = &record[0];
+    uint32_t version = SNAPSHOT_VERSION;
+    uint32_t payload_size = static_cast<uint32_t>(SNAPSHOT_PAYLOAD_SIZE);
+    uint32_t flags = snapshot.has_input_position ? SNAPSHOT_FLAG_INPUT_POSITION : 0;
+    double values[SNAPSHOT_VALUE_COUNT];
+    to_values(snapshot, values);
+
+    std::memcpy(out, SNAPSHOT_MAGIC, 4);
+    std::memcpy(out + 4, &version, 4);
+    std::memcpy(out + 8, &payload_size, 4);
+    char* payload = out + SNAPSHOT_HEADER_SIZE;
+    std::memcpy(payload, values, SNAPSHOT_VALUES_SIZE);
+    std::memcpy(payload + SNAPSHOT_VALUES_SIZE, &snapshot.input_offset, 8);
+    std::memcpy(payload + SNAPSHOT_VALUES_SIZE + 8, &snapshot.input_rows, 8);
+    std::memcpy(payload + SNAPSHOT_VALUES_SIZE + 16, &snapshot.input_fingerprint, 4);
+    std::memcpy(payload + SNAPSHOT_VALUES_SIZE + 20, &flags, 4);
+    std::memcpy(payload + SNAPSHOT_VALUES_SIZE + 24, &snapshot.input_size, 8);
+    std::memcpy(payload + SNAPSHOT_VALUES_SIZE + 32, &snapshot.input_modified_time, 8);
+    uint32_t checksum = crc32(reinterpret_cast<const unsigned char*>(out),
+                              SNAPSHOT_HEADER_SIZE + SNAPSHOT_PAYLOAD_SIZE);
+    std::memcpy(payload + SNAPSHOT_PAYLOAD_SIZE, &checksum, 4);
+    return record;
+}
+
+bool decode_binary(const std::string& record, FilterSnapshot& snapshot) {
+    if (record.size() < SNAPSHOT_HEADER_SIZE) {
+        return false;
+    }
+    const char* in = record.data();
+    uint32_t version;
+    uint32_t payload_size;
+    std::memcpy(&version, in + 4, 4);
+    std::memcpy(&payload_size, in + 8, 4);
+    if (version != SNAPSHOT_VERSION || payload_size != SNAPSHOT_PAYLOAD_SIZE ||
+        record.size() != SNAPSHOT_HEADER_SIZE + payload_size + sizeof(uint32_t)) {
+        return false;
+    }
+
+    const char* payload = in + SNAPSHOT_HEADER_SIZE;
+    uint32_t checksum;
+    std::memcpy(&checksum, payload + payload_size, 4);
+    if (crc32(reinterpret_cast<const unsigned char*>(in), SNAPSHOT_HEADER_SIZE + payload_size) != checksum) {
+        return false;
+    }
+
+    double values[SNAPSHOT_VALUE_COUNT];
+    std::memcpy(values, payload, SNAPSHOT_VALUES_SIZE);
+    from_values(values, snapshot);
+    uint32_t flags;
+    std::memcpy(&snapshot.input_offset, payload + SNAPSHOT_VALUES_SIZE, 8);
+    std::memcpy(&snapshot.input_rows, payload + SNAPSHOT_VALUES_SIZE + 8, 8);
+    std::memcpy(&snapshot.input_fingerprint, payload + SNAPSHOT_VALUES_SIZE + 16, 4);
+    std::memcpy(&flags, payload + SNAPSHOT_VALUES_SIZE + 20, 4);
+    std::memcpy(&snapshot.input_size, payload + SNAPSHOT_VALUES_SIZE + 24, 8);
+    std::memcpy(&snapshot.input_modified_time, payload + SNAPSHOT_VALUES_SIZE + 32, 8);
+    snapshot.has_input_position = (flags & SNAPSHOT_FLAG_INPUT_POSITION) != 0;
+    return true;
+}
+
+std::string encode_text(const FilterSnapshot& snapshot) {
+    double values[SNAPSHOT_VALUE_COUNT];
+    to_values(snapshot, values);
+    std::ostringstream text;
+    text << std::setprecision(17);
+    for (size_t i = 0; i < SNAPSHOT_VALUE_COUNT; i++) {
+        text << SNAPSHOT_KEYS[i] << " " << values[i] << "\n";
+    }
+    if (snapshot.has_input_position) {
+        text << "input_offset " << snapshot.input_offset << "\n";
+        text << "input_rows " << snapshot.input_rows << "\n";
+        text << "input_fingerprint " << snapshot.input_fingerprint << "\n";
+        text << "input_size " << snapshot.input_size << "\n";
+        text << "input_modified_time " << snapshot.input_modified_time << "\n";
+    }
+    return text.str();
+}
+
+bool decode_text(const std::string& content, FilterSnapshot& snapshot) {
+    std::istringstream file(content);
+    std::string line;
+    std::unordered_map<std::string, std::string> values;
+    while (std::getline(file, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        std::istringstream iss(line);
+        std::string key;
+        std::string value;
+        if (!(iss >> key >> value)) {
+            continue;
+        }
+        values[key] = value;
+    }
+
+    auto get_value = [&values](const char* key, auto& out) -> bool {
+        auto it = values.find(key);
+        if (it == values.end()) {
+            return false;
+        }
+        std::istringstream iss(it->second);
+        return static_cast<bool>(iss >> out);
+    };
+
+    double ordered[SNAPSHOT_VALUE_COUNT];
+    for (size_t i = 0; i < SNAPSHOT_VALUE_COUNT; i++) {
+        if (!get_value(SNAPSHOT_KEYS[i], ordered[i])) {
+            return false;
+        }
+    }
+    from_values(ordered, snapshot);
+
+    // 입력 진행 위치는 다섯 값이 모두 있을 때만 사용 (기존 텍스트 상태 파일에는 없음)
+    snapshot.has_input_position = get_value("input_offset", snapshot.input_offset) &&
+                                  get_value("input_rows", snapshot.input_rows) &&
+                                  get_value("input_fingerprint", snapshot.input_fingerprint) &&
+                                  get_value("input_size", snapshot.input_size) &&
+                                  get_value("input_modified_time", snapshot.input_modified_time);
+    return true;
+}
+
+// 임시 파일을 대상 경로로 교체 (대상이 있어도 덮어씀)
+// 버퍼에 남은 내용과 OS 캐시를 디스크까지 기록
+// (이름을 바꾼 뒤 전원이 꺼져도 상태 파일이 비거나 잘린 임시 파일로 교체되지 않도록)
+bool flush_to_disk(std::FILE* file) {
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+#ifdef _WIN32
+    return FlushFileBuffers(reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)))) != 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+bool replace_file(const std::string& temp_path, const std::string& file_path) {
+#ifdef _WIN32
+    return MoveFileExA(temp_path.c_str(), file_path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return std::rename(temp_path.c_str(), file_path.c_str()) == 0;
+#endif
+}
+
+// 파일 전체 읽기 (상태 파일은 작으므로 한 번의 read로 끝남)
+bool read_small_file(const std::string& file_path, std::string& content) {
+    std::FILE* file = std::fopen(file_path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    char buffer[4096];
+    content.clear();
+    size_t read_size;
+    while ((read_size = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        content.append(buffer, read_size);
+    }
+    bool ok = !std::ferror(file);
+    std::fclose(file);
+    return ok;
+}
+
+} // namespace
+
+uint32_t input_fingerprint(std::string_view contents, uint64_t consumed) {
+    size_t size = static_cast<size_t>(std::min<uint64_t>(std::min<uint64_t>(consumed, contents.size()),
+                                                         FINGERPRINT_SIZE));
+    return crc32(reinterpret_cast<const unsigned char*>(contents.data()), size);
+}
+
+bool save_filter_snapshot(const std::string& file_path, const FilterSnapshot& snapshot,
+                          SnapshotFormat format, bool durable) {
+    std::string content = format == SnapshotFormat::Binary ? encode_binary(snapshot) : encode_text(snapshot);
+    std::string temp_path = file_path + ".tmp";
+
+    std::FILE* file = std::fopen(temp_path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = std::fwrite(content.data(), 1, content.size(), file) == content.size() &&
+              (!durable || flush_to_disk(file));
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok || !replace_file(temp_path, file_path)) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool load_filter_snapshot(const std::string& file_path, FilterSnapshot& snapshot) {
+    std::string content;
+    if (!read_small_file(file_path, content)) {
+        return false;
+    }
+    if (content.size() >= 4 && std::memcmp(content.data(), SNAPSHOT_MAGIC, 4) == 0) {
+        if (!decode_binary(content, snapshot)) {
+            LogLine(LogLevel::Warning) << "Ignoring corrupted state file: " << file_path;
+            return false;
+        }
+        return true;
+    }
+    return decode_text(content, snapshot);
+}
+
+} // namespace fusion
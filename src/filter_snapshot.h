@@ -0,0 +1,73 @@
+#ifndef FILTER_SNAPSHOT_H
+#define FILTER_SNAPSHOT_H
+
+#include "data_structures.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace fusion {
+
+// 필터 상태 스냅샷 (실시간 모드 상태 파일 / 스트리밍 핸들)
+struct FilterSnapshot {
+    KalmanState state_y;
+    KalmanState state_z;
+    KalmanCovariance cov_y;
+    KalmanCovariance cov_z;
+    
+    // 실시간 모드 입력 진행 위치 (has_input_position이 false면 기록되지 않음)
+    bool has_input_position = false;
+    uint64_t input_offset = 0;        // 마지막으로 처리한 행 다음의 바이트 오프셋
+    uint64_t input_rows = 0;          // 지금까지 처리한 행 수
+    uint32_t input_fingerprint = 0;   // 입력 파일 앞부분의 지문 (같은 파일인지 확인)
+    uint64_t input_size = 0;          // 저장할 때 읽은 입력 파일 크기
+    int64_t input_modified_time = 0;  // 저장할 때 읽은 입력 파일 수정 시각 (MappedFile::modified_time)
+};
+
+// 상태 파일 형식
+enum class SnapshotFormat {
+    Binary,  // 고정 레이아웃 바이너리 레코드 (버전 헤더 + CRC-32)
+    Text     // "key value" 텍스트 12줄 (기존 형식, 사람이 읽기 위한 내보내기용)
+};
+
+/**
+ * 입력 파일 지문 계산 (앞부분 최대 4 KiB의 CRC-32)
+ *
+ * 덧붙이기만 하는 파일은 앞부분이 바뀌지 않으므로, 지문이 같으면 같은 파일로 본다.
+ *
+ * @param contents 입력 파일 내용
+ * @param consumed 이미 처리한 바이트 수 (이 범위 안에서만 지문을 계산)
+ * @return CRC-32 값
+ */
+uint32_t input_fingerprint(std::string_view contents, uint64_t consumed);
+
+/**
+ * 스냅샷을 상태 파일로 저장
+ *
+ * 같은 디렉토리의 임시 파일("<경로>.tmp")에 먼저 쓴 뒤 이름을 바꿔 원자적으로 교체한다.
+ * 쓰는 도중 중단되어도 기존 상태 파일은 손상되지 않는다.
+ *
+ * @param file_path 상태 파일 경로
+ * @param snapshot 저장할 스냅샷
+ * @param format 파일 형식
+ * @param durable true면 이름을 바꾸기 전에 임시 파일을 디스크까지 기록 (fsync / FlushFileBuffers),
+ *                false면 OS 캐시에 맡김 (중간 체크포인트용, 전원이 꺼지면 이전 상태로 돌아갈 수 있음)
+ * @return 성공 시 true, 실패 시 false
+ */
+bool save_filter_snapshot(const std::string& file_path, const FilterSnapshot& snapshot,
+                          SnapshotFormat format = SnapshotFormat::Binary, bool durable = true);
+
+/**
+ * 상태 파일에서 스냅샷 읽기 (바이너리/텍스트 형식 자동 판별)
+ *
+ * 바이너리 형식은 헤더(매직, 버전, 크기)와 체크섬이 모두 맞아야 읽은 것으로 본다.
+ *
+ * @param file_path 상태 파일 경로
+ * @param snapshot 읽은 스냅샷을 저장할 구조체
+ * @return 성공 시 true, 파일이 없거나 손상되었으면 false
+ */
+bool load_filter_snapshot(const std::string& file_path, FilterSnapshot& snapshot);
+
+} // namespace fusion
+
+#endif // FILTER_SNAPSHOT_H
@@ -0,0 +1,195 @@
+#include "fixed_lag_smoother.h"
+#include "fusion_log.h"
+#include "kalman_lanes.h"
+
+namespace fusion {
+
+namespace {
+
+// 평활 게인 C = P(j|j) F^T P(j+1|j)^-1, F = [[1, dt], [0, 1]]
+inline void smoother_gain(const Covariance2& filtered, const Covariance2& predicted,
+                          const FilterConstants& c, Vec2& c00, Vec2& c01, Vec2& c10, Vec2& c11) {
+    Vec2 a00 = filtered.p00 + c.dt * filtered.p01;
+    Vec2 a01 = filtered.p01;
+    Vec2 a10 = filtered.p10 + c.dt * filtered.p11;
+    Vec2 a11 = filtered.p11;
+
+    Vec2 det = predicted.p00 * predicted.p11 - predicted.p01 * predicted.p10;
+    Vec2 inv00 = predicted.p11 / det;
+    Vec2 inv01 = -predicted.p01 / det;
+    Vec2 inv10 = -predicted.p10 / det;
+    Vec2 inv11 = predicted.p00 / det;
+
+    c00 = a00 * inv00 + a01 * inv10;
+    c01 = a00 * inv01 + a01 * inv11;
+    c10 = a10 * inv00 + a11 * inv10;
+    c11 = a10 * inv01 + a11 * inv11;
+}
+
+} // namespace
+
+FixedLagSmoother::FixedLagSmoother(const KalmanParams& params, size_t lag)
+    : params_(params), lag_(lag), ring_(lag + 1) {
+    reset(0.0, 0.0);
+}
+
+void FixedLagSmoother::reset(double initial_y, double initial_z) {
+    position_[0] = initial_y;
+    position_[1] = initial_z;
+
+    for (int lane = 0; lane < 2; lane++) {
+        velocity_[lane] = 0.0;
+
+        // 초기 공분산 행렬 (단위 행렬)
+        p00_[lane] = 1.0;
+        p01_[lane] = 0.0;
+        p10_[lane] = 0.0;
+        p11_[lane] = 1.0;
+    }
+    newest_ = 0;
+    pushed_ = 0;
+    emitted_ = 0;
+}
+
+void FixedLagSmoother::smooth_back(size_t steps, double* out_y, double* out_z, bool keep_all) {
+    const Entry& newest = ring_[newest_];
+    Vec2 pos = load2(newest.position);
+    Vec2 vel = load2(newest.velocity);
+    if (keep_all) {
+        out_y[steps] = lane0(pos);
+        out_z[steps] = lane1(pos);
+    }
+
+    // x(j|n) = x(j|j) + C(j) * (x(j+1|n) - x(j+1|j))
+    for (size_t m = 1; m <= steps; m++) {
+        const Entry& e = entry_before_newest(m);
+        Vec2 dpos = pos - load2(e.next_position);
+        Vec2 dvel = vel - load2(e.next_velocity);
+        pos = load2(e.position) + (load2(e.c00) * dpos + load2(e.c01) * dvel);
+        vel = load2(e.velocity) + (load2(e.c10) * dpos + load2(e.c11) * dvel);
+        if (keep_all) {
+            out_y[steps - m] = lane0(pos);
+            out_z[steps - m] = lane1(pos);
+        }
+    }
+
+    if (!keep_all) {
+        out_y[0] = lane0(pos);
+        out_z[0] = lane1(pos);
+    }
+}
+
+bool FixedLagSmoother::processBatch(
+    Span<const double> gps_y,
+    Span<const double> gps_z,
+    Span<const double> acc_y,
+    Span<const double> acc_z,
+    Span<const int> fix_data,
+    Span<double> displacement_y,
+    Span<double> displacement_z,
+    bool hold_first,
+    size_t& emitted) {
+
+    emitted = 0;
+    size_t n = fix_data.size();
+    if (gps_y.size() != n || gps_z.size() != n || acc_y.size() != n || acc_z.size() != n ||
+        displacement_y.size() != n || displacement_z.size() != n) {
+        LogLine(LogLevel::Error) << "GPS, ACC, and Fix data size mismatch";
+        return false;
+    }
+
+    const FilterConstants c(params_);
+    Vec2 pos = load2(position_);
+    Vec2 vel = load2(velocity_);
+    Covariance2 p{load2(p00_), load2(p01_), load2(p10_), load2(p11_)};
+    size_t updates = 0;
+    size_t held = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        if (i == 0 && hold_first) {
+            // 상태 유지: 직전 샘플과 같은 상태이므로 전이는 항등, 평활 게인은 단위 행렬
+            if (pushed_ > 0) {
+                Entry& previous = ring_[newest_];
+                store2(previous.next_position, pos);
+                store2(previous.next_velocity, vel);
+                store2(previous.c00, c.one);
+                store2(previous.c01, c.zero);
+                store2(previous.c10, c.zero);
+                store2(previous.c11, c.one);
+            }
+            held = 1;
+        } else {
+            Covariance2 filtered = p;
+            predict_state(pos, vel, make2(acc_y[i], acc_z[i]), c);
+            predict_covariance(p, c);
+
+            if (pushed_ > 0) {
+                Entry& previous = ring_[newest_];
+                store2(previous.next_position, pos);
+                store2(previous.next_velocity, vel);
+                Vec2 c00, c01, c10, c11;
+                smoother_gain(filtered, p, c, c00, c01, c10, c11);
+                store2(previous.c00, c00);
+                store2(previous.c01, c01);
+                store2(previous.c10, c10);
+                store2(previous.c11, c11);
+            }
+
+            // 업데이트 단계: Fix >= 1이고 해당 축 GPS 값이 유한한 레인에만 적용
+            if (fix_data[i] >= 1) {
+                Vec2 gps = make2(gps_y[i], gps_z[i]);
+                Mask2 valid = finite2(gps);
+                if (bits2(valid) != 0) {
+                    Vec2 k0, k1;
+                    update_full(pos, vel, p, gps, valid, c, k0, k1);
+                    updates++;
+                }
+            }
+        }
+
+        if (pushed_ > 0) {
+            newest_ = (newest_ + 1) % ring_.size();
+        }
+        Entry& current = ring_[newest_];
+        store2(current.position, pos);
+        store2(current.velocity, vel);
+        pushed_++;
+
+        // 지연이 찬 가장 오래된 샘플을 내보냄 (그 항목은 다음 샘플이 덮어씀)
+        if (pushed_ - emitted_ > lag_) {
+            smooth_back(lag_, &displacement_y[emitted], &displacement_z[emitted], false);
+            emitted++;
+            emitted_++;
+        }
+    }
+
+    store2(position_, pos);
+    store2(velocity_, vel);
+    store2(p00_, p.p00);
+    store2(p01_, p.p01);
+    store2(p10_, p.p10);
+    store2(p11_, p.p11);
+    update_steps_ += updates;
+    predict_only_steps_ += (n - held) - updates;
+
+    return true;
+}
+
+bool FixedLagSmoother::flush(Span<double> displacement_y, Span<double> displacement_z, size_t& emitted) {
+    emitted = 0;
+    size_t count = pending();
+    if (displacement_y.size() < count || displacement_z.size() < count) {
+        LogLine(LogLevel::Error) << "Smoother output buffer too small";
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+
+    smooth_back(count - 1, displacement_y.data(), displacement_z.data(), true);
+    emitted = count;
+    emitted_ = pushed_;
+    return true;
+}
+
+} // namespace fusion
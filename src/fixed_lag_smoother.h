@@ -0,0 +1,132 @@
+#ifndef FIXED_LAG_SMOOTHER_H
+#define FIXED_LAG_SMOOTHER_H
+
+#include "data_structures.h"
+#include <vector>
+
+namespace fusion {
+
+// 고정 지연 평활 최대 지연 (샘플 수, 100 Hz 기준 1000초)
+constexpr size_t MAX_SMOOTHING_LAG = 100000;
+
+/**
+ * Y/Z 두 축 고정 지연(fixed-lag) RTS 평활기
+ *
+ * 샘플 k를 넣으면 k - lag 시점의 변위를 k까지의 측정으로 평활한 값 x(k-lag | k)를 내보낸다.
+ * 전방 필터는 DualAxisKalmanFilter의 전체 필터와 같은 예측/업데이트 규칙을 따르지만, 평활 게인에 매 샘플의
+ * 예측 공분산이 필요하므로 공분산을 샘플마다 갱신한다 (lag = 0이면 반올림 오차 수준에서 같은 출력).
+ *
+ * 최근 lag + 1개 샘플의 필터 상태 x(j|j), 다음 샘플 예측 x(j+1|j), 평활 게인
+ * C(j) = P(j|j) F^T P(j+1|j)^-1 을 생성 시 할당한 링 버퍼에 보관한다.
+ * 게인은 공분산에만 의존하므로 다음 샘플을 예측할 때 한 번만 계산하고, 샘플마다 링 버퍼를
+ * 거꾸로 따라가는 평균 재귀(2x2 행렬-벡터 곱 lag번)로 출력을 만든다.
+ * 메모리는 O(lag), 샘플당 연산은 O(lag)이며 처리 중에는 힙 할당이 없다.
+ */
+class FixedLagSmoother {
+public:
+    /**
+     * @param params 칼만 필터 파라미터
+     * @param lag 지연 샘플 수 (MAX_SMOOTHING_LAG 이하)
+     */
+    FixedLagSmoother(const KalmanParams& params, size_t lag);
+
+    /**
+     * 필터 상태 초기화 (대기 중인 샘플도 버림)
+     */
+    void reset(double initial_y, double initial_z);
+
+    size_t lag() const { return lag_; }
+
+    /**
+     * 아직 평활 값을 내보내지 않은 샘플 수 (최대 lag)
+     */
+    size_t pending() const { return static_cast<size_t>(pushed_ - emitted_); }
+
+    /**
+     * 샘플을 넣고 지연이 끝난 샘플의 평활 변위를 출력 버퍼 앞부분에 기록
+     * (DualAxisKalmanFilter::processBatch와 같은 예측/업데이트 규칙)
+     *
+     * 출력은 입력보다 lag 샘플 늦으므로 이번 호출의 출력은 이전 호출에서 넣은 샘플부터 시작한다.
+     *
+     * @param displacement_y Y축 평활 변위 출력 버퍼 (입력과 같은 크기)
+     * @param displacement_z Z축 평활 변위 출력 버퍼 (입력과 같은 크기)
+     * @param hold_first true면 첫 샘플은 현재 상태를 그대로 유지 (예측/업데이트 없음)
+     * @param emitted 출력 버퍼에 기록한 샘플 수
+     * @return 입력/출력 크기가 맞지 않으면 false
+     */
+    bool processBatch(
+        Span<const double> gps_y,
+        Span<const double> gps_z,
+        Span<const double> acc_y,
+        Span<const double> acc_z,
+        Span<const int> fix_data,
+        Span<double> displacement_y,
+        Span<double> displacement_z,
+        bool hold_first,
+        size_t& emitted
+    );
+
+    /**
+     * 대기 중인 샘플을 마지막 샘플까지의 측정으로 평활해 모두 내보냄 (입력 끝에서 호출)
+     *
+     * @param displacement_y Y축 평활 변위 출력 버퍼 (pending() 이상)
+     * @param displacement_z Z축 평활 변위 출력 버퍼 (pending() 이상)
+     * @param emitted 출력 버퍼에 기록한 샘플 수
+     * @return 출력 버퍼가 작으면 false
+     */
+    bool flush(Span<double> displacement_y, Span<double> displacement_z, size_t& emitted);
+
+    /**
+     * 지금까지 처리한 샘플 중 GPS 업데이트를 적용한 샘플 수
+     */
+    size_t getUpdateSteps() const { return update_steps_; }
+
+    /**
+     * 지금까지 처리한 샘플 중 예측만 수행한 샘플 수
+     */
+    size_t getPredictOnlySteps() const { return predict_only_steps_; }
+
+private:
+    // 링 버퍼 항목 (레인 0 = Y축, 레인 1 = Z축)
+    struct Entry {
+        alignas(16) double position[2];       // x(j|j)
+        alignas(16) double velocity[2];
+        alignas(16) double next_position[2];  // x(j+1|j)
+        alignas(16) double next_velocity[2];
+        alignas(16) double c00[2];            // C(j)
+        alignas(16) double c01[2];
+        alignas(16) double c10[2];
+        alignas(16) double c11[2];
+    };
+
+    // 최신 항목에서 steps칸 앞의 항목
+    Entry& entry_before_newest(size_t steps) {
+        size_t capacity = ring_.size();
+        return ring_[(newest_ + capacity - steps) % capacity];
+    }
+
+    // 최신 항목에서 steps칸 앞까지 거꾸로 평활
+    // keep_all이면 지나는 위치를 out[steps - m]에 모두 기록, 아니면 steps칸 앞의 위치만 out[0]에 기록
+    void smooth_back(size_t steps, double* out_y, double* out_z, bool keep_all);
+
+    KalmanParams params_;
+    size_t lag_;
+    std::vector<Entry> ring_;
+    size_t newest_ = 0;
+    uint64_t pushed_ = 0;
+    uint64_t emitted_ = 0;
+
+    alignas(16) double position_[2];
+    alignas(16) double velocity_[2];
+    alignas(16) double p00_[2];
+    alignas(16) double p01_[2];
+    alignas(16) double p10_[2];
+    alignas(16) double p11_[2];
+
+    size_t update_steps_ = 0;
+    size_t predict_only_steps_ = 0;
+};
+
+} // namespace fusion
+
+#endif // FIXED_LAG_SMOOTHER_H
@@ -1,15 +1,33 @@
+#define FUSION_DLL_EXPORTS
 #include "fusion_api.h"
 #include "csv_parser.h"
 #include "kalman_filter.h"
+#include "dual_axis_kalman_filter.h"
+#include "fixed_lag_smoother.h"
+#include "parallel_kalman_filter.h"
+#include "thread_pool.h"
+#include "param_sweep.h"
+#include "filter_snapshot.h"
+#include "run_stats.h"
+#include "fusion_log.h"
+#include "batch_writer.h"
+#include "output_writer.h"
+#include "columnar_input.h"
 #include "data_structures.h"
 #include <vector>
 #include <string>
-#include <iostream>
 #include <fstream>
 #include <cmath>
 #include <sstream>
 #include <iomanip>
 #include <unordered_map>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <type_traits>
 
 // filesystem 헤더 호환성 처리
 #if __cplusplus >= 201703L && defined(__has_include)
@@ -56,18 +74,14 @@
     }
 #endif
 
-#define FUSION_DLL_EXPORTS
 
 namespace fusion {
 
-struct FilterSnapshot {
-    KalmanState state_y;
-    KalmanState state_z;
-    KalmanCovariance cov_y;
-    KalmanCovariance cov_z;
-};
-
-static std::string build_state_file_path(const std::string& output_file_path) {
+// 실시간 모드 상태 파일 경로
+// per_output이 false면 출력 디렉토리 공용 파일(local_var_laststate.txt, 기존 동작),
+// true면 출력 파일마다 별도 파일(<출력 파일 이름>_laststate.txt, 확장자 포함)을 사용
+// 이름은 기존 경로와의 호환을 위해 .txt를 유지하지만 내용은 fusion_set_snapshot_format의 형식 (기본값 바이너리)
+static std::string build_state_file_path(const std::string& output_file_path, bool per_output = false) {
     fs::path output_path(output_file_path);
     std::string output_dir = output_path.parent_path().string();
     if (output_dir.empty()) {
@@ -77,148 +91,616 @@ static std::string build_state_file_path(const std::string& output_file_path) {
     if (last_char != '/' && last_char != '\\') {
         output_dir += "/";
     }
+    if (per_output) {
+        // 확장자까지 포함해야 out.csv와 out.fcol이 같은 상태 파일을 쓰지 않음
+        return output_dir + output_path.filename().string() + "_laststate.txt";
+    }
     return output_dir + "local_var_laststate.txt";
 }
 
-static FilterSnapshot capture_snapshot(const KalmanFilter& filter_y, const KalmanFilter& filter_z) {
+// 같은 상태 파일을 사용하는 실시간 처리가 동시에 실행되지 않도록 경로별 잠금을 제공
+static std::shared_ptr<std::mutex> get_state_file_mutex(const std::string& state_file_path) {
+    static std::mutex registry_mutex;
+    static std::unordered_map<std::string, std::shared_ptr<std::mutex>> registry;
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::shared_ptr<std::mutex>& entry = registry[state_file_path];
+    if (!entry) {
+        entry = std::make_shared<std::mutex>();
+    }
+    return entry;
+}
+
+static FilterSnapshot capture_snapshot(const DualAxisKalmanFilter& filter) {
     FilterSnapshot snapshot;
-    snapshot.state_y = filter_y.getState();
-    snapshot.state_z = filter_z.getState();
-    snapshot.cov_y = filter_y.getCovariance();
-    snapshot.cov_z = filter_z.getCovariance();
+    snapshot.state_y = filter.getStateY();
+    snapshot.state_z = filter.getStateZ();
+    snapshot.cov_y = filter.getCovarianceY();
+    snapshot.cov_z = filter.getCovarianceZ();
     return snapshot;
 }
 
-static bool save_filter_snapshot(const std::string& file_path, const FilterSnapshot& snapshot) {
-    std::ofstream file(file_path);
-    if (!file.is_open()) {
+
+// 출력 CSV 변위 값 자릿수 (fusion_set_output_precision으로 설정)
+static std::atomic<int> g_output_precision(DEFAULT_OUTPUT_PRECISION);
+
+// 정상 상태 게인 모드 (fusion_set_steady_state로 설정)
+static const double DEFAULT_STEADY_STATE_TOLERANCE = 1e-12;
+static std::atomic<bool> g_steady_state_enabled(false);
+static std::atomic<double> g_steady_state_tolerance(DEFAULT_STEADY_STATE_TOLERANCE);
+
+// 고정 지연 평활 (0 = 사용 안함)
+static std::atomic<size_t> g_smoothing_lag(0);
+
+// 시간 축 병렬 필터 (fusion_set_parallel_filter)
+static std::atomic<bool> g_parallel_filter_enabled(false);
+static std::atomic<size_t> g_parallel_filter_threads(0);
+
+// 웜업 겹침 청크 병렬 처리 (fusion_set_chunked_filter, 청크 수 2 미만 = 사용 안함)
+static std::atomic<size_t> g_chunked_filter_chunks(0);
+static std::atomic<size_t> g_chunked_filter_overlap(0);
+
+// 상태 파일 형식과 실시간 모드 체크포인트 간격
+// (fusion_set_snapshot_format / fusion_set_checkpoint_interval로 설정)
+static const size_t DEFAULT_CHECKPOINT_ROWS = 100;
+static std::atomic<int> g_snapshot_format(FUSION_SNAPSHOT_BINARY);
+static std::atomic<size_t> g_checkpoint_rows(DEFAULT_CHECKPOINT_ROWS);
+static std::atomic<double> g_checkpoint_seconds(0.0);
+
+// 현재 설정된 형식으로 필터 상태 저장 (durable: save_filter_snapshot 참고)
+static bool write_snapshot(const std::string& state_file_path, const FilterSnapshot& snapshot,
+                           bool durable = true) {
+    RunStats& stats = run_stats();
+    StageTimer timer(stats.snapshot_ns);
+    SnapshotFormat format = g_snapshot_format.load() == FUSION_SNAPSHOT_TEXT
+        ? SnapshotFormat::Text : SnapshotFormat::Binary;
+    if (!save_filter_snapshot(state_file_path, snapshot, format, durable)) {
         return false;
     }
-    file << std::setprecision(17);
-    file << "state_y_position " << snapshot.state_y.position << "\n";
-    file << "state_y_velocity " << snapshot.state_y.velocity << "\n";
-    file << "cov_y_p00 " << snapshot.cov_y.p00 << "\n";
-    file << "cov_y_p01 " << snapshot.cov_y.p01 << "\n";
-    file << "cov_y_p10 " << snapshot.cov_y.p10 << "\n";
-    file << "cov_y_p11 " << snapshot.cov_y.p11 << "\n";
-    file << "state_z_position " << snapshot.state_z.position << "\n";
-    file << "state_z_velocity " << snapshot.state_z.velocity << "\n";
-    file << "cov_z_p00 " << snapshot.cov_z.p00 << "\n";
-    file << "cov_z_p01 " << snapshot.cov_z.p01 << "\n";
-    file << "cov_z_p10 " << snapshot.cov_z.p10 << "\n";
-    file << "cov_z_p11 " << snapshot.cov_z.p11 << "\n";
+    stats.snapshot_writes++;
     return true;
 }
 
-static bool load_filter_snapshot(const std::string& file_path, FilterSnapshot& snapshot) {
-    std::ifstream file(file_path);
-    if (!file.is_open()) {
+static bool file_exists(const std::string& file_path) {
+    std::FILE* file = std::fopen(file_path.c_str(), "rb");
+    if (!file) {
         return false;
     }
-    std::string line;
-    std::unordered_map<std::string, double> values;
-    while (std::getline(file, line)) {
-        if (line.empty()) {
-            continue;
+    std::fclose(file);
+    return true;
+}
+
+// 실시간 모드 체크포인트 시점 판단 (행 수 또는 경과 시간 기준, 0이면 해당 기준 사용 안함)
+class CheckpointSchedule {
+public:
+    CheckpointSchedule()
+        : interval_rows_(g_checkpoint_rows.load()),
+          interval_seconds_(g_checkpoint_seconds.load()),
+          pending_rows_(0),
+          last_checkpoint_(std::chrono::steady_clock::now()) {}
+    
+    // rows행을 처리한 뒤 호출, 저장할 시점이면 true를 반환하고 카운터를 초기화
+    bool advance(size_t rows) {
+        pending_rows_ += rows;
+        bool due = interval_rows_ > 0 && pending_rows_ >= interval_rows_;
+        if (!due && interval_seconds_ > 0.0) {
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - last_checkpoint_;
+            due = elapsed.count() >= interval_seconds_;
+        }
+        if (due) {
+            pending_rows_ = 0;
+            last_checkpoint_ = std::chrono::steady_clock::now();
+        }
+        return due;
+    }
+    
+private:
+    size_t interval_rows_;
+    double interval_seconds_;
+    size_t pending_rows_;
+    std::chrono::steady_clock::time_point last_checkpoint_;
+};
+
+// 전역 설정에 따라 필터 생성
+static DualAxisKalmanFilter make_filter(const KalmanParams& params) {
+    DualAxisKalmanFilter filter(params);
+    if (g_steady_state_enabled.load()) {
+        filter.enableSteadyState(true, g_steady_state_tolerance.load());
+    }
+    return filter;
+}
+
+// 필터 처리 시간과 GPS 업데이트/예측 전용 단계 수를 현재 스레드 통계에 기록
+// (DualAxisKalmanFilter, FixedLagSmoother)
+template <typename Filter>
+class FilterStageRecorder {
+public:
+    explicit FilterStageRecorder(const Filter& filter)
+        : filter_(filter),
+          updates_(filter.getUpdateSteps()),
+          predict_only_(filter.getPredictOnlySteps()),
+          timer_(run_stats().filter_ns) {}
+    
+    ~FilterStageRecorder() {
+        RunStats& stats = run_stats();
+        stats.gps_updates += filter_.getUpdateSteps() - updates_;
+        stats.predict_only_steps += filter_.getPredictOnlySteps() - predict_only_;
+    }
+    
+private:
+    const Filter& filter_;
+    size_t updates_;
+    size_t predict_only_;
+    StageTimer timer_;
+};
+
+// 스트리밍 처리 시 한 번에 읽는 행 수
+static const size_t STREAM_CHUNK_ROWS = 4096;
+
+// 시간 축 병렬 필터 사용 시 한 번에 읽는 행 수 (구간을 워커 수만큼 나눌 수 있도록 크게 읽음)
+static const size_t PARALLEL_CHUNK_ROWS = 1 << 21;
+
+// 전역 설정에 따라 시간 축 병렬 필터용 스레드 풀 생성 (사용하지 않으면 nullptr)
+static std::unique_ptr<ThreadPool> make_parallel_pool() {
+    if (!g_parallel_filter_enabled.load()) {
+        return nullptr;
+    }
+    size_t threads = g_parallel_filter_threads.load();
+    if (threads == 0) {
+        threads = ThreadPool::default_thread_count();
+    }
+    if (threads < 2) {
+        return nullptr;
+    }
+    return std::unique_ptr<ThreadPool>(new ThreadPool(threads));
+}
+
+// 청크 병렬 처리용 스레드 풀 (청크 수만큼, 단 하드웨어 스레드 수 이하)
+// 결과는 청크 수와 웜업 길이로만 정해지므로 코어가 하나여도 같은 방식으로 처리
+static std::unique_ptr<ThreadPool> make_chunked_pool(size_t chunks) {
+    if (chunks < 2) {
+        return nullptr;
+    }
+    return std::unique_ptr<ThreadPool>(new ThreadPool(std::min(chunks, ThreadPool::default_thread_count())));
+}
+
+// 청크 단위 처리용 버퍼 (청크 간 재사용하여 할당을 반복하지 않음)
+struct ChunkBuffers {
+    SampleBlock samples;
+    std::vector<double> displacement_y;
+    std::vector<double> displacement_z;
+    
+    // Y/Z 두 축을 한 루프로 처리 (샘플 컬럼을 그대로 Span으로 전달)
+    void filter(DualAxisKalmanFilter& filter, bool hold_first) {
+        size_t n = samples.size();
+        displacement_y.resize(n);
+        displacement_z.resize(n);
+        FilterStageRecorder recorder(filter);
+        filter.processBatch(samples.gps_y, samples.gps_z, samples.acc_y, samples.acc_z, samples.fix,
+                            displacement_y, displacement_z, hold_first);
+    }
+    
+    // 시간 축 병렬 필터 (청크가 짧으면 내부에서 순차 처리)
+    void filter(DualAxisKalmanFilter& filter, ThreadPool& pool, bool hold_first) {
+        size_t n = samples.size();
+        displacement_y.resize(n);
+        displacement_z.resize(n);
+        FilterStageRecorder recorder(filter);
+        process_parallel_in_time(filter, pool, samples.gps_y, samples.gps_z, samples.acc_y, samples.acc_z,
+                                 samples.fix, displacement_y, displacement_z, hold_first);
+    }
+    
+    // 웜업 겹침 청크 병렬 처리 (근사)
+    void filter(DualAxisKalmanFilter& filter, ThreadPool& pool, size_t chunks, size_t overlap, bool hold_first) {
+        size_t n = samples.size();
+        displacement_y.resize(n);
+        displacement_z.resize(n);
+        FilterStageRecorder recorder(filter);
+        process_chunked_overlap(filter, pool, chunks, overlap, samples.gps_y, samples.gps_z, samples.acc_y,
+                                samples.acc_z, samples.fix, displacement_y, displacement_z, hold_first);
+    }
+    
+    // 고정 지연 평활: 변위가 나온 샘플(입력보다 lag 샘플 늦음)의 시각을 samples.datetime으로 옮기므로
+    // 이후 write()와 배치 출력은 평활하지 않을 때와 같이 사용
+    void filter(FixedLagSmoother& smoother, bool hold_first) {
+        size_t n = samples.size();
+        displacement_y.resize(n);
+        displacement_z.resize(n);
+        size_t emitted = 0;
+        {
+            FilterStageRecorder recorder(smoother);
+            smoother.processBatch(samples.gps_y, samples.gps_z, samples.acc_y, samples.acc_z, samples.fix,
+                                  displacement_y, displacement_z, hold_first, emitted);
         }
-        std::istringstream iss(line);
-        std::string key;
-        double value;
-        if (!(iss >> key >> value)) {
-            continue;
+        displacement_y.resize(emitted);
+        displacement_z.resize(emitted);
+        
+        // 대기 중이던 샘플 + 이번 청크 순서에서 앞의 emitted개는 출력, 나머지는 다음 청크로 넘김
+        emitted_datetime.clear();
+        carry_datetime.clear();
+        size_t waiting = pending_datetime.size();
+        for (size_t i = 0; i < waiting + n; i++) {
+            TimestampColumn& target = i < emitted ? emitted_datetime : carry_datetime;
+            if (i < waiting) {
+                target.push_back(pending_datetime, i);
+            } else {
+                target.push_back(samples.datetime, i - waiting);
+            }
         }
-        values[key] = value;
+        std::swap(samples.datetime, emitted_datetime);
+        std::swap(pending_datetime, carry_datetime);
     }
-    auto get_value = [&](const std::string& key, double& out) -> bool {
-        auto it = values.find(key);
-        if (it == values.end()) {
-            return false;
+    
+    // 입력 끝: 대기 중인 샘플을 평활해 현재 출력 뒤에 이어 붙임
+    void flush(FixedLagSmoother& smoother) {
+        size_t offset = samples.datetime.size();
+        size_t count = smoother.pending();
+        displacement_y.resize(offset + count);
+        displacement_z.resize(offset + count);
+        size_t emitted = 0;
+        smoother.flush(Span<double>(displacement_y.data() + offset, count),
+                       Span<double>(displacement_z.data() + offset, count), emitted);
+        for (size_t i = 0; i < pending_datetime.size(); i++) {
+            samples.datetime.push_back(pending_datetime, i);
         }
-        out = it->second;
-        return true;
-    };
-    return get_value("state_y_position", snapshot.state_y.position) &&
-           get_value("state_y_velocity", snapshot.state_y.velocity) &&
-           get_value("cov_y_p00", snapshot.cov_y.p00) &&
-           get_value("cov_y_p01", snapshot.cov_y.p01) &&
-           get_value("cov_y_p10", snapshot.cov_y.p10) &&
-           get_value("cov_y_p11", snapshot.cov_y.p11) &&
-           get_value("state_z_position", snapshot.state_z.position) &&
-           get_value("state_z_velocity", snapshot.state_z.velocity) &&
-           get_value("cov_z_p00", snapshot.cov_z.p00) &&
-           get_value("cov_z_p01", snapshot.cov_z.p01) &&
-           get_value("cov_z_p10", snapshot.cov_z.p10) &&
-           get_value("cov_z_p11", snapshot.cov_z.p11);
+        pending_datetime.clear();
+    }
+    
+    template <typename Writer>
+    void write(Writer& writer) const {
+        writer.write_rows(samples.datetime, displacement_y, displacement_z);
+    }
+    
+    // 평활 시 아직 변위가 나오지 않은 샘플의 시각 (최대 lag개)
+    TimestampColumn pending_datetime;
+    TimestampColumn emitted_datetime;
+    TimestampColumn carry_datetime;
+};
+
+// 전역 설정에 따라 고정 지연 평활기 생성 (사용하지 않으면 nullptr)
+static std::unique_ptr<FixedLagSmoother> make_smoother(const KalmanParams& params) {
+    size_t lag = g_smoothing_lag.load();
+    if (lag == 0) {
+        return nullptr;
+    }
+    return std::unique_ptr<FixedLagSmoother>(new FixedLagSmoother(params, lag));
+}
+
+static bool is_valid_gps(double gps, int fix) {
+    return fix >= 1 && !std::isnan(gps) && std::isfinite(gps);
 }
 
+// 블록에서 축별 첫 번째 유효한 GPS 측정값(Fix >= 1)을 찾음
+static void scan_initial_positions(const SampleBlock& samples,
+                                   double& initial_y, bool& found_y,
+                                   double& initial_z, bool& found_z) {
+    for (size_t i = 0; i < samples.size() && !(found_y && found_z); i++) {
+        if (!found_y && is_valid_gps(samples.gps_y[i], samples.fix[i])) {
+            initial_y = samples.gps_y[i];
+            found_y = true;
+        }
+        if (!found_z && is_valid_gps(samples.gps_z[i], samples.fix[i])) {
+            initial_z = samples.gps_z[i];
+            found_z = true;
+        }
+    }
+}
+
+// 첫 번째 청크에서 초기 위치를 찾고, 없으면 파일 뒤쪽을 미리 읽어 찾은 뒤 읽기 위치를 되돌림
+// (KalmanFilter::process()의 전체 데이터 기준 초기화와 동일한 결과)
+static void find_initial_positions(CsvReader& reader, const SampleBlock& first_chunk,
+                                   double& initial_y, double& initial_z) {
+    initial_y = first_chunk.gps_y[0];
+    initial_z = first_chunk.gps_z[0];
+    bool found_y = false;
+    bool found_z = false;
+    scan_initial_positions(first_chunk, initial_y, found_y, initial_z, found_z);
+    if (found_y && found_z) {
+        return;
+    }
+    
+    size_t resume_offset = reader.tell();
+    SampleBlock lookahead;
+    while (!(found_y && found_z) && reader.read(lookahead, STREAM_CHUNK_ROWS) > 0) {
+        scan_initial_positions(lookahead, initial_y, found_y, initial_z, found_z);
+        lookahead.clear();
+    }
+    reader.seek(resume_offset);
+}
+
+// 첫 번째 배치에서만 초기 위치를 찾음 (배치/실시간 모드의 기존 초기화 규칙)
+static void reset_from_first_batch(const SampleBlock& samples,
+                                   DualAxisKalmanFilter& filter) {
+    double initial_y = samples.gps_y[0];
+    double initial_z = samples.gps_z[0];
+    bool found_y = false;
+    bool found_z = false;
+    scan_initial_positions(samples, initial_y, found_y, initial_z, found_z);
+    filter.reset(initial_y, initial_z);
+}
+
+static void report_insufficient_data(size_t min_rows, size_t rows) {
+    LogLine(LogLevel::Error) << "Insufficient data. Minimum " << min_rows
+                             << " rows required, but got " << rows;
+}
 
 // 내부 구현 함수
+// (allow_parallel_filter: 여러 파일을 이미 병렬로 처리 중이면 false로 시간 축 병렬 필터를 끔)
 int process_fusion_internal(
     const std::string& input_file_path,
     const std::string& output_file_path,
     double Q,
-    double R) {
+    double R,
+    bool allow_parallel_filter) {
     
     // 최소 데이터 요구사항 확인
     const size_t MIN_ROWS = 20;
+    const int output_precision = g_output_precision.load();
     
-    // CSV 파일 파싱
-    std::vector<InputData> input_data;
-    if (!parse_csv(input_file_path, input_data)) {
+    // CSV 파일 열기 (청크 단위 스트리밍)
+    CsvReader reader;
+    if (!reader.open(input_file_path)) {
         return FUSION_ERROR_FILE_NOT_FOUND;
     }
     
-    // 최소 데이터 개수 확인
-    if (input_data.size() < MIN_ROWS) {
-        std::cerr << "Error: Insufficient data. Minimum " << MIN_ROWS 
-                  << " rows required, but got " << input_data.size() << std::endl;
+    // 첫 번째 청크로 최소 데이터 개수 확인 (청크 크기 >= MIN_ROWS)
+    ChunkBuffers chunk;
+    reader.read(chunk.samples, STREAM_CHUNK_ROWS);
+    if (chunk.samples.size() < MIN_ROWS) {
+        report_insufficient_data(MIN_ROWS, chunk.samples.size());
         return FUSION_ERROR_INSUFFICIENT_DATA;
     }
     
-    // 데이터 추출
-    std::vector<double> gps_y_data;
-    std::vector<double> gps_z_data;
-    std::vector<double> acc_y_data;
-    std::vector<double> acc_z_data;
-    std::vector<int> fix_data;
-    std::vector<std::string> datetime_data;
-    
-    for (const auto& row : input_data) {
-        datetime_data.push_back(row.datetime);
-        gps_y_data.push_back(row.gps_y);
-        gps_z_data.push_back(row.gps_z);
-        acc_y_data.push_back(row.acc_y);
-        acc_z_data.push_back(row.acc_z);
-        fix_data.push_back(row.fix);
-    }
-    
     // 칼만 필터 파라미터 설정
     KalmanParams params(Q, R);
+    DualAxisKalmanFilter filter = make_filter(params);
     
-    // Y 방향 칼만 필터 처리
-    KalmanFilter filter_y(params);
-    std::vector<double> displacement_y = filter_y.process(gps_y_data, acc_y_data, fix_data);
+    // 초기화: 첫 번째 유효한 GPS 측정값(Fix >= 1)을 초기 위치로 사용
+    double initial_y = 0.0;
+    double initial_z = 0.0;
+    find_initial_positions(reader, chunk.samples, initial_y, initial_z);
+    filter.reset(initial_y, initial_z);
     
-    // Z 방향 칼만 필터 처리
-    KalmanFilter filter_z(params);
-    std::vector<double> displacement_z = filter_z.process(gps_z_data, acc_z_data, fix_data);
+    OutputWriter writer;
+    if (!writer.open(output_file_path, output_precision)) {
+        return FUSION_ERROR_FILE_NOT_FOUND;
+    }
     
-    // 출력 데이터 생성
-    std::vector<OutputData> output_data;
-    size_t n = datetime_data.size();
+    // 청크 단위로 필터링 후 바로 기록 (첫 청크의 첫 샘플만 초기 상태 그대로 출력)
+    // 평활 > 시간 축 병렬 필터 > 청크 병렬 처리 순으로 하나만 사용
+    std::unique_ptr<FixedLagSmoother> smoother = make_smoother(params);
+    std::unique_ptr<ThreadPool> pool = smoother || !allow_parallel_filter ? nullptr : make_parallel_pool();
+    const size_t chunked_chunks = g_chunked_filter_chunks.load();
+    const size_t chunked_overlap = g_chunked_filter_overlap.load();
+    std::unique_ptr<ThreadPool> chunked_pool =
+        smoother || pool || !allow_parallel_filter ? nullptr : make_chunked_pool(chunked_chunks);
+    const size_t chunk_rows = pool || chunked_pool ? PARALLEL_CHUNK_ROWS : STREAM_CHUNK_ROWS;
+    if (smoother) {
+        smoother->reset(initial_y, initial_z);
+    }
+    if (pool || chunked_pool) {
+        reader.read(chunk.samples, chunk_rows - chunk.samples.size());
+    }
+    bool hold_first = true;
+    do {
+        if (smoother) {
+            chunk.filter(*smoother, hold_first);
+        } else if (pool) {
+            chunk.filter(filter, *pool, hold_first);
+        } else if (chunked_pool) {
+            chunk.filter(filter, *chunked_pool, chunked_chunks, chunked_overlap, hold_first);
+        } else {
+            chunk.filter(filter, hold_first);
+        }
+        hold_first = false;
+        chunk.write(writer);
+        chunk.samples.clear();
+    } while (reader.read(chunk.samples, chunk_rows) > 0);
     
-    for (size_t i = 0; i < n; i++) {
-        OutputData output_row;
-        output_row.datetime = datetime_data[i];
-        output_row.displacement_y = displacement_y[i];
-        output_row.displacement_z = displacement_z[i];
-        output_data.push_back(output_row);
+    if (smoother) {
+        chunk.flush(*smoother);
+        chunk.write(writer);
     }
     
-    // CSV 파일로 저장
-    if (!save_csv(output_file_path, output_data)) {
+    if (!writer.close()) {
         return FUSION_ERROR_FILE_NOT_FOUND;
     }
+    if (reader.failed()) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    
+    return FUSION_SUCCESS;
+}
+
+// 호출자 버퍼가 연속이 아닐 때 한 번에 스택 버퍼로 모으는 행 수
+static const size_t ARRAY_CHUNK_ROWS = 256;
+
+// 바이트 단위 간격으로 i번째 요소 접근
+template<typename T>
+static T& strided_at(T* base, size_t stride, size_t i) {
+    typedef typename std::conditional<std::is_const<T>::value, const char, char>::type Byte;
+    return *reinterpret_cast<T*>(reinterpret_cast<Byte*>(base) + i * stride);
+}
+
+// 호출자 메모리의 입력 샘플 (간격은 바이트 단위)
+struct StridedSamples {
+    const double* gps_y;
+    const double* gps_z;
+    const double* acc_y;
+    const double* acc_z;
+    const int* fix;
+    size_t double_stride;
+    size_t int_stride;
+    
+    bool contiguous() const {
+        return double_stride == sizeof(double) && int_stride == sizeof(int);
+    }
+};
+
+// 호출자 메모리의 변위 출력 버퍼 (간격은 바이트 단위)
+struct StridedOutput {
+    double* y;
+    double* z;
+    size_t stride;
+    
+    bool contiguous() const { return stride == sizeof(double); }
+};
+
+// 축별 첫 번째 유효한 GPS 측정값(Fix >= 1)을 초기 위치로 사용 (없으면 첫 샘플 값)
+static void reset_from_samples(const StridedSamples& in, size_t n, DualAxisKalmanFilter& filter) {
+    double initial_y = strided_at(in.gps_y, in.double_stride, 0);
+    double initial_z = strided_at(in.gps_z, in.double_stride, 0);
+    bool found_y = false;
+    bool found_z = false;
+    for (size_t i = 0; i < n && !(found_y && found_z); i++) {
+        int fix_value = strided_at(in.fix, in.int_stride, i);
+        if (!found_y && is_valid_gps(strided_at(in.gps_y, in.double_stride, i), fix_value)) {
+            initial_y = strided_at(in.gps_y, in.double_stride, i);
+            found_y = true;
+        }
+        if (!found_z && is_valid_gps(strided_at(in.gps_z, in.double_stride, i), fix_value)) {
+            initial_z = strided_at(in.gps_z, in.double_stride, i);
+            found_z = true;
+        }
+    }
+    filter.reset(initial_y, initial_z);
+}
+
+// 호출자 버퍼를 필터에 통과시킴 (연속 배열은 그대로, 간격이 있으면 스택 버퍼로 모아서 처리)
+static void filter_strided(DualAxisKalmanFilter& filter, const StridedSamples& in, const StridedOutput& out,
+                           size_t n, bool hold_first) {
+    if (in.contiguous() && out.contiguous()) {
+        filter.processBatch(Span<const double>(in.gps_y, n), Span<const double>(in.gps_z, n),
+                            Span<const double>(in.acc_y, n), Span<const double>(in.acc_z, n),
+                            Span<const int>(in.fix, n), Span<double>(out.y, n), Span<double>(out.z, n),
+                            hold_first);
+        return;
+    }
+    
+    double chunk_gps_y[ARRAY_CHUNK_ROWS];
+    double chunk_gps_z[ARRAY_CHUNK_ROWS];
+    double chunk_acc_y[ARRAY_CHUNK_ROWS];
+    double chunk_acc_z[ARRAY_CHUNK_ROWS];
+    int chunk_fix[ARRAY_CHUNK_ROWS];
+    double chunk_out_y[ARRAY_CHUNK_ROWS];
+    double chunk_out_z[ARRAY_CHUNK_ROWS];
+    
+    for (size_t begin = 0; begin < n; begin += ARRAY_CHUNK_ROWS) {
+        size_t count = std::min(ARRAY_CHUNK_ROWS, n - begin);
+        for (size_t i = 0; i < count; i++) {
+            chunk_gps_y[i] = strided_at(in.gps_y, in.double_stride, begin + i);
+            chunk_gps_z[i] = strided_at(in.gps_z, in.double_stride, begin + i);
+            chunk_acc_y[i] = strided_at(in.acc_y, in.double_stride, begin + i);
+            chunk_acc_z[i] = strided_at(in.acc_z, in.double_stride, begin + i);
+            chunk_fix[i] = strided_at(in.fix, in.int_stride, begin + i);
+        }
+        
+        filter.processBatch(Span<const double>(chunk_gps_y, count), Span<const double>(chunk_gps_z, count),
+                            Span<const double>(chunk_acc_y, count), Span<const double>(chunk_acc_z, count),
+                            Span<const int>(chunk_fix, count), Span<double>(chunk_out_y, count),
+                            Span<double>(chunk_out_z, count), hold_first && begin == 0);
+        
+        for (size_t i = 0; i < count; i++) {
+            strided_at(out.y, out.stride, begin + i) = chunk_out_y[i];
+            strided_at(out.z, out.stride, begin + i) = chunk_out_z[i];
+        }
+    }
+}
+
+// 호출자 버퍼를 고정 지연 평활기에 통과시킴 (출력은 lag 샘플 늦게 나오므로 스택 버퍼를 거쳐 기록)
+static void smooth_strided(FixedLagSmoother& smoother, const StridedSamples& in, const StridedOutput& out,
+                           size_t n) {
+    double chunk_gps_y[ARRAY_CHUNK_ROWS];
+    double chunk_gps_z[ARRAY_CHUNK_ROWS];
+    double chunk_acc_y[ARRAY_CHUNK_ROWS];
+    double chunk_acc_z[ARRAY_CHUNK_ROWS];
+    int chunk_fix[ARRAY_CHUNK_ROWS];
+    double chunk_out_y[ARRAY_CHUNK_ROWS];
+    double chunk_out_z[ARRAY_CHUNK_ROWS];
+    
+    size_t written = 0;
+    for (size_t begin = 0; begin < n; begin += ARRAY_CHUNK_ROWS) {
+        size_t count = std::min(ARRAY_CHUNK_ROWS, n - begin);
+        for (size_t i = 0; i < count; i++) {
+            chunk_gps_y[i] = strided_at(in.gps_y, in.double_stride, begin + i);
+            chunk_gps_z[i] = strided_at(in.gps_z, in.double_stride, begin + i);
+            chunk_acc_y[i] = strided_at(in.acc_y, in.double_stride, begin + i);
+            chunk_acc_z[i] = strided_at(in.acc_z, in.double_stride, begin + i);
+            chunk_fix[i] = strided_at(in.fix, in.int_stride, begin + i);
+        }
+        
+        size_t emitted = 0;
+        smoother.processBatch(Span<const double>(chunk_gps_y, count), Span<const double>(chunk_gps_z, count),
+                              Span<const double>(chunk_acc_y, count), Span<const double>(chunk_acc_z, count),
+                              Span<const int>(chunk_fix, count), Span<double>(chunk_out_y, count),
+                              Span<double>(chunk_out_z, count), begin == 0, emitted);
+        
+        for (size_t i = 0; i < emitted; i++) {
+            strided_at(out.y, out.stride, written + i) = chunk_out_y[i];
+            strided_at(out.z, out.stride, written + i) = chunk_out_z[i];
+        }
+        written += emitted;
+    }
+    
+    // 남은 샘플 (최대 lag개)은 한 번의 역방향 패스로 평활
+    std::vector<double> rest_y(smoother.pending());
+    std::vector<double> rest_z(smoother.pending());
+    size_t emitted = 0;
+    smoother.flush(rest_y, rest_z, emitted);
+    for (size_t i = 0; i < emitted; i++) {
+        strided_at(out.y, out.stride, written + i) = rest_y[i];
+        strided_at(out.z, out.stride, written + i) = rest_z[i];
+    }
+}
+
+// 메모리 버퍼 처리 내부 구현 함수 (일반 처리 모드와 같은 규칙, 평활을 사용하지 않으면 힙 할당 없음)
+int process_fusion_arrays_internal(
+    const StridedSamples& samples,
+    size_t n,
+    const StridedOutput& output,
+    double Q,
+    double R) {
+    
+    const size_t MIN_ROWS = 20;
+    if (n < MIN_ROWS) {
+        report_insufficient_data(MIN_ROWS, n);
+        return FUSION_ERROR_INSUFFICIENT_DATA;
+    }
+    
+    KalmanParams params(Q, R);
+    DualAxisKalmanFilter filter = make_filter(params);
+    reset_from_samples(samples, n, filter);
+    std::unique_ptr<FixedLagSmoother> smoother = make_smoother(params);
+    if (smoother) {
+        smoother->reset(filter.getStateY().position, filter.getStateZ().position);
+        FilterStageRecorder recorder(*smoother);
+        smooth_strided(*smoother, samples, output, n);
+        return FUSION_SUCCESS;
+    }
+    FilterStageRecorder recorder(filter);
+    std::unique_ptr<ThreadPool> pool;
+    if (samples.contiguous() && output.contiguous() && n >= 2 * MIN_PARALLEL_BLOCK_ROWS) {
+        pool = make_parallel_pool();
+    }
+    if (pool) {
+        process_parallel_in_time(filter, *pool, Span<const double>(samples.gps_y, n),
+                                 Span<const double>(samples.gps_z, n), Span<const double>(samples.acc_y, n),
+                                 Span<const double>(samples.acc_z, n), Span<const int>(samples.fix, n),
+                                 Span<double>(output.y, n), Span<double>(output.z, n), true);
+        return FUSION_SUCCESS;
+    }
+    const size_t chunked_chunks = g_chunked_filter_chunks.load();
+    if (samples.contiguous() && output.contiguous()) {
+        pool = make_chunked_pool(chunked_chunks);
+    }
+    if (pool) {
+        process_chunked_overlap(filter, *pool, chunked_chunks, g_chunked_filter_overlap.load(),
+                                Span<const double>(samples.gps_y, n), Span<const double>(samples.gps_z, n),
+                                Span<const double>(samples.acc_y, n), Span<const double>(samples.acc_z, n),
+                                Span<const int>(samples.fix, n), Span<double>(output.y, n),
+                                Span<double>(output.z, n), true);
+        return FUSION_SUCCESS;
+    }
+    filter_strided(filter, samples, output, n, true);
     
     return FUSION_SUCCESS;
 }
@@ -234,31 +716,45 @@ int process_fusion_batch_internal(
     
     // 최소 데이터 요구사항 확인
     const size_t MIN_ROWS = 20;
+    const int output_precision = g_output_precision.load();
     
-    // CSV 파일 파싱
-    std::vector<InputData> input_data;
-    if (!parse_csv(input_file_path, input_data)) {
+    // CSV 파일 열기 (배치 단위 스트리밍)
+    CsvReader reader;
+    if (!reader.open(input_file_path)) {
         return FUSION_ERROR_FILE_NOT_FOUND;
     }
     
-    // 최소 데이터 개수 확인
-    if (input_data.size() < MIN_ROWS) {
-        std::cerr << "Error: Insufficient data. Minimum " << MIN_ROWS 
-                  << " rows required, but got " << input_data.size() << std::endl;
-        return FUSION_ERROR_INSUFFICIENT_DATA;
-    }
+    ChunkBuffers batch;
     
-    // 배치 크기 검증
+    // 배치 크기 검증 (데이터 부족 오류가 우선)
     if (batch_size < MIN_ROWS) {
-        std::cerr << "Error: Batch size must be at least " << MIN_ROWS << std::endl;
+        reader.read(batch.samples, MIN_ROWS);
+        if (batch.samples.size() < MIN_ROWS) {
+            report_insufficient_data(MIN_ROWS, batch.samples.size());
+            return FUSION_ERROR_INSUFFICIENT_DATA;
+        }
+        LogLine(LogLevel::Error) << "Batch size must be at least " << MIN_ROWS;
         return FUSION_ERROR_INVALID_DATA;
     }
     
+    // 첫 번째 배치로 최소 데이터 개수 확인
+    reader.read(batch.samples, batch_size);
+    if (batch.samples.size() < MIN_ROWS) {
+        report_insufficient_data(MIN_ROWS, batch.samples.size());
+        return FUSION_ERROR_INSUFFICIENT_DATA;
+    }
+    
     // 출력 파일 경로에서 기본 이름 추출 (중간 파일명 생성용)
+    // 압축 확장자는 원래 확장자 뒤에 유지 (out.csv.gz → out_batch_001.csv.gz)
     fs::path output_path(output_file_path);
+    std::string compression_ext;
+    if (compression_for_path(output_file_path) != Compression::None) {
+        compression_ext = output_path.extension().string();
+        output_path.replace_extension();
+    }
     std::string output_base = output_path.stem().string();
     std::string output_dir = output_path.parent_path().string();
-    std::string output_ext = output_path.extension().string();
+    std::string output_ext = output_path.extension().string() + compression_ext;
     
     // 중간 파일 저장 디렉토리 설정
     if (output_dir.empty()) {
@@ -268,94 +764,54 @@ int process_fusion_batch_internal(
     // 칼만 필터 파라미터 설정
     KalmanParams params(Q, R);
     
-    // 칼만 필터 초기화
-    KalmanFilter filter_y(params);
-    KalmanFilter filter_z(params);
-    
-    // 전체 출력 데이터 저장
-    std::vector<OutputData> all_output_data;
+    // 칼만 필터 초기화 (첫 번째 배치의 첫 유효 GPS 측정값 사용)
+    DualAxisKalmanFilter filter = make_filter(params);
+    reset_from_first_batch(batch.samples, filter);
+    std::unique_ptr<FixedLagSmoother> smoother = make_smoother(params);
+    if (smoother) {
+        smoother->reset(filter.getStateY().position, filter.getStateZ().position);
+    }
     
-    // 배치 개수 계산
-    size_t total_rows = input_data.size();
-    size_t num_batches = (total_rows + batch_size - 1) / batch_size;  // 올림 계산
+    // 최종 결과는 배치마다 바로 기록 (전체 결과를 메모리에 모으지 않음)
+    OutputWriter writer;
+    if (!writer.open(output_file_path, output_precision)) {
+        return FUSION_ERROR_FILE_NOT_FOUND;
+    }
     
-    std::cout << "Processing " << total_rows << " rows in " << num_batches 
-              << " batch(es) of " << batch_size << " rows each" << std::endl;
+    LogLine(LogLevel::Info) << "Processing input in batch(es) of " << batch_size << " rows each";
     
-    // 첫 번째 배치에서 초기화
-    bool is_first_batch = true;
+    // 포맷과 파일 쓰기는 백그라운드 스레드에서 필터 처리와 겹쳐 수행
+    AsyncBatchWriter batch_writer(writer, output_precision);
+    size_t total_rows = 0;
+    size_t batch_idx = 0;
+    SampleBlock next_samples;  // 평활 시 마지막 배치를 알기 위해 다음 배치를 미리 읽어 둠
     
     // 배치 단위로 처리
-    for (size_t batch_idx = 0; batch_idx < num_batches; batch_idx++) {
-        size_t start_idx = batch_idx * batch_size;
-        size_t end_idx = std::min(start_idx + batch_size, total_rows);
-        size_t current_batch_size = end_idx - start_idx;
-        
-        std::cout << "Processing batch " << (batch_idx + 1) << "/" << num_batches 
-                  << " (rows " << start_idx << "-" << (end_idx - 1) << ")" << std::endl;
+    do {
+        size_t current_batch_size = batch.samples.size();
+        size_t start_idx = total_rows;
+        size_t end_idx = start_idx + current_batch_size;
         
-        // 현재 배치 데이터 추출
-        std::vector<double> gps_y_batch;
-        std::vector<double> gps_z_batch;
-        std::vector<double> acc_y_batch;
-        std::vector<double> acc_z_batch;
-        std::vector<int> fix_batch;
-        std::vector<std::string> datetime_batch;
-        
-        for (size_t i = start_idx; i < end_idx; i++) {
-            datetime_batch.push_back(input_data[i].datetime);
-            gps_y_batch.push_back(input_data[i].gps_y);
-            gps_z_batch.push_back(input_data[i].gps_z);
-            acc_y_batch.push_back(input_data[i].acc_y);
-            acc_z_batch.push_back(input_data[i].acc_z);
-            fix_batch.push_back(input_data[i].fix);
-        }
+        LogLine(LogLevel::Debug) << "Processing batch " << (batch_idx + 1)
+                                 << " (rows " << start_idx << "-" << (end_idx - 1) << ")";
         
-        // 첫 번째 배치인 경우 초기화
-        if (is_first_batch) {
-            // 첫 번째 유효한 GPS 측정값(Fix >= 1)으로 초기화
-            double initial_y = gps_y_batch[0];
-            double initial_z = gps_z_batch[0];
-            for (size_t i = 0; i < gps_y_batch.size(); i++) {
-                if (fix_batch[i] >= 1 && !std::isnan(gps_y_batch[i]) && std::isfinite(gps_y_batch[i])) {
-                    initial_y = gps_y_batch[i];
-                    break;
-                }
-            }
-            for (size_t i = 0; i < gps_z_batch.size(); i++) {
-                if (fix_batch[i] >= 1 && !std::isnan(gps_z_batch[i]) && std::isfinite(gps_z_batch[i])) {
-                    initial_z = gps_z_batch[i];
-                    break;
-                }
+        // Y/Z 방향 칼만 필터 처리 (이전 배치의 상태는 필터에 유지되어 있음)
+        // 평활 시 배치 출력은 lag 샘플 늦고, 마지막 배치에 남은 샘플까지 모두 기록
+        if (smoother) {
+            batch.filter(*smoother, true);
+            reader.read(next_samples, batch_size);
+            if (next_samples.empty()) {
+                batch.flush(*smoother);
             }
-            filter_y.reset(initial_y);
-            filter_z.reset(initial_z);
-            is_first_batch = false;
         } else {
-            // 상태 복원 (이전 배치에서 저장된 상태 사용)
-            // 상태는 이미 필터에 유지되어 있음
-        }
-        
-        // Y 방향 칼만 필터 처리
-        std::vector<double> displacement_y_batch = filter_y.processBatch(gps_y_batch, acc_y_batch, fix_batch);
-        
-        // Z 방향 칼만 필터 처리
-        std::vector<double> displacement_z_batch = filter_z.processBatch(gps_z_batch, acc_z_batch, fix_batch);
-        
-        // 배치 출력 데이터 생성
-        std::vector<OutputData> batch_output_data;
-        for (size_t i = 0; i < current_batch_size; i++) {
-            OutputData output_row;
-            output_row.datetime = datetime_batch[i];
-            output_row.displacement_y = displacement_y_batch[i];
-            output_row.displacement_z = displacement_z_batch[i];
-            batch_output_data.push_back(output_row);
+            batch.filter(filter, true);
         }
         
-        // 전체 결과에 추가
-        all_output_data.insert(all_output_data.end(), 
-                              batch_output_data.begin(), 
-                              batch_output_data.end());
+        // 결과 버퍼를 기록 스레드로 넘기고, 기록이 끝난 버퍼를 다음 배치에 재사용
+        OutputBatch output = batch_writer.acquire();
+        std::swap(output.datetime, batch.samples.datetime);
+        std::swap(output.displacement_y, batch.displacement_y);
+        std::swap(output.displacement_z, batch.displacement_z);
         
         // 중간 결과 저장
         if (save_intermediate) {
@@ -363,30 +819,34 @@ int process_fusion_batch_internal(
             intermediate_filename << output_dir << "/" << output_base 
                                   << "_batch_" << std::setfill('0') << std::setw(3) 
                                   << (batch_idx + 1) << output_ext;
-            
-            std::string intermediate_path = intermediate_filename.str();
-            if (save_csv(intermediate_path, batch_output_data)) {
-                std::cout << "  Intermediate result saved: " << intermediate_path << std::endl;
-            } else {
-                std::cerr << "  Warning: Failed to save intermediate result: " 
-                          << intermediate_path << std::endl;
-            }
+            output.intermediate_path = intermediate_filename.str();
         }
+        batch_writer.submit(std::move(output));
         
-        // 상태 저장 (다음 배치를 위해)
-        // 상태는 이미 필터 객체에 유지되어 있음
+        LogLine(LogLevel::Debug) << "Batch " << (batch_idx + 1) << " completed: "
+                                 << current_batch_size << " rows processed";
         
-        std::cout << "  Batch " << (batch_idx + 1) << " completed: " 
-                  << current_batch_size << " rows processed" << std::endl;
-    }
+        total_rows = end_idx;
+        batch_idx++;
+        batch.samples.clear();
+        if (smoother) {
+            std::swap(batch.samples, next_samples);
+        } else {
+            reader.read(batch.samples, batch_size);
+        }
+    } while (!batch.samples.empty());
     
     // 최종 결과 저장
-    if (!save_csv(output_file_path, all_output_data)) {
+    bool all_written = batch_writer.finish();
+    if (!writer.close() || !all_written) {
         return FUSION_ERROR_FILE_NOT_FOUND;
     }
+    if (reader.failed()) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
     
-    std::cout << "Final result saved: " << output_file_path << std::endl;
-    std::cout << "Total rows processed: " << all_output_data.size() << std::endl;
+    LogLine(LogLevel::Info) << "Final result saved: " << output_file_path;
+    LogLine(LogLevel::Info) << "Total rows processed: " << total_rows;
     
     return FUSION_SUCCESS;
 }
@@ -396,175 +856,502 @@ int process_fusion_realtime_internal(
     const std::string& input_file_path,
     const std::string& output_file_path,
     double Q,
-    double R) {
+    double R,
+    const std::string& state_file_path) {
     
     const size_t MIN_ROWS = 20;
+    const int output_precision = g_output_precision.load();
     const size_t batch_size = 100;
     
-    // CSV 파일 파싱
-    std::vector<InputData> input_data;
-    if (!parse_csv(input_file_path, input_data)) {
-        return FUSION_ERROR_FILE_NOT_FOUND;
+    // 출력을 계속 이어 붙여야 하므로 바이너리 컬럼 형식은 지원하지 않음
+    if (output_format_for_path(output_file_path) != OutputFormat::Csv) {
+        LogLine(LogLevel::Error) << "Binary columnar output is not supported in realtime mode: "
+                                 << output_file_path;
+        return FUSION_ERROR_INVALID_DATA;
     }
     
-    // 최소 데이터 개수 확인
-    if (input_data.size() < MIN_ROWS) {
-        std::cerr << "Error: Insufficient data. Minimum " << MIN_ROWS
-                  << " rows required, but got " << input_data.size() << std::endl;
-        return FUSION_ERROR_INSUFFICIENT_DATA;
+    // 상태 파일에는 필터 상태만 저장하므로 평활 대기 중인 샘플을 이어서 처리할 수 없음
+    if (g_smoothing_lag.load() > 0) {
+        LogLine(LogLevel::Error) << "Fixed-lag smoothing is not supported in realtime mode";
+        return FUSION_ERROR_INVALID_DATA;
     }
     
-    // 데이터 추출
-    std::vector<double> gps_y_data;
-    std::vector<double> gps_z_data;
-    std::vector<double> acc_y_data;
-    std::vector<double> acc_z_data;
-    std::vector<int> fix_data;
-    std::vector<std::string> datetime_data;
-    
-    for (const auto& row : input_data) {
-        datetime_data.push_back(row.datetime);
-        gps_y_data.push_back(row.gps_y);
-        gps_z_data.push_back(row.gps_z);
-        acc_y_data.push_back(row.acc_y);
-        acc_z_data.push_back(row.acc_z);
-        fix_data.push_back(row.fix);
+    // CSV 파일 열기 (배치 단위 스트리밍)
+    CsvReader reader;
+    if (!reader.open(input_file_path)) {
+        return FUSION_ERROR_FILE_NOT_FOUND;
+    }
+    // 진행 위치와 지문을 파일 바이트 기준으로 저장하므로 압축된 입력은 이어서 처리할 수 없음
+    if (reader.is_compressed()) {
+        LogLine(LogLevel::Error) << "Compressed input is not supported in realtime mode: " << input_file_path;
+        return FUSION_ERROR_INVALID_DATA;
     }
     
     KalmanParams params(Q, R);
-    KalmanFilter filter_y(params);
-    KalmanFilter filter_z(params);
+    DualAxisKalmanFilter filter = make_filter(params);
+    
+    // 상태 파일을 쓰는 동안 같은 상태 파일을 쓰는 다른 호출은 대기
+    std::shared_ptr<std::mutex> state_file_mutex = get_state_file_mutex(state_file_path);
+    std::lock_guard<std::mutex> state_file_lock(*state_file_mutex);
     
     // 상태 파일에서 복원 시도
-    std::string state_file_path = build_state_file_path(output_file_path);
     FilterSnapshot snapshot;
-    bool has_snapshot = load_filter_snapshot(state_file_path, snapshot);
-    if (has_snapshot) {
-        filter_y.setState(snapshot.state_y);
-        filter_y.setCovariance(snapshot.cov_y);
-        filter_z.setState(snapshot.state_z);
-        filter_z.setCovariance(snapshot.cov_z);
+    bool has_snapshot;
+    {
+        StageTimer timer(run_stats().snapshot_ns);
+        has_snapshot = load_filter_snapshot(state_file_path, snapshot);
     }
     
-    std::vector<OutputData> all_output_data;
-    size_t total_rows = input_data.size();
-    size_t num_batches = (total_rows + batch_size - 1) / batch_size;
+    // 같은 입력 파일을 이어서 처리하는 경우: 이미 처리한 부분을 건너뛰고 새로 덧붙은 행만 출력 뒤에 추가
+    std::string_view contents = reader.contents();
+    bool resume_tail = has_snapshot && snapshot.has_input_position &&
+                       snapshot.input_offset <= contents.size() &&
+                       input_fingerprint(contents, snapshot.input_offset) == snapshot.input_fingerprint &&
+                       file_exists(output_file_path);
     
-    bool is_first_batch = true;
+    // 이전 호출 이후 입력 파일 크기나 수정 시각이 바뀌었으면 로거가 아직 덧붙이는 중으로 보고
+    // 줄바꿈으로 끝나지 않은 마지막 줄은 다음 호출로 미룸 (기록 중인 줄을 반쪽만 읽지 않도록).
+    // 바뀌지 않았으면 쓰기가 끝난 파일이므로 마지막 줄도 일반 행으로 읽는다 (이어서 처리하지 않는 첫 호출도 같음).
+    const uint64_t input_size = contents.size();
+    const int64_t input_modified_time = reader.modified_time();
+    bool input_growing = resume_tail && (snapshot.input_size != input_size ||
+                                         snapshot.input_modified_time != input_modified_time);
+    reader.set_complete_lines_only(input_growing);
     
-    for (size_t batch_idx = 0; batch_idx < num_batches; batch_idx++) {
-        size_t start_idx = batch_idx * batch_size;
-        size_t end_idx = std::min(start_idx + batch_size, total_rows);
-        size_t current_batch_size = end_idx - start_idx;
-        
-        std::vector<double> gps_y_batch;
-        std::vector<double> gps_z_batch;
-        std::vector<double> acc_y_batch;
-        std::vector<double> acc_z_batch;
-        std::vector<int> fix_batch;
-        std::vector<std::string> datetime_batch;
-        
-        for (size_t i = start_idx; i < end_idx; i++) {
-            datetime_batch.push_back(datetime_data[i]);
-            gps_y_batch.push_back(gps_y_data[i]);
-            gps_z_batch.push_back(gps_z_data[i]);
-            acc_y_batch.push_back(acc_y_data[i]);
-            acc_z_batch.push_back(acc_z_data[i]);
-            fix_batch.push_back(fix_data[i]);
-        }
-        
-        if (is_first_batch && !has_snapshot) {
-            double initial_y = gps_y_batch[0];
-            double initial_z = gps_z_batch[0];
-            for (size_t i = 0; i < gps_y_batch.size(); i++) {
-                if (fix_batch[i] >= 1 && !std::isnan(gps_y_batch[i]) && std::isfinite(gps_y_batch[i])) {
-                    initial_y = gps_y_batch[i];
-                    break;
+    ChunkBuffers batch;
+    uint64_t rows_consumed = 0;
+    if (resume_tail) {
+        reader.seek(static_cast<size_t>(snapshot.input_offset));
+        rows_consumed = snapshot.input_rows;
+        if (reader.read(batch.samples, batch_size) == 0) {
+            // 새로 덧붙은 행 없음: 파일이 그대로인지 다음 호출에서 판단할 수 있도록 크기/수정 시각만 갱신
+            if (snapshot.input_size != input_size || snapshot.input_modified_time != input_modified_time) {
+                snapshot.input_size = input_size;
+                snapshot.input_modified_time = input_modified_time;
+                if (!write_snapshot(state_file_path, snapshot)) {
+                    LogLine(LogLevel::Warning) << "Failed to save state file: " << state_file_path;
                 }
             }
-            for (size_t i = 0; i < gps_z_batch.size(); i++) {
-                if (fix_batch[i] >= 1 && !std::isnan(gps_z_batch[i]) && std::isfinite(gps_z_batch[i])) {
-                    initial_z = gps_z_batch[i];
-                    break;
-                }
-            }
-            filter_y.reset(initial_y);
-            filter_z.reset(initial_z);
+            return FUSION_SUCCESS;
         }
-        is_first_batch = false;
-        
-        std::vector<double> displacement_y_batch = filter_y.processBatch(
-            gps_y_batch, acc_y_batch, fix_batch);
-        std::vector<double> displacement_z_batch = filter_z.processBatch(
-            gps_z_batch, acc_z_batch, fix_batch);
-        
-        for (size_t i = 0; i < current_batch_size; i++) {
-            OutputData output_row;
-            output_row.datetime = datetime_batch[i];
-            output_row.displacement_y = displacement_y_batch[i];
-            output_row.displacement_z = displacement_z_batch[i];
-            all_output_data.push_back(output_row);
+        filter.setState(snapshot.state_y, snapshot.state_z);
+        filter.setCovariance(snapshot.cov_y, snapshot.cov_z);
+    } else {
+        // 첫 번째 배치로 최소 데이터 개수 확인
+        reader.read(batch.samples, batch_size);
+        if (batch.samples.size() < MIN_ROWS) {
+            report_insufficient_data(MIN_ROWS, batch.samples.size());
+            return FUSION_ERROR_INSUFFICIENT_DATA;
+        }
+        if (has_snapshot) {
+            filter.setState(snapshot.state_y, snapshot.state_z);
+            filter.setCovariance(snapshot.cov_y, snapshot.cov_z);
+        } else {
+            reset_from_first_batch(batch.samples, filter);
+        }
+    }
+    
+    CsvWriter writer;
+    if (!writer.open(output_file_path, output_precision, resume_tail)) {
+        return FUSION_ERROR_FILE_NOT_FOUND;
+    }
+    
+    // 상태와 함께 입력 진행 위치를 저장 (출력이 파일에 기록된 뒤에만 저장해야 재개 시 행이 빠지지 않음)
+    // 중간 체크포인트는 디스크 기록을 기다리지 않고, 출력 파일을 닫은 뒤의 마지막 저장만 디스크까지 기록
+    WarningLimiter checkpoint_warnings("Failed state file saves");
+    auto save_checkpoint = [&](size_t input_offset, bool durable) {
+        FilterSnapshot latest_snapshot = capture_snapshot(filter);
+        latest_snapshot.has_input_position = true;
+        latest_snapshot.input_offset = input_offset;
+        latest_snapshot.input_rows = rows_consumed;
+        latest_snapshot.input_fingerprint = input_fingerprint(contents, input_offset);
+        latest_snapshot.input_size = input_size;
+        latest_snapshot.input_modified_time = input_modified_time;
+        if (!write_snapshot(state_file_path, latest_snapshot, durable) && checkpoint_warnings.should_report()) {
+            LogLine(LogLevel::Warning) << "Failed to save state file: " << state_file_path;
         }
+    };
+    
+    CheckpointSchedule checkpoint;
+    size_t consumed_offset = reader.tell();
+    bool has_more = true;
+    while (has_more) {
+        batch.filter(filter, true);
+        batch.write(writer);
+        size_t rows = batch.samples.size();
+        rows_consumed += rows;
+        consumed_offset = reader.tell();
+        batch.samples.clear();
+        has_more = reader.read(batch.samples, batch_size) > 0;
         
-        // 100 타임스텝 처리 후 상태 저장
-        FilterSnapshot latest_snapshot = capture_snapshot(filter_y, filter_z);
-        if (!save_filter_snapshot(state_file_path, latest_snapshot)) {
-            std::cerr << "Warning: Failed to save state file: " << state_file_path << std::endl;
+        // 체크포인트 간격(기본값: 100행)마다 상태 저장
+        if (checkpoint.advance(rows) && has_more) {
+            if (!writer.flush()) {
+                return FUSION_ERROR_FILE_NOT_FOUND;
+            }
+            save_checkpoint(consumed_offset, false);
         }
     }
     
-    if (!save_csv(output_file_path, all_output_data)) {
+    if (!writer.close()) {
         return FUSION_ERROR_FILE_NOT_FOUND;
     }
     
+    // 마지막 배치 뒤에는 간격과 관계없이 항상 저장
+    save_checkpoint(consumed_offset, true);
+    
     return FUSION_SUCCESS;
 }
 
-} // namespace fusion
-
-// C API 구현
-extern "C" {
-
-FUSION_API int fusion_process_csv(
-    const char* input_file_path,
-    const char* output_file_path,
+// 정상 상태 모드와 전체 필터의 최대 편차 측정 (일반 모드와 같은 초기화/처리 규칙)
+int measure_steady_state_deviation(
+    const std::string& input_file_path,
     double Q,
-    double R) {
+    double R,
+    double tolerance,
+    double& max_deviation) {
     
-    if (!input_file_path || !output_file_path) {
-        return FUSION_ERROR_INVALID_DATA;
+    const size_t MIN_ROWS = 20;
+    
+    CsvReader reader;
+    if (!reader.open(input_file_path)) {
+        return FUSION_ERROR_FILE_NOT_FOUND;
     }
     
-    try {
-        return fusion::process_fusion_internal(
-            std::string(input_file_path),
-            std::string(output_file_path),
-            Q,
-            R
-        );
-    } catch (const std::exception& e) {
-        std::cerr << "Exception in fusion_process_csv: " << e.what() << std::endl;
-        return FUSION_ERROR_UNKNOWN;
-    } catch (...) {
-        std::cerr << "Unknown exception in fusion_process_csv" << std::endl;
-        return FUSION_ERROR_UNKNOWN;
+    ChunkBuffers chunk;
+    reader.read(chunk.samples, STREAM_CHUNK_ROWS);
+    if (chunk.samples.size() < MIN_ROWS) {
+        report_insufficient_data(MIN_ROWS, chunk.samples.size());
+        return FUSION_ERROR_INSUFFICIENT_DATA;
+    }
+    
+    KalmanParams params(Q, R);
+    DualAxisKalmanFilter full_filter(params);
+    DualAxisKalmanFilter steady_filter(params);
+    steady_filter.enableSteadyState(true, tolerance);
+    
+    double initial_y = 0.0;
+    double initial_z = 0.0;
+    find_initial_positions(reader, chunk.samples, initial_y, initial_z);
+    full_filter.reset(initial_y, initial_z);
+    steady_filter.reset(initial_y, initial_z);
+    
+    std::vector<double> steady_y;
+    std::vector<double> steady_z;
+    max_deviation = 0.0;
+    bool hold_first = true;
+    do {
+        chunk.filter(full_filter, hold_first);
+        steady_y.resize(chunk.samples.size());
+        steady_z.resize(chunk.samples.size());
+        const SampleBlock& samples = chunk.samples;
+        steady_filter.processBatch(samples.gps_y, samples.gps_z, samples.acc_y, samples.acc_z, samples.fix,
+                                   steady_y, steady_z, hold_first);
+        hold_first = false;
+        
+        for (size_t i = 0; i < samples.size(); i++) {
+            max_deviation = std::max(max_deviation, std::fabs(steady_y[i] - chunk.displacement_y[i]));
+            max_deviation = std::max(max_deviation, std::fabs(steady_z[i] - chunk.displacement_z[i]));
+        }
+        chunk.samples.clear();
+    } while (reader.read(chunk.samples, STREAM_CHUNK_ROWS) > 0);
+    
+    if (reader.failed()) {
+        return FUSION_ERROR_INVALID_DATA;
     }
+    
+    return FUSION_SUCCESS;
 }
 
-FUSION_API int fusion_process_csv_batch(
-    const char* input_file_path,
-    const char* output_file_path,
+// 청크 병렬 처리와 순차 필터 결과의 최대 편차 측정 (일반 처리 모드와 같은 크기로 읽어 청크를 나눔)
+int measure_chunked_deviation(
+    const std::string& input_file_path,
     double Q,
     double R,
-    size_t batch_size,
-    int save_intermediate) {
+    size_t chunks,
+    size_t overlap,
+    double& max_deviation) {
     
-    if (!input_file_path || !output_file_path) {
-        return FUSION_ERROR_INVALID_DATA;
-    }
+    const size_t MIN_ROWS = 20;
     
-    if (batch_size == 0) {
-        batch_size = 100;  // 기본값
+    CsvReader reader;
+    if (!reader.open(input_file_path)) {
+        return FUSION_ERROR_FILE_NOT_FOUND;
+    }
+    
+    ChunkBuffers chunk;
+    reader.read(chunk.samples, PARALLEL_CHUNK_ROWS);
+    if (chunk.samples.size() < MIN_ROWS) {
+        report_insufficient_data(MIN_ROWS, chunk.samples.size());
+        return FUSION_ERROR_INSUFFICIENT_DATA;
+    }
+    
+    KalmanParams params(Q, R);
+    DualAxisKalmanFilter serial_filter(params);
+    DualAxisKalmanFilter chunked_filter(params);
+    
+    double initial_y = 0.0;
+    double initial_z = 0.0;
+    find_initial_positions(reader, chunk.samples, initial_y, initial_z);
+    serial_filter.reset(initial_y, initial_z);
+    chunked_filter.reset(initial_y, initial_z);
+    
+    ThreadPool pool(std::min(std::max<size_t>(chunks, 1), ThreadPool::default_thread_count()));
+    std::vector<double> chunked_y;
+    std::vector<double> chunked_z;
+    max_deviation = 0.0;
+    bool hold_first = true;
+    do {
+        chunk.filter(serial_filter, hold_first);
+        const SampleBlock& samples = chunk.samples;
+        chunked_y.resize(samples.size());
+        chunked_z.resize(samples.size());
+        process_chunked_overlap(chunked_filter, pool, chunks, overlap, samples.gps_y, samples.gps_z,
+                                samples.acc_y, samples.acc_z, samples.fix, chunked_y, chunked_z, hold_first);
+        hold_first = false;
+        
+        for (size_t i = 0; i < samples.size(); i++) {
+            max_deviation = std::max(max_deviation, std::fabs(chunked_y[i] - chunk.displacement_y[i]));
+            max_deviation = std::max(max_deviation, std::fabs(chunked_z[i] - chunk.displacement_z[i]));
+        }
+        chunk.samples.clear();
+    } while (reader.read(chunk.samples, PARALLEL_CHUNK_ROWS) > 0);
+    
+    if (reader.failed()) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    
+    return FUSION_SUCCESS;
+}
+
+// 파라미터 스윕 내부 구현 함수 (입력은 한 번만 파싱)
+int sweep_parameters_internal(
+    const std::string& input_file_path,
+    const std::vector<KalmanParams>& params,
+    FusionSweepResult* results,
+    const char* best_output_file_path,
+    size_t& best_index) {
+    
+    const size_t MIN_ROWS = 20;
+    
+    SampleBlock samples;
+    if (!parse_csv(input_file_path, samples)) {
+        return FUSION_ERROR_FILE_NOT_FOUND;
+    }
+    if (samples.size() < MIN_ROWS) {
+        report_insufficient_data(MIN_ROWS, samples.size());
+        return FUSION_ERROR_INSUFFICIENT_DATA;
+    }
+    
+    std::vector<SweepScore> scores;
+    {
+        StageTimer timer(run_stats().filter_ns);
+        if (!sweep_parameters(samples, params, scores)) {
+            return FUSION_ERROR_INVALID_DATA;
+        }
+    }
+    
+    best_index = 0;
+    for (size_t i = 0; i < scores.size(); i++) {
+        results[i].Q = params[i].Q;
+        results[i].R = params[i].R;
+        results[i].log_likelihood = scores[i].log_likelihood;
+        results[i].innovation_rms_y = scores[i].innovation_rms_y;
+        results[i].innovation_rms_z = scores[i].innovation_rms_z;
+        results[i].updates = scores[i].updates_y + scores[i].updates_z;
+        if (scores[i].log_likelihood > scores[best_index].log_likelihood) {
+            best_index = i;
+        }
+    }
+    
+    if (!best_output_file_path) {
+        return FUSION_SUCCESS;
+    }
+    
+    // 최적 세트만 일반 처리 모드 규칙으로 다시 실행해 저장
+    DualAxisKalmanFilter filter = make_filter(params[best_index]);
+    reset_from_first_batch(samples, filter);
+    std::vector<double> displacement_y(samples.size());
+    std::vector<double> displacement_z(samples.size());
+    {
+        FilterStageRecorder recorder(filter);
+        filter.processBatch(samples.gps_y, samples.gps_z, samples.acc_y, samples.acc_z, samples.fix,
+                            displacement_y, displacement_z, true);
+    }
+    
+    if (!save_output(best_output_file_path, samples.datetime, displacement_y, displacement_z,
+                     g_output_precision.load())) {
+        return FUSION_ERROR_FILE_NOT_FOUND;
+    }
+    
+    LogLine(LogLevel::Info) << "Best parameters (Q=" << params[best_index].Q << ", R=" << params[best_index].R
+                            << ") saved to: " << best_output_file_path;
+    return FUSION_SUCCESS;
+}
+
+// 출력 경로 비교용 키 (존재하는 상위 디렉토리까지 심볼릭 링크를 풀고 ".", ".."를 정리한 절대 경로)
+static std::string output_path_key(const char* output_file_path) {
+    std::error_code error;
+    fs::path path = fs::weakly_canonical(fs::path(output_file_path), error);
+    if (error) {
+        path = fs::path(output_file_path).lexically_normal();
+    }
+    std::string key = path.string();
+#ifdef _WIN32
+    // Windows 파일 시스템은 대소문자를 구분하지 않음
+    std::transform(key.begin(), key.end(), key.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+#endif
+    return key;
+}
+
+// 여러 파일 병렬 처리 내부 구현 함수
+int process_fusion_many_internal(
+    const char* const* input_file_paths,
+    const char* const* output_file_paths,
+    size_t count,
+    double Q,
+    double R,
+    int mode,
+    size_t batch_size,
+    size_t thread_count,
+    int* results) {
+    
+    // 같은 출력 파일을 두 작업이 동시에 쓰지 않도록 중복 경로는 실행하지 않음
+    // ("out.csv", "./out.csv", "dir/../out.csv"처럼 표기만 다른 경로도 같은 파일로 봄)
+    std::vector<bool> runnable(count, true);
+    std::unordered_map<std::string, size_t> seen_outputs;
+    for (size_t i = 0; i < count; i++) {
+        if (!input_file_paths[i] || !output_file_paths[i] ||
+            !seen_outputs.emplace(output_path_key(output_file_paths[i]), i).second) {
+            results[i] = FUSION_ERROR_INVALID_DATA;
+            runnable[i] = false;
+        }
+    }
+    
+    // 파일별 통계는 작업을 실행한 스레드에서 모아 호출 스레드의 통계로 합침 (단계별 시간은 스레드 합계)
+    std::mutex stats_mutex;
+    RunStats total_stats;
+    
+    auto process_one = [&](size_t i) {
+        std::string input_path(input_file_paths[i]);
+        std::string output_path(output_file_paths[i]);
+        RunStats& file_stats = clear_run_stats();
+        try {
+            switch (mode) {
+                case FUSION_MODE_BATCH:
+                    results[i] = process_fusion_batch_internal(input_path, output_path, Q, R, batch_size, false);
+                    break;
+                case FUSION_MODE_REALTIME:
+                    // 같은 디렉토리의 파일끼리 상태가 섞이지 않도록 출력 파일별 상태 파일 사용
+                    results[i] = process_fusion_realtime_internal(
+                        input_path, output_path, Q, R, build_state_file_path(output_path, true));
+                    break;
+                default:
+                    results[i] = process_fusion_internal(input_path, output_path, Q, R, false);
+                    break;
+            }
+        } catch (const std::exception& e) {
+            LogLine(LogLevel::Error) << "Exception in fusion_process_many (" << input_path << "): " << e.what();
+            results[i] = FUSION_ERROR_UNKNOWN;
+        } catch (...) {
+            LogLine(LogLevel::Error) << "Unknown exception in fusion_process_many (" << input_path << ")";
+            results[i] = FUSION_ERROR_UNKNOWN;
+        }
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        total_stats.add(file_stats);
+    };
+    
+    if (thread_count == 0) {
+        thread_count = ThreadPool::default_thread_count();
+    }
+    if (thread_count > count) {
+        thread_count = count;
+    }
+    
+    if (thread_count <= 1) {
+        for (size_t i = 0; i < count; i++) {
+            if (runnable[i]) {
+                process_one(i);
+            }
+        }
+    } else {
+        ThreadPool pool(thread_count);
+        for (size_t i = 0; i < count; i++) {
+            if (runnable[i]) {
+                pool.submit([&process_one, i] { process_one(i); });
+            }
+        }
+        pool.wait();
+    }
+    run_stats() = total_stats;
+    
+    // 전체 결과: 모두 성공하면 FUSION_SUCCESS, 아니면 입력 순서상 첫 번째 오류 코드
+    for (size_t i = 0; i < count; i++) {
+        if (results[i] != FUSION_SUCCESS) {
+            return results[i];
+        }
+    }
+    return FUSION_SUCCESS;
+}
+
+} // namespace fusion
+
+// 스트리밍 필터 핸들 (fusion_stream_*)
+struct FusionStream {
+    explicit FusionStream(const fusion::KalmanParams& params)
+        : filter(fusion::make_filter(params)), initialized(false) {}
+    
+    fusion::DualAxisKalmanFilter filter;
+    bool initialized;  // 초기 위치가 정해졌는지 (복원했거나 첫 push를 처리함)
+};
+
+// C API 구현
+extern "C" {
+
+FUSION_API int fusion_process_csv(
+    const char* input_file_path,
+    const char* output_file_path,
+    double Q,
+    double R) {
+    fusion::RunStatsScope stats_scope;
+    
+    if (!input_file_path || !output_file_path) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    
+    try {
+        return fusion::process_fusion_internal(
+            std::string(input_file_path),
+            std::string(output_file_path),
+            Q,
+            R,
+            true
+        );
+    } catch (const std::exception& e) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Exception in fusion_process_csv: " << e.what();
+        return FUSION_ERROR_UNKNOWN;
+    } catch (...) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Unknown exception in fusion_process_csv";
+        return FUSION_ERROR_UNKNOWN;
+    }
+}
+
+FUSION_API int fusion_process_csv_batch(
+    const char* input_file_path,
+    const char* output_file_path,
+    double Q,
+    double R,
+    size_t batch_size,
+    int save_intermediate) {
+    fusion::RunStatsScope stats_scope;
+    
+    if (!input_file_path || !output_file_path) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    
+    if (batch_size == 0) {
+        batch_size = 100;  // 기본값
     }
     
     try {
@@ -577,10 +1364,10 @@ FUSION_API int fusion_process_csv_batch(
             save_intermediate != 0
         );
     } catch (const std::exception& e) {
-        std::cerr << "Exception in fusion_process_csv_batch: " << e.what() << std::endl;
+        fusion::LogLine(fusion::LogLevel::Error) << "Exception in fusion_process_csv_batch: " << e.what();
         return FUSION_ERROR_UNKNOWN;
     } catch (...) {
-        std::cerr << "Unknown exception in fusion_process_csv_batch" << std::endl;
+        fusion::LogLine(fusion::LogLevel::Error) << "Unknown exception in fusion_process_csv_batch";
         return FUSION_ERROR_UNKNOWN;
     }
 }
@@ -590,6 +1377,7 @@ FUSION_API int fusion_process_csv_realtime(
     const char* output_file_path,
     double Q,
     double R) {
+    fusion::RunStatsScope stats_scope;
     
     if (!input_file_path || !output_file_path) {
         return FUSION_ERROR_INVALID_DATA;
@@ -600,17 +1388,441 @@ FUSION_API int fusion_process_csv_realtime(
             std::string(input_file_path),
             std::string(output_file_path),
             Q,
-            R
+            R,
+            fusion::build_state_file_path(output_file_path)
+        );
+    } catch (const std::exception& e) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Exception in fusion_process_csv_realtime: " << e.what();
+        return FUSION_ERROR_UNKNOWN;
+    } catch (...) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Unknown exception in fusion_process_csv_realtime";
+        return FUSION_ERROR_UNKNOWN;
+    }
+}
+
+FUSION_API int fusion_process_arrays(
+    const double* gps_y,
+    const double* gps_z,
+    const double* acc_y,
+    const double* acc_z,
+    const int* fix,
+    size_t n,
+    double* out_y,
+    double* out_z,
+    size_t input_stride,
+    size_t output_stride,
+    double Q,
+    double R) {
+    fusion::RunStatsScope stats_scope;
+    
+    if (!gps_y || !gps_z || !acc_y || !acc_z || !fix || !out_y || !out_z) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    
+    try {
+        // 간격 0은 각 타입의 연속 배열
+        fusion::StridedSamples samples{
+            gps_y, gps_z, acc_y, acc_z, fix,
+            input_stride ? input_stride : sizeof(double),
+            input_stride ? input_stride : sizeof(int)
+        };
+        fusion::StridedOutput output{out_y, out_z, output_stride ? output_stride : sizeof(double)};
+        return fusion::process_fusion_arrays_internal(samples, n, output, Q, R);
+    } catch (const std::exception& e) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Exception in fusion_process_arrays: " << e.what();
+        return FUSION_ERROR_UNKNOWN;
+    } catch (...) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Unknown exception in fusion_process_arrays";
+        return FUSION_ERROR_UNKNOWN;
+    }
+}
+
+FUSION_API int fusion_stream_create(
+    double Q,
+    double R,
+    const char* state_file_path,
+    FusionStream** stream) {
+    
+    if (!stream) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    *stream = nullptr;
+    
+    try {
+        std::unique_ptr<FusionStream> handle(new FusionStream(fusion::KalmanParams(Q, R)));
+        if (state_file_path) {
+            std::shared_ptr<std::mutex> state_file_mutex = fusion::get_state_file_mutex(state_file_path);
+            std::lock_guard<std::mutex> state_file_lock(*state_file_mutex);
+            fusion::FilterSnapshot snapshot;
+            if (fusion::load_filter_snapshot(state_file_path, snapshot)) {
+                handle->filter.setState(snapshot.state_y, snapshot.state_z);
+                handle->filter.setCovariance(snapshot.cov_y, snapshot.cov_z);
+                handle->initialized = true;
+            }
+        }
+        *stream = handle.release();
+        return FUSION_SUCCESS;
+    } catch (const std::bad_alloc&) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Memory allocation error in fusion_stream_create";
+        return FUSION_ERROR_MEMORY;
+    } catch (const std::exception& e) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Exception in fusion_stream_create: " << e.what();
+        return FUSION_ERROR_UNKNOWN;
+    } catch (...) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Unknown exception in fusion_stream_create";
+        return FUSION_ERROR_UNKNOWN;
+    }
+}
+
+FUSION_API int fusion_stream_push(
+    FusionStream* stream,
+    const FusionSample* samples,
+    size_t n,
+    FusionDisplacement* out) {
+    
+    if (!stream || (n > 0 && (!samples || !out))) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    if (n == 0) {
+        return FUSION_SUCCESS;
+    }
+    
+    fusion::StridedSamples input{
+        &samples[0].gps_y, &samples[0].gps_z, &samples[0].acc_y, &samples[0].acc_z, &samples[0].fix,
+        sizeof(FusionSample), sizeof(FusionSample)
+    };
+    fusion::StridedOutput output{&out[0].displacement_y, &out[0].displacement_z, sizeof(FusionDisplacement)};
+    
+    // 새로 시작한 핸들은 첫 push에서 초기 위치를 정하고 첫 샘플은 초기 상태 그대로 출력
+    bool hold_first = !stream->initialized;
+    if (hold_first) {
+        fusion::reset_from_samples(input, n, stream->filter);
+        stream->initialized = true;
+    }
+    fusion::filter_strided(stream->filter, input, output, n, hold_first);
+    return FUSION_SUCCESS;
+}
+
+FUSION_API int fusion_stream_snapshot(
+    FusionStream* stream,
+    const char* state_file_path) {
+    
+    if (!stream || !state_file_path) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    
+    try {
+        std::shared_ptr<std::mutex> state_file_mutex = fusion::get_state_file_mutex(state_file_path);
+        std::lock_guard<std::mutex> state_file_lock(*state_file_mutex);
+        if (!fusion::write_snapshot(state_file_path, fusion::capture_snapshot(stream->filter))) {
+            fusion::LogLine(fusion::LogLevel::Warning) << "Failed to save state file: " << state_file_path;
+            return FUSION_ERROR_FILE_NOT_FOUND;
+        }
+        return FUSION_SUCCESS;
+    } catch (const std::exception& e) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Exception in fusion_stream_snapshot: " << e.what();
+        return FUSION_ERROR_UNKNOWN;
+    } catch (...) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Unknown exception in fusion_stream_snapshot";
+        return FUSION_ERROR_UNKNOWN;
+    }
+}
+
+FUSION_API void fusion_stream_destroy(FusionStream* stream) {
+    delete stream;
+}
+
+FUSION_API int fusion_process_many(
+    const char* const* input_file_paths,
+    const char* const* output_file_paths,
+    size_t count,
+    double Q,
+    double R,
+    int mode,
+    size_t batch_size,
+    int threads,
+    int* results) {
+    fusion::RunStatsScope stats_scope;
+    
+    if (!input_file_paths || !output_file_paths || !results || threads < 0 ||
+        (mode != FUSION_MODE_NORMAL && mode != FUSION_MODE_BATCH && mode != FUSION_MODE_REALTIME)) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    
+    if (batch_size == 0) {
+        batch_size = 100;  // 기본값
+    }
+    
+    try {
+        return fusion::process_fusion_many_internal(
+            input_file_paths,
+            output_file_paths,
+            count,
+            Q,
+            R,
+            mode,
+            batch_size,
+            static_cast<size_t>(threads),
+            results
+        );
+    } catch (const std::exception& e) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Exception in fusion_process_many: " << e.what();
+        return FUSION_ERROR_UNKNOWN;
+    } catch (...) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Unknown exception in fusion_process_many";
+        return FUSION_ERROR_UNKNOWN;
+    }
+}
+
+FUSION_API int fusion_set_steady_state(int enable, double tolerance) {
+    if (!(tolerance >= 0.0)) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    fusion::g_steady_state_tolerance.store(
+        tolerance > 0.0 ? tolerance : fusion::DEFAULT_STEADY_STATE_TOLERANCE);
+    fusion::g_steady_state_enabled.store(enable != 0);
+    return FUSION_SUCCESS;
+}
+
+FUSION_API int fusion_set_parallel_filter(int enable, int threads) {
+    if (threads < 0) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    fusion::g_parallel_filter_threads.store(static_cast<size_t>(threads));
+    fusion::g_parallel_filter_enabled.store(enable != 0);
+    return FUSION_SUCCESS;
+}
+
+FUSION_API int fusion_set_chunked_filter(size_t chunks, size_t overlap) {
+    fusion::g_chunked_filter_overlap.store(overlap);
+    fusion::g_chunked_filter_chunks.store(chunks);
+    return FUSION_SUCCESS;
+}
+
+FUSION_API int fusion_set_smoothing_lag(size_t lag) {
+    if (lag > fusion::MAX_SMOOTHING_LAG) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    fusion::g_smoothing_lag.store(lag);
+    return FUSION_SUCCESS;
+}
+
+FUSION_API int fusion_steady_state_deviation(
+    const char* input_file_path,
+    double Q,
+    double R,
+    double tolerance,
+    double* max_deviation) {
+    fusion::RunStatsScope stats_scope;
+    
+    if (!input_file_path || !max_deviation || !(tolerance >= 0.0)) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    
+    try {
+        return fusion::measure_steady_state_deviation(
+            std::string(input_file_path),
+            Q,
+            R,
+            tolerance > 0.0 ? tolerance : fusion::DEFAULT_STEADY_STATE_TOLERANCE,
+            *max_deviation
         );
     } catch (const std::exception& e) {
-        std::cerr << "Exception in fusion_process_csv_realtime: " << e.what() << std::endl;
+        fusion::LogLine(fusion::LogLevel::Error) << "Exception in fusion_steady_state_deviation: " << e.what();
         return FUSION_ERROR_UNKNOWN;
     } catch (...) {
-        std::cerr << "Unknown exception in fusion_process_csv_realtime" << std::endl;
+        fusion::LogLine(fusion::LogLevel::Error) << "Unknown exception in fusion_steady_state_deviation";
         return FUSION_ERROR_UNKNOWN;
     }
 }
 
+FUSION_API int fusion_chunked_deviation(
+    const char* input_file_path,
+    double Q,
+    double R,
+    size_t chunks,
+    size_t overlap,
+    double* max_deviation) {
+    fusion::RunStatsScope stats_scope;
+    
+    if (!input_file_path || !max_deviation) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    
+    try {
+        return fusion::measure_chunked_deviation(
+            std::string(input_file_path),
+            Q,
+            R,
+            chunks,
+            overlap,
+            *max_deviation
+        );
+    } catch (const std::exception& e) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Exception in fusion_chunked_deviation: " << e.what();
+        return FUSION_ERROR_UNKNOWN;
+    } catch (...) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Unknown exception in fusion_chunked_deviation";
+        return FUSION_ERROR_UNKNOWN;
+    }
+}
+
+FUSION_API int fusion_sweep_parameters(
+    const char* input_file_path,
+    const double* Q_values,
+    const double* R_values,
+    size_t count,
+    FusionSweepResult* results,
+    const char* best_output_file_path,
+    size_t* best_index) {
+    fusion::RunStatsScope stats_scope;
+    
+    if (!input_file_path || !Q_values || !R_values || !results || count == 0) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    
+    try {
+        std::vector<fusion::KalmanParams> params;
+        params.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            params.emplace_back(Q_values[i], R_values[i]);
+        }
+        
+        size_t best = 0;
+        int result = fusion::sweep_parameters_internal(
+            std::string(input_file_path),
+            params,
+            results,
+            best_output_file_path,
+            best
+        );
+        if (result == FUSION_SUCCESS && best_index) {
+            *best_index = best;
+        }
+        return result;
+    } catch (const std::exception& e) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Exception in fusion_sweep_parameters: " << e.what();
+        return FUSION_ERROR_UNKNOWN;
+    } catch (...) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Unknown exception in fusion_sweep_parameters";
+        return FUSION_ERROR_UNKNOWN;
+    }
+}
+
+FUSION_API int fusion_set_snapshot_format(int format) {
+    if (format != FUSION_SNAPSHOT_BINARY && format != FUSION_SNAPSHOT_TEXT) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    fusion::g_snapshot_format.store(format);
+    return FUSION_SUCCESS;
+}
+
+FUSION_API int fusion_set_checkpoint_interval(size_t rows, double seconds) {
+    if (!(seconds >= 0.0)) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    fusion::g_checkpoint_rows.store(rows);
+    fusion::g_checkpoint_seconds.store(seconds);
+    return FUSION_SUCCESS;
+}
+
+FUSION_API int fusion_convert_csv_to_binary(
+    const char* input_file_path,
+    const char* output_file_path,
+    size_t* rows_converted) {
+    fusion::RunStatsScope stats_scope;
+    
+    if (!input_file_path || !output_file_path) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    
+    try {
+        if (!fusion::convert_csv_to_columnar(input_file_path, output_file_path, rows_converted)) {
+            return FUSION_ERROR_FILE_NOT_FOUND;
+        }
+        return FUSION_SUCCESS;
+    } catch (const std::bad_alloc&) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Memory allocation error in fusion_convert_csv_to_binary";
+        return FUSION_ERROR_MEMORY;
+    } catch (const std::exception& e) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Exception in fusion_convert_csv_to_binary: " << e.what();
+        return FUSION_ERROR_UNKNOWN;
+    } catch (...) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Unknown exception in fusion_convert_csv_to_binary";
+        return FUSION_ERROR_UNKNOWN;
+    }
+}
+
+FUSION_API int fusion_export_snapshot_text(
+    const char* state_file_path,
+    const char* text_file_path) {
+    
+    if (!state_file_path || !text_file_path) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    
+    try {
+        fusion::FilterSnapshot snapshot;
+        {
+            std::shared_ptr<std::mutex> state_file_mutex = fusion::get_state_file_mutex(state_file_path);
+            std::lock_guard<std::mutex> state_file_lock(*state_file_mutex);
+            if (!fusion::load_filter_snapshot(state_file_path, snapshot)) {
+                return FUSION_ERROR_FILE_NOT_FOUND;
+            }
+        }
+        if (!fusion::save_filter_snapshot(text_file_path, snapshot, fusion::SnapshotFormat::Text)) {
+            return FUSION_ERROR_FILE_NOT_FOUND;
+        }
+        return FUSION_SUCCESS;
+    } catch (const std::exception& e) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Exception in fusion_export_snapshot_text: " << e.what();
+        return FUSION_ERROR_UNKNOWN;
+    } catch (...) {
+        fusion::LogLine(fusion::LogLevel::Error) << "Unknown exception in fusion_export_snapshot_text";
+        return FUSION_ERROR_UNKNOWN;
+    }
+}
+
+FUSION_API int fusion_set_output_precision(int precision) {
+    if (precision < fusion::SHORTEST_OUTPUT_PRECISION || precision > fusion::MAX_OUTPUT_PRECISION) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    fusion::g_output_precision.store(precision);
+    return FUSION_SUCCESS;
+}
+
+FUSION_API int fusion_get_output_precision(void) {
+    return fusion::g_output_precision.load();
+}
+
+FUSION_API int fusion_set_log_callback(int min_level, FusionLogCallback callback, void* user_data) {
+    if (min_level < FUSION_LOG_DEBUG || min_level > FUSION_LOG_ERROR) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    fusion::set_log_callback(static_cast<fusion::LogLevel>(min_level), callback, user_data);
+    return FUSION_SUCCESS;
+}
+
+FUSION_API int fusion_get_last_stats(FusionStats* stats) {
+    if (!stats) {
+        return FUSION_ERROR_INVALID_DATA;
+    }
+    const fusion::RunStats& last = fusion::run_stats();
+    stats->total_ns = last.total_ns;
+    stats->parse_ns = last.parse_ns;
+    stats->filter_ns = last.filter_ns;
+    stats->write_ns = last.write_ns;
+    stats->snapshot_ns = last.snapshot_ns;
+    stats->rows_parsed = last.rows_parsed;
+    stats->rows_rejected = last.rows_rejected;
+    stats->gps_updates = last.gps_updates;
+    stats->predict_only_steps = last.predict_only_steps;
+    stats->bytes_read = last.bytes_read;
+    stats->bytes_written = last.bytes_written;
+    stats->snapshot_writes = last.snapshot_writes;
+    return FUSION_SUCCESS;
+}
+
 FUSION_API const char* fusion_get_error_message(int error_code) {
     switch (error_code) {
         case FUSION_SUCCESS:
@@ -0,0 +1,73 @@
+#include "fusion_log.h"
+#include <atomic>
+#include <mutex>
+#include <utility>
+
+namespace fusion {
+
+namespace {
+
+// 콜백이 없을 때의 최소 심각도 (어떤 메시지도 통과하지 못함)
+const int LOG_DISABLED = static_cast<int>(LogLevel::Error) + 1;
+
+std::mutex g_log_mutex;
+std::atomic<int> g_min_level{LOG_DISABLED};
+LogCallback g_callback = nullptr;
+void* g_user_data = nullptr;
+
+} // namespace
+
+void set_log_callback(LogLevel min_level, LogCallback callback, void* user_data) {
+    std::lock_guard<std::mutex> lock(g_log_mutex);
+    g_callback = callback;
+    g_user_data = user_data;
+    g_min_level.store(callback ? static_cast<int>(min_level) : LOG_DISABLED);
+}
+
+bool log_enabled(LogLevel level) {
+    return static_cast<int>(level) >= g_min_level.load(std::memory_order_relaxed);
+}
+
+void log_message(LogLevel level, const std::string& message) {
+    if (!log_enabled(level)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(g_log_mutex);
+    // 잠금을 기다리는 사이 콜백이 바뀌었을 수 있으므로 다시 확인
+    if (g_callback && static_cast<int>(level) >= g_min_level.load()) {
+        g_callback(static_cast<int>(level), message.c_str(), g_user_data);
+    }
+}
+
+LogLine::LogLine(LogLevel level) : level_(level) {
+    if (log_enabled(level)) {
+        stream_.reset(new std::ostringstream());
+    }
+}
+
+LogLine::~LogLine() {
+    if (stream_) {
+        log_message(level_, stream_->str());
+    }
+}
+
+WarningLimiter::WarningLimiter(std::string summary, size_t limit)
+    : summary_(std::move(summary)), limit_(limit) {}
+
+WarningLimiter::~WarningLimiter() {
+    flush();
+}
+
+bool WarningLimiter::should_report() {
+    count_++;
+    return count_ <= limit_ && log_enabled(LogLevel::Warning);
+}
+
+void WarningLimiter::flush() {
+    if (count_ > limit_) {
+        LogLine(LogLevel::Warning) << summary_ << ": " << (count_ - limit_) << " more suppressed";
+    }
+    count_ = 0;
+}
+
+} // namespace fusion
@@ -0,0 +1,105 @@
+#ifndef FUSION_LOG_H
+#define FUSION_LOG_H
+
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace fusion {
+
+// 로그 심각도 (FusionLogLevel과 같은 값)
+enum class LogLevel {
+    Debug = 0,
+    Info = 1,
+    Warning = 2,
+    Error = 3
+};
+
+// 로그 콜백 (FusionLogCallback과 같은 형태)
+typedef void (*LogCallback)(int level, const char* message, void* user_data);
+
+/**
+ * 로그 콜백 설정
+ *
+ * 콜백이 없으면(기본값) 모든 메시지를 버린다.
+ * 콜백 호출은 내부 뮤텍스로 직렬화되므로 콜백은 스레드 안전하지 않아도 된다.
+ *
+ * @param min_level 전달할 최소 심각도
+ * @param callback 로그 콜백 (nullptr이면 로그 끔)
+ * @param user_data 콜백에 그대로 전달할 사용자 포인터
+ */
+void set_log_callback(LogLevel min_level, LogCallback callback, void* user_data);
+
+/**
+ * 해당 심각도의 메시지가 콜백으로 전달되는지 여부 (메시지 포맷 전에 확인하는 용도)
+ */
+bool log_enabled(LogLevel level);
+
+/**
+ * 메시지 하나를 콜백으로 전달
+ */
+void log_message(LogLevel level, const std::string& message);
+
+/**
+ * 스트림 형식으로 메시지 한 줄을 만들어 소멸 시 전달
+ *
+ * 해당 심각도가 꺼져 있으면 포맷 버퍼를 만들지 않는다.
+ */
+class LogLine {
+public:
+    explicit LogLine(LogLevel level);
+    ~LogLine();
+
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    template <typename T>
+    LogLine& operator<<(const T& value) {
+        if (stream_) {
+            *stream_ << value;
+        }
+        return *this;
+    }
+
+private:
+    LogLevel level_;
+    std::unique_ptr<std::ostringstream> stream_;
+};
+
+// 같은 종류의 경고를 개별로 전달하는 최대 횟수
+constexpr size_t DEFAULT_WARNING_LIMIT = 5;
+
+/**
+ * 반복되는 경고의 빈도 제한
+ *
+ * 처음 limit번은 개별 경고를 허용하고, 이후 발생 횟수만 세어 두었다가
+ * flush() 또는 소멸 시 "<summary>: N more suppressed" 형태의 경고 하나로 모아 전달한다.
+ */
+class WarningLimiter {
+public:
+    explicit WarningLimiter(std::string summary, size_t limit = DEFAULT_WARNING_LIMIT);
+    ~WarningLimiter();
+
+    WarningLimiter(const WarningLimiter&) = delete;
+    WarningLimiter& operator=(const WarningLimiter&) = delete;
+
+    /**
+     * 경고 발생을 기록하고, 개별 경고를 전달해야 하면 true 반환
+     */
+    bool should_report();
+
+    /**
+     * 생략된 경고 수를 전달하고 카운터 초기화
+     */
+    void flush();
+
+private:
+    std::string summary_;
+    size_t limit_;
+    size_t count_ = 0;
+};
+
+} // namespace fusion
+
+#endif // FUSION_LOG_H
@@ -2,14 +2,18 @@
 #define KALMAN_FILTER_H
 
 #include "data_structures.h"
+#include "kalman_models.h"
 #include <vector>
 
 namespace fusion {
 
 /**
- * 칼만 필터 클래스
+ * 칼만 필터 클래스 (2상태 등가속도 입력 모델, KalmanFilterT<ConstantVelocityModel>)
+ *
+ * 예측만 하는 구간의 공분산은 다음 GPS 업데이트 직전에 닫힌 형식으로 한 번에 예측한다
+ * (DualAxisKalmanFilter와 같은 규칙).
  */
-class KalmanFilter {
+class KalmanFilter : public KalmanFilterT<ConstantVelocityModel> {
 public:
     KalmanFilter(const KalmanParams& params);
     
@@ -27,30 +31,30 @@ public:
         const std::vector<int>& fix_data
     );
     
-    /**
-     * 필터 상태 초기화
-     */
-    void reset(double initial_position);
-    
     /**
      * 현재 상태 가져오기
      */
-    KalmanState getState() const { return state_; }
+    KalmanState getState() const {
+        const Vector& state = getStateVector();
+        return KalmanState{state[0], state[1]};
+    }
     
     /**
      * 상태 설정하기
      */
-    void setState(const KalmanState& state) { state_ = state; }
+    void setState(const KalmanState& state) { setStateVector(Vector{{state.position, state.velocity}}); }
     
     /**
      * 현재 공분산 가져오기
      */
-    KalmanCovariance getCovariance() const { return covariance_; }
+    KalmanCovariance getCovariance() const;
     
     /**
      * 공분산 설정하기
      */
-    void setCovariance(const KalmanCovariance& cov) { covariance_ = cov; }
+    void setCovariance(const KalmanCovariance& cov) {
+        setCovarianceMatrix(Matrix{{{cov.p00, cov.p01}, {cov.p10, cov.p11}}});
+    }
     
     /**
      * 배치 처리를 위한 데이터 처리 (초기화 없이)
@@ -65,14 +69,13 @@ public:
         const std::vector<double>& acc_data,
         const std::vector<int>& fix_data
     );
-
-private:
-    KalmanParams params_;
-    KalmanState state_;
-    KalmanCovariance covariance_;
     
-    void predict(double acc_input);
-    void update(double gps_measurement);
+    /**
+     * 배치 처리 (Span 입력, 호출자 출력 버퍼 사용, 스트리밍 처리용)
+     * 
+     * SampleBlock 컬럼이나 호출자 버퍼를 복사 없이 그대로 읽는다 (KalmanFilterT::processBatch).
+     */
+    using KalmanFilterT<ConstantVelocityModel>::processBatch;
 };
 
 } // namespace fusion
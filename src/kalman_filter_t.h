@@ -0,0 +1,293 @@
+#ifndef KALMAN_FILTER_T_H
+#define KALMAN_FILTER_T_H
+
+#include "data_structures.h"
+#include "fusion_log.h"
+#include <cmath>
+#include <cstddef>
+
+namespace fusion {
+
+// 가속도계를 측정으로 쓰지 않는 모델의 ACC_STATE 값 (가속도는 제어 입력)
+constexpr size_t NO_STATE = static_cast<size_t>(-1);
+
+// 고정 크기 상태 벡터 (스택에 저장, 루프 범위가 상수라 컴파일러가 모두 펼침)
+template <size_t N>
+struct FixedVector {
+    double v[N];
+
+    double& operator[](size_t i) { return v[i]; }
+    double operator[](size_t i) const { return v[i]; }
+};
+
+// 고정 크기 정방 행렬 (행 우선)
+template <size_t N>
+struct FixedMatrix {
+    double m[N][N];
+
+    double* operator[](size_t row) { return m[row]; }
+    const double* operator[](size_t row) const { return m[row]; }
+
+    static FixedMatrix identity() {
+        FixedMatrix result;
+        for (size_t r = 0; r < N; r++) {
+            for (size_t c = 0; c < N; c++) {
+                result.m[r][c] = r == c ? 1.0 : 0.0;
+            }
+        }
+        return result;
+    }
+};
+
+/**
+ * 공분산 한 단계 예측: P = F * P * F^T + diag(q)
+ */
+template <size_t N>
+inline void predict_covariance_step(FixedMatrix<N>& p, const FixedMatrix<N>& f, const FixedVector<N>& q) {
+    FixedMatrix<N> fp;
+    for (size_t r = 0; r < N; r++) {
+        for (size_t c = 0; c < N; c++) {
+            double sum = f[r][0] * p[0][c];
+            for (size_t j = 1; j < N; j++) {
+                sum += f[r][j] * p[j][c];
+            }
+            fp[r][c] = sum;
+        }
+    }
+    for (size_t r = 0; r < N; r++) {
+        for (size_t c = 0; c < N; c++) {
+            double sum = fp[r][0] * f[c][0];
+            for (size_t j = 1; j < N; j++) {
+                sum += fp[r][j] * f[c][j];
+            }
+            p[r][c] = r == c ? sum + q[r] : sum;
+        }
+    }
+}
+
+/**
+ * 공분산 steps단계 예측 (닫힌 형식이 없는 모델용, 한 단계씩 반복)
+ */
+template <size_t N>
+inline void predict_covariance_repeated(FixedMatrix<N>& p, size_t steps, const FixedMatrix<N>& f,
+                                        const FixedVector<N>& q) {
+    for (size_t step = 0; step < steps; step++) {
+        predict_covariance_step(p, f, q);
+    }
+}
+
+/**
+ * 상태 하나를 직접 측정하는 스칼라 업데이트 (H = e_index)
+ *
+ * P = (I - K * H) * P_pred를 그대로 계산한다. 2상태 모델에서 index = 0이면
+ * 기존 KalmanFilter::update와 연산 순서가 같아 결과가 비트 단위로 같다.
+ *
+ * @param index 측정하는 상태 인덱스
+ * @param measurement 측정값
+ * @param noise 측정 노이즈 분산
+ */
+template <size_t N>
+inline void update_component(FixedVector<N>& x, FixedMatrix<N>& p, size_t index, double measurement, double noise) {
+    // 잔차와 잔차 공분산: y = z - H * x, S = H * P * H^T + R
+    double y = measurement - x[index];
+    double s = p[index][index] + noise;
+
+    // 칼만 게인: K = P * H^T * S^(-1)
+    double k[N];
+    for (size_t r = 0; r < N; r++) {
+        k[r] = p[r][index] / s;
+    }
+    for (size_t r = 0; r < N; r++) {
+        x[r] = x[r] + k[r] * y;
+    }
+
+    // (I - K * H)의 r행 j열
+    auto gain_term = [&](size_t r, size_t j) {
+        if (j == index) {
+            return r == j ? 1.0 - k[r] : -k[r];
+        }
+        return r == j ? 1.0 : 0.0;
+    };
+
+    FixedMatrix<N> updated;
+    for (size_t r = 0; r < N; r++) {
+        for (size_t c = 0; c < N; c++) {
+            double sum = gain_term(r, 0) * p[0][c];
+            for (size_t j = 1; j < N; j++) {
+                sum += gain_term(r, j) * p[j][c];
+            }
+            updated[r][c] = sum;
+        }
+    }
+    p = updated;
+}
+
+/**
+ * 모델을 컴파일 시간에 고정한 칼만 필터
+ *
+ * 상태 차원과 모델 연산이 컴파일 시간에 정해지므로 상태/공분산은 고정 크기 배열로 스택에 두고
+ * 예측/업데이트는 모두 인라인되어 펼쳐진다. GPS는 상태 0(위치)을 측정한다 (H = e0, 노이즈 R).
+ * 예측만 하는 구간의 공분산은 다음 업데이트 직전에 모델의 predict_covariance로 한 번에 예측한다.
+ *
+ * Model 요구 사항:
+ *   static constexpr size_t STATE_DIM   상태 차원
+ *   static constexpr double FIXED_DT    0보다 크면 컴파일 시간 dt (KalmanParams::dt 대신 사용, FixedDt 참고)
+ *   static constexpr size_t ACC_STATE   가속도계를 측정으로 쓰는 상태 인덱스 (NO_STATE면 제어 입력)
+ *   void predict_state(FixedVector<N>& x, double acc, double dt) const
+ *   void predict_covariance(FixedMatrix<N>& p, size_t steps, double dt, double q) const
+ *   double acc_variance                 가속도 측정 노이즈 분산 (ACC_STATE가 있을 때만)
+ */
+template <typename Model>
+class KalmanFilterT {
+public:
+    static constexpr size_t STATE_DIM = Model::STATE_DIM;
+    using Vector = FixedVector<STATE_DIM>;
+    using Matrix = FixedMatrix<STATE_DIM>;
+
+    explicit KalmanFilterT(const KalmanParams& params, const Model& model = Model())
+        : params_(params), model_(model) {
+        // 초기 상태는 나중에 reset()에서 설정됨
+        reset(0.0);
+    }
+
+    /**
+     * 필터 상태 초기화 (위치만 설정, 나머지 상태는 0, 공분산은 단위 행렬)
+     */
+    void reset(double initial_position) {
+        for (size_t i = 0; i < STATE_DIM; i++) {
+            state_[i] = 0.0;
+        }
+        state_[0] = initial_position;
+        covariance_ = Matrix::identity();
+        pending_covariance_steps_ = 0;
+    }
+
+    const Vector& getStateVector() const { return state_; }
+    void setStateVector(const Vector& state) { state_ = state; }
+
+    /**
+     * 현재 공분산 (미룬 예측을 적용한 값)
+     */
+    Matrix getCovarianceMatrix() const {
+        Matrix cov = covariance_;
+        model_.predict_covariance(cov, pending_covariance_steps_, dt(), params_.Q);
+        return cov;
+    }
+
+    void setCovarianceMatrix(const Matrix& cov) {
+        covariance_ = cov;
+        pending_covariance_steps_ = 0;
+    }
+
+    const KalmanParams& getParams() const { return params_; }
+    const Model& getModel() const { return model_; }
+
+    /**
+     * 샘플 간격 (모델에 컴파일 시간 dt가 있으면 그 값)
+     */
+    double dt() const {
+        if constexpr (Model::FIXED_DT > 0.0) {
+            return Model::FIXED_DT;
+        } else {
+            return params_.dt;
+        }
+    }
+
+    /**
+     * 예측 단계 (가속도 입력 또는 가속도 측정)
+     */
+    void predict(double acc_input) {
+        predictSample(state_, covariance_, pending_covariance_steps_, acc_input, dt());
+    }
+
+    /**
+     * GPS 업데이트 단계 (위치 측정)
+     */
+    void update(double gps_measurement) {
+        updateSample(state_, covariance_, pending_covariance_steps_, gps_measurement, dt());
+    }
+
+    /**
+     * 배치 처리 (KalmanFilter::processBatch와 같은 규칙)
+     *
+     * @param hold_first true면 첫 샘플은 현재 상태를 그대로 출력,
+     *                   false면 첫 샘플부터 예측/업데이트 수행 (이전 배치에 이어서 처리)
+     * @return 입력/출력 크기가 맞지 않으면 false
+     */
+    bool processBatch(
+        Span<const double> gps_data,
+        Span<const double> acc_data,
+        Span<const int> fix_data,
+        Span<double> displacement,
+        bool hold_first) {
+
+        size_t n = gps_data.size();
+        if (n != acc_data.size() || n != fix_data.size() || n != displacement.size()) {
+            LogLine(LogLevel::Error) << "GPS, ACC, and Fix data size mismatch";
+            return false;
+        }
+
+        if (n == 0) {
+            return true;
+        }
+
+        size_t start = 0;
+        if (hold_first) {
+            // 첫 번째 데이터는 현재 상태 사용 (초기화 없음)
+            displacement[0] = state_[0];
+            start = 1;
+        }
+
+        // 출력 버퍼와의 별칭 때문에 멤버를 매 샘플 다시 읽지 않도록 지역 변수에서 처리
+        Vector state = state_;
+        Matrix cov = covariance_;
+        size_t pending = pending_covariance_steps_;
+        const double step = dt();
+
+        for (size_t i = start; i < n; i++) {
+            predictSample(state, cov, pending, acc_data[i], step);
+
+            // Fix >= 1이고 GPS 데이터가 유효한 경우에만 업데이트
+            if (fix_data[i] >= 1 && std::isfinite(gps_data[i])) {
+                updateSample(state, cov, pending, gps_data[i], step);
+            }
+
+            displacement[i] = state[0];
+        }
+
+        state_ = state;
+        covariance_ = cov;
+        pending_covariance_steps_ = pending;
+        return true;
+    }
+
+private:
+    void predictSample(Vector& state, Matrix& cov, size_t& pending, double acc_input, double step) const {
+        model_.predict_state(state, acc_input, step);
+        pending++;
+
+        if constexpr (Model::ACC_STATE != NO_STATE) {
+            if (std::isfinite(acc_input)) {
+                model_.predict_covariance(cov, pending, step, params_.Q);
+                pending = 0;
+                update_component(state, cov, Model::ACC_STATE, acc_input, model_.acc_variance);
+            }
+        }
+    }
+
+    void updateSample(Vector& state, Matrix& cov, size_t& pending, double gps_measurement, double step) const {
+        model_.predict_covariance(cov, pending, step, params_.Q);
+        pending = 0;
+        update_component(state, cov, 0, gps_measurement, params_.R);
+    }
+
+    KalmanParams params_;
+    Model model_;
+    Vector state_;
+    Matrix covariance_;
+    size_t pending_covariance_steps_ = 0;   // covariance_에 아직 적용하지 않은 공분산 예측 횟수
+};
+
+} // namespace fusion
+
+#endif // KALMAN_FILTER_T_H
@@ -0,0 +1,134 @@
+#ifndef KALMAN_LANES_H
+#define KALMAN_LANES_H
+
+#include "data_structures.h"
+#include "simd_vec2.h"
+
+namespace fusion {
+
+/**
+ * 2개 레인 칼만 예측/업데이트 커널 (내부용)
+ *
+ * DualAxisKalmanFilter(레인 = 축)와 파라미터 스윕(레인 = 파라미터 세트)이 공유한다.
+ * KalmanFilter::predict/update와 같은 연산 순서를 유지해야 결과가 비트 단위로 일치한다.
+ */
+
+// 필터 상수
+struct FilterConstants {
+    Vec2 dt;
+    Vec2 dt_dt;
+    Vec2 half_dt_dt;
+    Vec2 q;
+    Vec2 r;
+    Vec2 zero;
+    Vec2 one;
+
+    // 두 레인이 같은 파라미터를 사용 (Y/Z 축)
+    explicit FilterConstants(const KalmanParams& params)
+        : dt(splat2(params.dt)),
+          dt_dt(splat2(params.dt * params.dt)),
+          half_dt_dt(splat2(0.5 * params.dt * params.dt)),
+          q(splat2(params.Q)),
+          r(splat2(params.R)),
+          zero(splat2(0.0)),
+          one(splat2(1.0)) {}
+
+    // 레인마다 Q, R이 다른 경우 (파라미터 스윕, dt는 lane0 기준으로 공유)
+    FilterConstants(const KalmanParams& lane0_params, const KalmanParams& lane1_params)
+        : dt(splat2(lane0_params.dt)),
+          dt_dt(splat2(lane0_params.dt * lane0_params.dt)),
+          half_dt_dt(splat2(0.5 * lane0_params.dt * lane0_params.dt)),
+          q(make2(lane0_params.Q, lane1_params.Q)),
+          r(make2(lane0_params.R, lane1_params.R)),
+          zero(splat2(0.0)),
+          one(splat2(1.0)) {}
+};
+
+struct Covariance2 {
+    Vec2 p00, p01, p10, p11;
+};
+
+// 상태 예측: x_pred = F * x + B * u
+inline void predict_state(Vec2& pos, Vec2& vel, Vec2 acc, const FilterConstants& c) {
+    pos = pos + c.dt * vel + c.half_dt_dt * acc;
+    vel = vel + c.dt * acc;
+}
+
+// 상태 예측 (정상 상태 모드용): 위치 항을 먼저 더해 샘플 간 의존 체인을 덧셈 1회로 줄임
+// 덧셈 순서만 달라 전체 필터와 마지막 비트 수준의 차이가 날 수 있음
+inline void predict_state_reassociated(Vec2& pos, Vec2& vel, Vec2 acc, const FilterConstants& c) {
+    pos = pos + (c.dt * vel + c.half_dt_dt * acc);
+    vel = vel + c.dt * acc;
+}
+
+// 공분산 예측: P_pred = F * P * F^T + Q
+inline void predict_covariance(Covariance2& p, const FilterConstants& c) {
+    Vec2 p00_new = p.p00 + c.dt * (p.p01 + p.p10) + c.dt_dt * p.p11 + c.q;
+    p.p01 = p.p01 + c.dt * p.p11;
+    p.p10 = p.p10 + c.dt * p.p11;
+    p.p11 = p.p11 + c.q;
+    p.p00 = p00_new;
+}
+
+// 공분산 k단계 예측 (닫힌 형식): P = F^k * P * F^kT + sum_{i<k} F^i * Q * F^iT
+// F^k = [[1, k*dt], [0, 1]]이므로 누적 프로세스 노이즈는 k, k(k-1)/2, k(k-1)(2k-1)/6로 정리된다.
+// GPS 업데이트가 없는 구간을 한 번에 건너뛰는 데 사용하며, k = 1이면 predict_covariance와 비트 단위로 같다.
+// ConstantVelocityModel::predict_covariance와 같은 연산 순서
+inline void predict_covariance_steps(Covariance2& p, size_t steps, const FilterConstants& c) {
+    if (steps == 0) {
+        return;
+    }
+    double k = static_cast<double>(steps);
+    double dt = lane0(c.dt);
+    double s1 = k * (k - 1.0) * 0.5;
+    double s2 = s1 * (2.0 * k - 1.0) / 3.0;
+    Vec2 t = splat2(k * dt);
+    Vec2 t_t = t * t;
+    Vec2 q00 = c.q * splat2(k + (dt * dt) * s2);
+    Vec2 q01 = c.q * splat2(dt * s1);
+    Vec2 q11 = c.q * splat2(k);
+
+    Vec2 p00_new = p.p00 + t * (p.p01 + p.p10) + t_t * p.p11 + q00;
+    p.p01 = p.p01 + t * p.p11 + q01;
+    p.p10 = p.p10 + t * p.p11 + q01;
+    p.p11 = p.p11 + q11;
+    p.p00 = p00_new;
+}
+
+// 측정 업데이트 (valid 레인에만 적용), 사용한 게인을 k0/k1로 돌려줌
+inline void update_full(Vec2& pos, Vec2& vel, Covariance2& p, Vec2 gps, Mask2 valid,
+                        const FilterConstants& c, Vec2& k0, Vec2& k1) {
+    Vec2 y = gps - pos;
+    Vec2 s = p.p00 + c.r;
+    k0 = p.p00 / s;
+    k1 = p.p10 / s;
+
+    Vec2 pos_upd = pos + k0 * y;
+    Vec2 vel_upd = vel + k1 * y;
+
+    // P = (I - K * H) * P_pred
+    Vec2 i_kh_00 = c.one - k0;
+    Vec2 i_kh_10 = -k1;
+    Vec2 p00_upd = i_kh_00 * p.p00 + c.zero * p.p10;
+    Vec2 p01_upd = i_kh_00 * p.p01 + c.zero * p.p11;
+    Vec2 p10_upd = i_kh_10 * p.p00 + p.p10;
+    Vec2 p11_upd = i_kh_10 * p.p01 + p.p11;
+
+    pos = select2(valid, pos_upd, pos);
+    vel = select2(valid, vel_upd, vel);
+    p.p00 = select2(valid, p00_upd, p.p00);
+    p.p01 = select2(valid, p01_upd, p.p01);
+    p.p10 = select2(valid, p10_upd, p.p10);
+    p.p11 = select2(valid, p11_upd, p.p11);
+}
+
+// 정상 상태 게인으로 상태만 업데이트 (공분산은 고정점에 머무름)
+inline void update_cached(Vec2& pos, Vec2& vel, Vec2 gps, Vec2 k0, Vec2 k1) {
+    Vec2 y = gps - pos;
+    pos = pos + k0 * y;
+    vel = vel + k1 * y;
+}
+
+} // namespace fusion
+
+#endif // KALMAN_LANES_H
@@ -0,0 +1,139 @@
+#ifndef KALMAN_MODELS_H
+#define KALMAN_MODELS_H
+
+#include "kalman_filter_t.h"
+
+namespace fusion {
+
+/**
+ * 등가속도 입력 2상태 모델 (기존 KalmanFilter 모델)
+ *
+ * x = [위치, 속도], 가속도는 제어 입력
+ * F = [[1, dt], [0, 1]], B = [0.5 * dt^2, dt], 프로세스 노이즈 Q * I
+ */
+struct ConstantVelocityModel {
+    static constexpr size_t STATE_DIM = 2;
+    static constexpr double FIXED_DT = 0.0;
+    static constexpr size_t ACC_STATE = NO_STATE;
+
+    // 예측 단계: x_pred = F * x + B * u
+    void predict_state(FixedVector<2>& x, double acc, double dt) const {
+        double new_position = x[0] + dt * x[1] + 0.5 * dt * dt * acc;
+        double new_velocity = x[1] + dt * acc;
+        x[0] = new_position;
+        x[1] = new_velocity;
+    }
+
+    // k단계 공분산 예측 (닫힌 형식, KalmanFilter와 같은 연산 순서)
+    void predict_covariance(FixedMatrix<2>& p, size_t steps, double dt, double q) const {
+        if (steps == 0) {
+            return;
+        }
+
+        // P = F^k * P * F^kT + sum_{i<k} F^i * Q * F^iT, F^k = [[1.0, k*dt], [0.0, 1.0]]
+        // F^i * Q * F^iT = Q * [[1 + i^2*dt^2, i*dt], [i*dt, 1]]을 i에 대해 더한 닫힌 형식
+        double k = static_cast<double>(steps);
+        double s1 = k * (k - 1.0) * 0.5;                 // sum i
+        double s2 = s1 * (2.0 * k - 1.0) / 3.0;          // sum i^2
+        double t = k * dt;
+        double t_t = t * t;
+        double q00 = q * (k + (dt * dt) * s2);
+        double q01 = q * (dt * s1);
+        double q11 = q * k;
+
+        double p00_new = p[0][0] + t * (p[0][1] + p[1][0]) + t_t * p[1][1] + q00;
+        double p01_new = p[0][1] + t * p[1][1] + q01;
+        double p10_new = p[1][0] + t * p[1][1] + q01;
+        double p11_new = p[1][1] + q11;
+
+        p[0][0] = p00_new;
+        p[0][1] = p01_new;
+        p[1][0] = p10_new;
+        p[1][1] = p11_new;
+    }
+};
+
+/**
+ * 가속도계 바이어스 추정 3상태 모델
+ *
+ * x = [위치, 속도, 가속도 바이어스], 실제 가속도 = 측정 가속도 - 바이어스
+ * F = [[1, dt, -0.5 * dt^2], [0, 1, -dt], [0, 0, 1]], 프로세스 노이즈 diag(Q, Q, bias_variance)
+ * 바이어스는 GPS 위치 잔차로만 관측되므로 GPS가 드문 구간에서 가속도 적분 드리프트를 줄인다.
+ */
+struct AccelBiasModel {
+    static constexpr size_t STATE_DIM = 3;
+    static constexpr double FIXED_DT = 0.0;
+    static constexpr size_t ACC_STATE = NO_STATE;
+
+    double bias_variance = 1e-6;    // 바이어스 랜덤 워크의 샘플당 분산
+
+    void predict_state(FixedVector<3>& x, double acc, double dt) const {
+        double corrected = acc - x[2];
+        double new_position = x[0] + dt * x[1] + 0.5 * dt * dt * corrected;
+        double new_velocity = x[1] + dt * corrected;
+        x[0] = new_position;
+        x[1] = new_velocity;
+    }
+
+    void predict_covariance(FixedMatrix<3>& p, size_t steps, double dt, double q) const {
+        FixedMatrix<3> f = FixedMatrix<3>::identity();
+        f[0][1] = dt;
+        f[0][2] = -0.5 * dt * dt;
+        f[1][2] = -dt;
+        predict_covariance_repeated(p, steps, f, FixedVector<3>{{q, q, bias_variance}});
+    }
+};
+
+/**
+ * 등저크 4상태 모델
+ *
+ * x = [위치, 속도, 가속도, 저크], 저크가 일정하다고 보고 가속도계는 가속도 상태의 측정으로 사용
+ * (노이즈 acc_variance). F는 dt에 대한 3차 테일러 전개, 프로세스 노이즈 Q * I.
+ * 가속도 측정이 매 샘플 공분산을 갱신하므로 예측만 하는 구간이 없다.
+ */
+struct ConstantJerkModel {
+    static constexpr size_t STATE_DIM = 4;
+    static constexpr double FIXED_DT = 0.0;
+    static constexpr size_t ACC_STATE = 2;
+
+    double acc_variance = 0.01;     // 가속도 측정 노이즈 분산
+
+    void predict_state(FixedVector<4>& x, double /*acc*/, double dt) const {
+        double dt2 = 0.5 * dt * dt;
+        double dt3 = dt2 * dt / 3.0;
+        double new_position = x[0] + dt * x[1] + dt2 * x[2] + dt3 * x[3];
+        double new_velocity = x[1] + dt * x[2] + dt2 * x[3];
+        double new_acceleration = x[2] + dt * x[3];
+        x[0] = new_position;
+        x[1] = new_velocity;
+        x[2] = new_acceleration;
+    }
+
+    void predict_covariance(FixedMatrix<4>& p, size_t steps, double dt, double q) const {
+        double dt2 = 0.5 * dt * dt;
+        FixedMatrix<4> f = FixedMatrix<4>::identity();
+        f[0][1] = dt;
+        f[0][2] = dt2;
+        f[0][3] = dt2 * dt / 3.0;
+        f[1][2] = dt;
+        f[1][3] = dt2;
+        f[2][3] = dt;
+        predict_covariance_repeated(p, steps, f, FixedVector<4>{{q, q, q, q}});
+    }
+};
+
+/**
+ * 컴파일 시간 dt를 가진 모델 (DT_MICROS 마이크로초 간격)
+ *
+ * dt가 상수가 되어 예측 계수(0.5 * dt^2 등)를 컴파일 시간에 접는다. KalmanParams::dt는 무시한다.
+ * 예: KalmanFilterT<FixedDt<ConstantVelocityModel, 10000>> (dt = 0.01)
+ */
+template <typename Model, long long DT_MICROS>
+struct FixedDt : Model {
+    static_assert(DT_MICROS > 0, "dt must be positive");
+    static constexpr double FIXED_DT = static_cast<double>(DT_MICROS) / 1e6;
+};
+
+} // namespace fusion
+
+#endif // KALMAN_MODELS_H
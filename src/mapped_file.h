@@ -0,0 +1,59 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace fusion {
+
+/**
+ * 읽기 전용 메모리 맵 파일
+ *
+ * 파일 전체를 주소 공간에 매핑하여 복사 없이 바이트 단위로 접근한다.
+ * 빈 파일은 매핑 없이 열린 상태(size() == 0)로 취급한다.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * 파일을 읽기 전용으로 매핑
+     *
+     * @param file_path 파일 경로
+     * @return 성공 시 true, 실패 시 false
+     */
+    bool open(const std::string& file_path);
+
+    /**
+     * 매핑 해제
+     */
+    void close();
+
+    bool is_open() const { return is_open_; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    // 파일을 열 때의 마지막 수정 시각 (플랫폼 고유 단위, 같은 파일의 변경 여부 비교용)
+    int64_t modified_time() const { return modified_time_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    int64_t modified_time_ = 0;
+    bool is_open_ = false;
+#ifdef _WIN32
+    void* file_handle_ = nullptr;
+    void* mapping_handle_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+} // namespace fusion
+
+#endif // MAPPED_FILE_H
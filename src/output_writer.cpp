@@ -0,0 +1,303 @@
+#include "output_writer.h"
+#include "fusion_log.h"
+#include "run_stats.h"
+#include <cctype>
+#include <cstring>
+#include <limits>
+
+namespace fusion {
+
+namespace {
+
+// FUSION_BINARY_OUTPUT_EXTENSION과 같은 값
+const char COLUMNAR_EXTENSION[] = ".fcol";
+
+const char COLUMNAR_MAGIC[4] = {'F', 'C', 'O', 'L'};
+const uint16_t COLUMNAR_VERSION = 2;
+const size_t COLUMNAR_HEADER_SIZE = 80;
+
+// 타임스탬프 저장 방식 (헤더 72번째 바이트)
+const uint8_t TIMESTAMP_TEXT_RUNS = 0;
+const uint8_t TIMESTAMP_MICROS = 1;
+
+// 헤더의 형식 종류 값은 fusion_output_reader.h와 공유
+static_assert(static_cast<int>(TimestampKind::DateTime) == 1 &&
+              static_cast<int>(TimestampKind::HourMinuteSecond) == 2 &&
+              static_cast<int>(TimestampKind::MinuteSecond) == 3, "FCOL timestamp kind values");
+const size_t COLUMNAR_ALIGNMENT = 8;
+
+// float로 저장해도 CSV 출력보다 오차가 작은 최대 자릿수
+const int MAX_FLOAT_PRECISION = 7;
+
+// Y 컬럼 쓰기 버퍼 크기
+const size_t Y_BUFFER_SIZE = 1 << 20;
+
+} // namespace
+
+OutputFormat output_format_for_path(const std::string& file_path) {
+    const size_t ext_len = sizeof(COLUMNAR_EXTENSION) - 1;
+    if (file_path.size() < ext_len) {
+        return OutputFormat::Csv;
+    }
+    for (size_t i = 0; i < ext_len; i++) {
+        char c = file_path[file_path.size() - ext_len + i];
+        if (std::tolower(static_cast<unsigned char>(c)) != COLUMNAR_EXTENSION[i]) {
+            return OutputFormat::Csv;
+        }
+    }
+    return OutputFormat::Columnar;
+}
+
+ColumnarWriter::~ColumnarWriter() {
+    if (file_) {
+        close();
+    }
+}
+
+bool ColumnarWriter::open(const std::string& file_path, int precision) {
+    if (file_) {
+        close();
+    }
+    failed_ = false;
+    position_ = 0;
+    rows_ = 0;
+    value_size_ = (precision >= 1 && precision <= MAX_FLOAT_PRECISION) ? sizeof(float) : sizeof(double);
+    y_buffer_.clear();
+    y_buffer_.reserve(Y_BUFFER_SIZE);
+    z_column_.clear();
+    micros_.clear();
+    layout_ = TimestampLayout();
+    text_timestamps_ = false;
+    run_rows_.clear();
+    run_text_.clear();
+    text_.clear();
+
+    StageTimer timer(run_stats().write_ns);
+    file_ = std::fopen(file_path.c_str(), "wb");
+    if (!file_) {
+        LogLine(LogLevel::Error) << "Cannot create file " << file_path;
+        return false;
+    }
+    // 헤더는 닫을 때 채움
+    char header[COLUMNAR_HEADER_SIZE] = {};
+    write_bytes(header, sizeof(header));
+    return !failed_;
+}
+
+void ColumnarWriter::append_value(std::vector<char>& column, double value) {
+    size_t used = column.size();
+    column.resize(used + value_size_);
+    if (value_size_ == sizeof(float)) {
+        float narrowed = static_cast<float>(value);
+        std::memcpy(column.data() + used, &narrowed, sizeof(narrowed));
+    } else {
+        std::memcpy(column.data() + used, &value, sizeof(value));
+    }
+}
+
+void ColumnarWriter::write_bytes(const void* data, size_t size) {
+    if (size == 0) {
+        return;
+    }
+    if (!failed_ && std::fwrite(data, 1, size, file_) != size) {
+        failed_ = true;
+    }
+    position_ += size;
+    run_stats().bytes_written += size;
+}
+
+void ColumnarWriter::write_padding() {
+    static const char zeros[COLUMNAR_ALIGNMENT] = {};
+    write_bytes(zeros, static_cast<size_t>((COLUMNAR_ALIGNMENT - position_ % COLUMNAR_ALIGNMENT) % COLUMNAR_ALIGNMENT));
+}
+
+void ColumnarWriter::append_text_timestamp(std::string_view timestamp, uint64_t row) {
+    bool new_run = run_rows_.empty();
+    if (!new_run) {
+        size_t last_begin = run_text_[run_text_.size() - 2];
+        new_run = std::string_view(text_.data() + last_begin, text_.size() - last_begin) != timestamp;
+    }
+    if (new_run) {
+        if (run_text_.empty()) {
+            run_text_.push_back(0);
+        }
+        run_rows_.push_back(static_cast<uint32_t>(row));
+        text_.append(timestamp.data(), timestamp.size());
+        run_text_.push_back(static_cast<uint32_t>(text_.size()));
+    }
+}
+
+void ColumnarWriter::convert_timestamps_to_text() {
+    TimestampBuffer buffer;
+    for (size_t row = 0; row < micros_.size(); row++) {
+        append_text_timestamp(buffer.format(Timestamp{micros_[row], layout_}), row);
+    }
+    std::vector<int64_t>().swap(micros_);
+    text_timestamps_ = true;
+}
+
+bool ColumnarWriter::flush_y() {
+    write_bytes(y_buffer_.data(), y_buffer_.size());
+    y_buffer_.clear();
+    return !failed_;
+}
+
+void ColumnarWriter::write_rows(const TimestampColumn& datetime,
+                                Span<const double> displacement_y, Span<const double> displacement_z) {
+    StageTimer timer(run_stats().write_ns);
+    const size_t n = displacement_y.size();
+    if (rows_ + n > std::numeric_limits<uint32_t>::max()) {
+        // 구간 배열이 uint32이므로 행 수를 제한
+        if (!failed_) {
+            LogLine(LogLevel::Error) << "Too many rows for binary columnar output";
+        }
+        failed_ = true;
+        return;
+    }
+
+    // 지금까지와 같은 형식의 정수 컬럼이면 정수만 이어 붙이고, 아니면 원문 구간 방식으로 전환
+    if (!text_timestamps_ && n > 0 &&
+        (!datetime.compact() || (!micros_.empty() && datetime.layout() != layout_))) {
+        convert_timestamps_to_text();
+    }
+    if (text_timestamps_) {
+        TimestampBuffer buffer;
+        for (size_t i = 0; i < n; i++) {
+            append_text_timestamp(datetime.text(i, buffer), rows_ + i);
+        }
+    } else if (n > 0) {
+        if (micros_.empty()) {
+            layout_ = datetime.layout();
+        }
+        for (size_t i = 0; i < n; i++) {
+            micros_.push_back(datetime.micros(i));
+        }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (y_buffer_.size() + value_size_ > Y_BUFFER_SIZE) {
+            flush_y();
+        }
+        append_value(y_buffer_, displacement_y[i]);
+        append_value(z_column_, displacement_z[i]);
+    }
+    rows_ += n;
+    if (text_.size() > std::numeric_limits<uint32_t>::max()) {
+        if (!failed_) {
+            LogLine(LogLevel::Error) << "Timestamp text too large for binary columnar output";
+        }
+        failed_ = true;
+    }
+}
+
+bool ColumnarWriter::close() {
+    if (!file_) {
+        return false;
+    }
+    StageTimer timer(run_stats().write_ns);
+    const uint64_t y_offset = COLUMNAR_HEADER_SIZE;
+    flush_y();
+
+    write_padding();
+    const uint64_t z_offset = position_;
+    write_bytes(z_column_.data(), z_column_.size());
+
+    uint64_t run_count = 0;
+    uint64_t run_rows_offset = 0;
+    uint64_t run_text_offset = 0;
+    uint64_t text_offset = 0;
+    uint64_t micros_offset = 0;
+    if (text_timestamps_) {
+        // 구간 배열 (마지막 값은 행 수)
+        if (run_text_.empty()) {
+            run_text_.push_back(0);
+        }
+        run_rows_.push_back(static_cast<uint32_t>(rows_));
+        run_count = run_rows_.size() - 1;
+        write_padding();
+        run_rows_offset = position_;
+        write_bytes(run_rows_.data(), run_rows_.size() * sizeof(uint32_t));
+        write_padding();
+        run_text_offset = position_;
+        write_bytes(run_text_.data(), run_text_.size() * sizeof(uint32_t));
+        write_padding();
+        text_offset = position_;
+        write_bytes(text_.data(), text_.size());
+    } else {
+        write_padding();
+        micros_offset = position_;
+        write_bytes(micros_.data(), micros_.size() * sizeof(int64_t));
+    }
+
+    char header[COLUMNAR_HEADER_SIZE] = {};
+    std::memcpy(header, COLUMNAR_MAGIC, 4);
+    std::memcpy(header + 4, &COLUMNAR_VERSION, 2);
+    std::memcpy(header + 6, &value_size_, 2);
+    std::memcpy(header + 8, &rows_, 8);
+    std::memcpy(header + 16, &run_count, 8);
+    std::memcpy(header + 24, &y_offset, 8);
+    std::memcpy(header + 32, &z_offset, 8);
+    std::memcpy(header + 40, &run_rows_offset, 8);
+    std::memcpy(header + 48, &run_text_offset, 8);
+    std::memcpy(header + 56, &text_offset, 8);
+    std::memcpy(header + 64, &micros_offset, 8);
+    header[72] = static_cast<char>(text_timestamps_ ? TIMESTAMP_TEXT_RUNS : TIMESTAMP_MICROS);
+    header[73] = static_cast<char>(layout_.kind);
+    header[74] = layout_.date_separator;
+    header[75] = layout_.time_separator;
+    header[76] = static_cast<char>(layout_.lead_width);
+    header[77] = static_cast<char>(layout_.fraction_digits);
+    if (std::fseek(file_, 0, SEEK_SET) != 0 ||
+        std::fwrite(header, 1, sizeof(header), file_) != sizeof(header)) {
+        failed_ = true;
+    }
+    if (std::fclose(file_) != 0) {
+        failed_ = true;
+    }
+    file_ = nullptr;
+
+    // 다음 open까지 메모리를 붙잡지 않도록 해제
+    std::vector<char>().swap(z_column_);
+    std::vector<int64_t>().swap(micros_);
+    std::vector<uint32_t>().swap(run_rows_);
+    std::vector<uint32_t>().swap(run_text_);
+    std::string().swap(text_);
+    return !failed_;
+}
+
+bool OutputWriter::open(const std::string& file_path, int precision) {
+    format_ = output_format_for_path(file_path);
+    if (format_ == OutputFormat::Columnar) {
+        return columnar_.open(file_path, precision);
+    }
+    return csv_.open(file_path, precision);
+}
+
+void OutputWriter::write_rows(const TimestampColumn& datetime,
+                              Span<const double> displacement_y, Span<const double> displacement_z) {
+    if (format_ == OutputFormat::Columnar) {
+        columnar_.write_rows(datetime, displacement_y, displacement_z);
+    } else {
+        csv_.write_rows(datetime, displacement_y, displacement_z);
+    }
+}
+
+bool OutputWriter::close() {
+    return format_ == OutputFormat::Columnar ? columnar_.close() : csv_.close();
+}
+
+bool save_output(const std::string& file_path, const TimestampColumn& datetime,
+                 Span<const double> displacement_y, Span<const double> displacement_z,
+                 int precision) {
+    if (output_format_for_path(file_path) == OutputFormat::Csv) {
+        return save_csv(file_path, datetime, displacement_y, displacement_z, precision);
+    }
+    ColumnarWriter writer;
+    if (!writer.open(file_path, precision)) {
+        return false;
+    }
+    writer.write_rows(datetime, displacement_y, displacement_z);
+    return writer.close();
+}
+
+} // namespace fusion
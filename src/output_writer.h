@@ -0,0 +1,144 @@
+#ifndef OUTPUT_WRITER_H
+#define OUTPUT_WRITER_H
+
+#include "csv_parser.h"
+#include "data_structures.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace fusion {
+
+// 출력 파일 형식
+enum class OutputFormat {
+    Csv,        // 텍스트 CSV
+    Columnar    // 바이너리 컬럼 형식 (FUSION_BINARY_OUTPUT_EXTENSION)
+};
+
+/**
+ * 출력 경로의 확장자로 형식 판별 (".fcol"이면 바이너리 컬럼 형식, 대소문자 무시)
+ */
+OutputFormat output_format_for_path(const std::string& file_path);
+
+/**
+ * 바이너리 컬럼 형식 출력 라이터
+ *
+ * 파일 레이아웃 (호스트 바이트 순서, 리틀 엔디언 대상, 모든 오프셋은 파일 처음 기준, 8바이트 정렬):
+ *   [0, 4)     매직 "FCOL"
+ *   [4, 6)     버전 (uint16, 2)
+ *   [6, 8)     변위 값 크기 (uint16, 4 = float, 8 = double)
+ *   [8, 16)    행 수 (uint64)
+ *   [16, 24)   타임스탬프 구간 수 (uint64, 원문 저장 방식일 때만, 아니면 0)
+ *   [24, 32)   Displacement_Y 컬럼 오프셋
+ *   [32, 40)   Displacement_Z 컬럼 오프셋
+ *   [40, 48)   구간 시작 행 배열 오프셋 (uint32 × (구간 수 + 1), 마지막 값 = 행 수)
+ *   [48, 56)   구간 텍스트 오프셋 배열 오프셋 (uint32 × (구간 수 + 1))
+ *   [56, 64)   타임스탬프 텍스트 오프셋
+ *   [64, 72)   타임스탬프 정수 컬럼 오프셋 (int64 마이크로초 × 행 수, 정수 저장 방식일 때만)
+ *   [72]       타임스탬프 저장 방식 (0 = 원문 구간, 1 = 정수 컬럼)
+ *   [73, 78)   타임스탬프 형식 (TimestampLayout: kind, 날짜 구분자, 날짜/시간 구분자, 첫 필드 자릿수, 소수 자릿수)
+ *   [78, 80)   예약 (0)
+ * 모든 행의 타임스탬프가 같은 형식으로 해석되면 정수 컬럼과 형식 하나로 저장하고
+ * (형식으로 다시 포맷하면 원문과 같음), 해석할 수 없거나 형식이 섞이면 같은 값이 연속된 구간마다
+ * 원문을 한 번만 저장한다.
+ * 변위 값은 출력 자릿수가 7 이하이면 float로 저장한다 (같은 자릿수의 CSV보다 오차가 작음).
+ * 행 데이터를 다 받은 뒤 닫을 때 헤더를 채우므로 Z 컬럼과 타임스탬프는 닫을 때까지 메모리에 모은다.
+ */
+class ColumnarWriter {
+public:
+    ColumnarWriter() = default;
+    ~ColumnarWriter();
+
+    ColumnarWriter(const ColumnarWriter&) = delete;
+    ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+
+    /**
+     * 출력 파일을 만들고 헤더 자리를 비워 둠
+     *
+     * @param file_path 출력 파일 경로
+     * @param precision 출력 자릿수 (CsvWriter::open 참고, 변위 값 크기 결정)
+     * @return 성공 시 true, 실패 시 false
+     */
+    bool open(const std::string& file_path, int precision = DEFAULT_OUTPUT_PRECISION);
+
+    /**
+     * 여러 행 기록
+     */
+    void write_rows(const TimestampColumn& datetime,
+                    Span<const double> displacement_y, Span<const double> displacement_z);
+
+    /**
+     * 나머지 컬럼과 헤더를 기록하고 파일 닫기
+     *
+     * @return 모든 쓰기가 성공했으면 true
+     */
+    bool close();
+
+private:
+    void append_value(std::vector<char>& column, double value);
+    void append_text_timestamp(std::string_view timestamp, uint64_t row);
+    void convert_timestamps_to_text();
+    void write_bytes(const void* data, size_t size);
+    void write_padding();
+    bool flush_y();
+
+    std::FILE* file_ = nullptr;
+    uint64_t position_ = 0;
+    uint16_t value_size_ = sizeof(double);
+    uint64_t rows_ = 0;
+    bool failed_ = false;
+
+    std::vector<char> y_buffer_;    // 파일에 바로 이어 쓰는 Y 컬럼 버퍼
+    std::vector<char> z_column_;    // 닫을 때 기록하는 Z 컬럼
+
+    // 타임스탬프 정수 컬럼 (text_timestamps_가 false일 때)
+    std::vector<int64_t> micros_;
+    TimestampLayout layout_;
+    bool text_timestamps_ = false;
+
+    // 타임스탬프 원문 구간 (해석할 수 없거나 형식이 섞인 경우)
+    std::vector<uint32_t> run_rows_;
+    std::vector<uint32_t> run_text_;
+    std::string text_;
+};
+
+/**
+ * 경로 확장자에 따라 CSV 또는 바이너리 컬럼 형식으로 기록하는 라이터
+ */
+class OutputWriter {
+public:
+    /**
+     * @param file_path 출력 파일 경로 (".fcol"이면 바이너리 컬럼 형식)
+     * @param precision 출력 자릿수 (CsvWriter::open 참고)
+     */
+    bool open(const std::string& file_path, int precision = DEFAULT_OUTPUT_PRECISION);
+
+    void write_rows(const TimestampColumn& datetime,
+                    Span<const double> displacement_y, Span<const double> displacement_z);
+
+    bool close();
+
+    /**
+     * CSV 형식이면 내부 CsvWriter (미러링용), 아니면 nullptr
+     */
+    CsvWriter* csv() { return format_ == OutputFormat::Csv ? &csv_ : nullptr; }
+
+private:
+    OutputFormat format_ = OutputFormat::Csv;
+    CsvWriter csv_;
+    ColumnarWriter columnar_;
+};
+
+/**
+ * 컬럼 데이터를 경로 확장자에 맞는 형식으로 저장
+ *
+ * @return 성공 시 true, 실패 시 false
+ */
+bool save_output(const std::string& file_path, const TimestampColumn& datetime,
+                 Span<const double> displacement_y, Span<const double> displacement_z,
+                 int precision = DEFAULT_OUTPUT_PRECISION);
+
+} // namespace fusion
+
+#endif // OUTPUT_WRITER_H
@@ -0,0 +1,414 @@
+#include "parallel_kalman_filter.h"
+#include "fusion_log.h"
+#include "kalman_lanes.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace fusion {
+
+namespace {
+
+// 현재 스레드에서 비정규화 수(subnormal)를 0으로 처리 (범위를 벗어나면 원래 설정으로 복원)
+// 구간 요소의 A 중 위치 항은 GPS 업데이트마다 (1 - K)배씩 줄어 수백 번 뒤에는 비정규화 수가 되고,
+// 비정규화 수 연산은 수십 배 느리다. 1e-308 미만의 값이므로 0으로 처리해도 결과에 영향이 없다.
+class FlushSubnormalsScope {
+public:
+#ifdef FUSION_SIMD_SSE2
+    FlushSubnormalsScope() : saved_(_mm_getcsr()) { _mm_setcsr(saved_ | FLUSH_TO_ZERO | DENORMALS_ARE_ZERO); }
+    ~FlushSubnormalsScope() { _mm_setcsr(saved_); }
+
+private:
+    static const unsigned int FLUSH_TO_ZERO = 0x8000;
+    static const unsigned int DENORMALS_ARE_ZERO = 0x0040;
+    unsigned int saved_;
+#else
+    FlushSubnormalsScope() {}
+#endif
+};
+
+// 2x2 행렬 (레인 0 = Y축, 레인 1 = Z축)
+struct Mat2 {
+    Vec2 m00, m01, m10, m11;
+};
+
+inline Mat2 mul(const Mat2& a, const Mat2& b) {
+    return Mat2{a.m00 * b.m00 + a.m01 * b.m10, a.m00 * b.m01 + a.m01 * b.m11,
+                a.m10 * b.m00 + a.m11 * b.m10, a.m10 * b.m01 + a.m11 * b.m11};
+}
+
+inline Mat2 transpose(const Mat2& a) {
+    return Mat2{a.m00, a.m10, a.m01, a.m11};
+}
+
+inline Mat2 add(const Mat2& a, const Mat2& b) {
+    return Mat2{a.m00 + b.m00, a.m01 + b.m01, a.m10 + b.m10, a.m11 + b.m11};
+}
+
+// (I + a)^-1
+inline Mat2 inverse_identity_plus(const Mat2& a, const Vec2& one) {
+    Vec2 d00 = one + a.m00;
+    Vec2 d11 = one + a.m11;
+    Vec2 det = d00 * d11 - a.m01 * a.m10;
+    return Mat2{d11 / det, -a.m01 / det, -a.m10 / det, d00 / det};
+}
+
+inline void mul_vec(const Mat2& a, Vec2 x0, Vec2 x1, Vec2& y0, Vec2& y1) {
+    y0 = a.m00 * x0 + a.m01 * x1;
+    y1 = a.m10 * x0 + a.m11 * x1;
+}
+
+// 연관 스캔 요소: p(x_k | x_{i-1}, y_i..y_k) = N(A x_{i-1} + b, C),
+// p(y_i..y_k | x_{i-1}) ∝ exp(-1/2 x^T J x + eta^T x)
+struct ScanElement {
+    Mat2 a;
+    Vec2 b0, b1;
+    Mat2 c;
+    Vec2 eta0, eta1;
+    Mat2 j;
+};
+
+// 요소 결합 (earlier ⊗ later, 결합 법칙 성립)
+//   M = (I + C_i J_j)^-1
+//   A = A_j M A_i,  b = A_j M (b_i + C_i eta_j) + b_j,  C = A_j M C_i A_j^T + C_j
+//   eta = A_i^T M^T (eta_j - J_j b_i) + eta_i,  J = A_i^T M^T J_j A_i + J_i
+ScanElement combine(const ScanElement& earlier, const ScanElement& later, const Vec2& one) {
+    Mat2 m = inverse_identity_plus(mul(earlier.c, later.j), one);
+    Mat2 am = mul(later.a, m);
+    Mat2 ait_mt = mul(transpose(earlier.a), transpose(m));
+
+    ScanElement out;
+    out.a = mul(am, earlier.a);
+
+    Vec2 cb0, cb1;
+    mul_vec(earlier.c, later.eta0, later.eta1, cb0, cb1);
+    Vec2 b0, b1;
+    mul_vec(am, earlier.b0 + cb0, earlier.b1 + cb1, b0, b1);
+    out.b0 = b0 + later.b0;
+    out.b1 = b1 + later.b1;
+
+    out.c = add(mul(mul(am, earlier.c), transpose(later.a)), later.c);
+
+    Vec2 jb0, jb1;
+    mul_vec(later.j, earlier.b0, earlier.b1, jb0, jb1);
+    Vec2 e0, e1;
+    mul_vec(ait_mt, later.eta0 - jb0, later.eta1 - jb1, e0, e1);
+    out.eta0 = e0 + earlier.eta0;
+    out.eta1 = e1 + earlier.eta1;
+
+    out.j = add(mul(mul(ait_mt, later.j), earlier.a), earlier.j);
+    return out;
+}
+
+// 예측만 하는 샘플 (요소 = (F, B u, Q, 0, 0))을 결합: 예측 단계와 같은 연산에 A 전파만 추가
+inline void combine_predict(ScanElement& e, Vec2 acc, const FilterConstants& c) {
+    Mat2 a = e.a;
+    e.a = Mat2{a.m00 + c.dt * a.m10, a.m01 + c.dt * a.m11, a.m10, a.m11};
+    predict_state(e.b0, e.b1, acc, c);
+    Covariance2 p{e.c.m00, e.c.m01, e.c.m10, e.c.m11};
+    predict_covariance(p, c);
+    e.c = Mat2{p.p00, p.p01, p.p10, p.p11};
+}
+
+// GPS 업데이트가 있는 샘플의 요소 (valid가 아닌 레인은 예측만 하는 요소와 같음)
+//   S = q + r, K = (q / S, 0), A = (I - K H) F, b = B u + K (y - H B u), C = (I - K H) Q,
+//   eta = F^T H^T S^-1 (y - H B u), J = F^T H^T S^-1 H F
+ScanElement update_element(Vec2 gps, Mask2 valid, Vec2 acc, const FilterConstants& c) {
+    Vec2 bu0 = c.half_dt_dt * acc;
+    Vec2 bu1 = c.dt * acc;
+    Vec2 s_inv = select2(valid, c.one / (c.q + c.r), c.zero);
+    Vec2 w = select2(valid, s_inv * (gps - bu0), c.zero);
+    Vec2 i_kh = c.one - c.q * s_inv;
+
+    ScanElement e;
+    e.a = Mat2{i_kh, i_kh * c.dt, c.zero, c.one};
+    e.b0 = bu0 + c.q * w;
+    e.b1 = bu1;
+    e.c = Mat2{i_kh * c.q, c.zero, c.zero, c.q};
+    e.eta0 = w;
+    e.eta1 = c.dt * w;
+    e.j = Mat2{s_inv, s_inv * c.dt, s_inv * c.dt, s_inv * c.dt_dt};
+    return e;
+}
+
+// [begin, end) 구간 전체를 요소 하나로 결합
+ScanElement reduce_block(Span<const double> gps_y, Span<const double> gps_z, Span<const double> acc_y,
+                         Span<const double> acc_z, Span<const int> fix_data, size_t begin, size_t end,
+                         const FilterConstants& c) {
+    FlushSubnormalsScope flush_subnormals;
+
+    // 항등 요소 (A = I, 나머지 0)에서 시작
+    ScanElement total;
+    total.a = Mat2{c.one, c.zero, c.zero, c.one};
+    total.b0 = c.zero;
+    total.b1 = c.zero;
+    total.c = Mat2{c.zero, c.zero, c.zero, c.zero};
+    total.eta0 = c.zero;
+    total.eta1 = c.zero;
+    total.j = total.c;
+    for (size_t i = begin; i < end; i++) {
+        Vec2 acc = make2(acc_y[i], acc_z[i]);
+        if (fix_data[i] >= 1) {
+            Vec2 gps = make2(gps_y[i], gps_z[i]);
+            Mask2 valid = finite2(gps);
+            if (bits2(valid) != 0) {
+                total = combine(total, update_element(gps, valid, acc, c), c.one);
+                continue;
+            }
+        }
+        combine_predict(total, acc, c);
+    }
+    return total;
+}
+
+// 필터 상태/공분산을 요소로 표현 (A = 0, eta = 0, J = 0)
+ScanElement state_element(const DualAxisKalmanFilter& filter, const FilterConstants& c) {
+    KalmanState y = filter.getStateY();
+    KalmanState z = filter.getStateZ();
+    KalmanCovariance py = filter.getCovarianceY();
+    KalmanCovariance pz = filter.getCovarianceZ();
+
+    ScanElement e;
+    e.a = Mat2{c.zero, c.zero, c.zero, c.zero};
+    e.b0 = make2(y.position, z.position);
+    e.b1 = make2(y.velocity, z.velocity);
+    e.c = Mat2{make2(py.p00, pz.p00), make2(py.p01, pz.p01), make2(py.p10, pz.p10), make2(py.p11, pz.p11)};
+    e.eta0 = c.zero;
+    e.eta1 = c.zero;
+    e.j = e.a;
+    return e;
+}
+
+void set_filter_state(DualAxisKalmanFilter& filter, const ScanElement& e) {
+    alignas(16) double b0[2], b1[2], c00[2], c01[2], c10[2], c11[2];
+    store2(b0, e.b0);
+    store2(b1, e.b1);
+    store2(c00, e.c.m00);
+    store2(c01, e.c.m01);
+    store2(c10, e.c.m10);
+    store2(c11, e.c.m11);
+    filter.setState(KalmanState{b0[0], b1[0]}, KalmanState{b0[1], b1[1]});
+    filter.setCovariance(KalmanCovariance{c00[0], c01[0], c10[0], c11[0]},
+                         KalmanCovariance{c00[1], c01[1], c10[1], c11[1]});
+}
+
+// 웜업 구간의 출력을 버리기 위한 스택 버퍼 크기
+const size_t WARMUP_BUFFER_ROWS = 256;
+
+// [begin, end)에서 축별 첫 번째 유효한 GPS 측정값(Fix >= 1)으로 필터 초기화 (없으면 begin의 GPS 값)
+void reset_from_first_valid(DualAxisKalmanFilter& filter, Span<const double> gps_y, Span<const double> gps_z,
+                            Span<const int> fix_data, size_t begin, size_t end) {
+    double initial_y = gps_y[begin];
+    double initial_z = gps_z[begin];
+    bool found_y = false;
+    bool found_z = false;
+    for (size_t i = begin; i < end && !(found_y && found_z); i++) {
+        if (fix_data[i] < 1) {
+            continue;
+        }
+        if (!found_y && std::isfinite(gps_y[i])) {
+            initial_y = gps_y[i];
+            found_y = true;
+        }
+        if (!found_z && std::isfinite(gps_z[i])) {
+            initial_z = gps_z[i];
+            found_z = true;
+        }
+    }
+    filter.reset(initial_y, initial_z);
+}
+
+} // namespace
+
+bool process_parallel_in_time(
+    DualAxisKalmanFilter& filter,
+    ThreadPool& pool,
+    Span<const double> gps_y,
+    Span<const double> gps_z,
+    Span<const double> acc_y,
+    Span<const double> acc_z,
+    Span<const int> fix_data,
+    Span<double> displacement_y,
+    Span<double> displacement_z,
+    bool hold_first) {
+
+    size_t n = fix_data.size();
+    if (gps_y.size() != n || gps_z.size() != n || acc_y.size() != n || acc_z.size() != n ||
+        displacement_y.size() != n || displacement_z.size() != n) {
+        LogLine(LogLevel::Error) << "GPS, ACC, and Fix data size mismatch";
+        return false;
+    }
+
+    size_t start = hold_first && n > 0 ? 1 : 0;
+    size_t rows = n - start;
+    size_t blocks = std::min(pool.size(), rows / MIN_PARALLEL_BLOCK_ROWS);
+    if (blocks < 2) {
+        return filter.processBatch(gps_y, gps_z, acc_y, acc_z, fix_data, displacement_y, displacement_z,
+                                   hold_first);
+    }
+    if (hold_first) {
+        // 첫 번째 데이터는 현재 상태 사용 (초기화 없음)
+        displacement_y[0] = filter.getStateY().position;
+        displacement_z[0] = filter.getStateZ().position;
+    }
+
+    const KalmanParams& params = filter.getParams();
+    const FilterConstants c(params);
+    std::vector<size_t> bounds(blocks + 1);
+    for (size_t b = 0; b <= blocks; b++) {
+        bounds[b] = start + rows * b / blocks;
+    }
+
+    // 구간 필터는 모두 전체 필터 (첫 구간은 현재 상태에서 시작)
+    std::vector<DualAxisKalmanFilter> block_filters(blocks, DualAxisKalmanFilter(params));
+    block_filters[0].setState(filter.getStateY(), filter.getStateZ());
+    block_filters[0].setCovariance(filter.getCovarianceY(), filter.getCovarianceZ());
+    std::vector<ScanElement> totals(blocks);
+
+    auto run_block = [&](size_t b) {
+        size_t begin = bounds[b];
+        size_t count = bounds[b + 1] - begin;
+        block_filters[b].processBatch(gps_y.subspan(begin, count), gps_z.subspan(begin, count),
+                                      acc_y.subspan(begin, count), acc_z.subspan(begin, count),
+                                      fix_data.subspan(begin, count), displacement_y.subspan(begin, count),
+                                      displacement_z.subspan(begin, count), false);
+    };
+
+    // 1. 구간별 요소 결합 (첫 구간은 시작 상태를 알고 있으므로 바로 필터 실행)
+    parallel_for(pool, blocks, [&](size_t b) {
+        if (b == 0) {
+            run_block(0);
+        } else {
+            totals[b] = reduce_block(gps_y, gps_z, acc_y, acc_z, fix_data, bounds[b], bounds[b + 1], c);
+        }
+    });
+
+    // 2. 구간 시작 상태 스캔 (구간 수만큼 순차)
+    ScanElement prefix = state_element(block_filters[0], c);
+    for (size_t b = 1; b < blocks; b++) {
+        set_filter_state(block_filters[b], prefix);
+        if (b + 1 < blocks) {
+            prefix = combine(prefix, totals[b], c.one);
+        }
+    }
+
+    // 3. 나머지 구간을 시작 상태에서 병렬로 필터링
+    parallel_for(pool, blocks - 1, [&](size_t index) { run_block(index + 1); });
+
+    const DualAxisKalmanFilter& last = block_filters[blocks - 1];
+    filter.setState(last.getStateY(), last.getStateZ());
+    filter.setCovariance(last.getCovarianceY(), last.getCovarianceZ());
+    size_t updates = 0;
+    size_t predict_only = 0;
+    for (const DualAxisKalmanFilter& block_filter : block_filters) {
+        updates += block_filter.getUpdateSteps();
+        predict_only += block_filter.getPredictOnlySteps();
+    }
+    filter.addStepCounts(updates, predict_only);
+    return true;
+}
+
+bool process_chunked_overlap(
+    DualAxisKalmanFilter& filter,
+    ThreadPool& pool,
+    size_t chunks,
+    size_t overlap,
+    Span<const double> gps_y,
+    Span<const double> gps_z,
+    Span<const double> acc_y,
+    Span<const double> acc_z,
+    Span<const int> fix_data,
+    Span<double> displacement_y,
+    Span<double> displacement_z,
+    bool hold_first) {
+
+    size_t n = fix_data.size();
+    if (gps_y.size() != n || gps_z.size() != n || acc_y.size() != n || acc_z.size() != n ||
+        displacement_y.size() != n || displacement_z.size() != n) {
+        LogLine(LogLevel::Error) << "GPS, ACC, and Fix data size mismatch";
+        return false;
+    }
+
+    size_t start = hold_first && n > 0 ? 1 : 0;
+    size_t rows = n - start;
+    chunks = std::min(chunks, rows);
+    if (chunks < 2) {
+        return filter.processBatch(gps_y, gps_z, acc_y, acc_z, fix_data, displacement_y, displacement_z,
+                                   hold_first);
+    }
+
+    // 청크 경계 (첫 청크는 유지하는 첫 샘플을 포함)
+    std::vector<size_t> bounds(chunks + 1);
+    for (size_t b = 0; b <= chunks; b++) {
+        bounds[b] = b == 0 ? 0 : start + rows * b / chunks;
+    }
+
+    // 웜업이 입력 시작에 닿는 청크가 쓸 시작 상태 (첫 청크가 filter를 바로 갱신하므로 미리 복사)
+    const KalmanParams& params = filter.getParams();
+    const KalmanState start_y = filter.getStateY();
+    const KalmanState start_z = filter.getStateZ();
+    const KalmanCovariance start_cov_y = filter.getCovarianceY();
+    const KalmanCovariance start_cov_z = filter.getCovarianceZ();
+
+    std::vector<DualAxisKalmanFilter> chunk_filters(chunks - 1, DualAxisKalmanFilter(params));
+    std::vector<size_t> warmup_updates(chunks - 1, 0);
+    std::vector<size_t> warmup_predict_only(chunks - 1, 0);
+
+    parallel_for(pool, chunks, [&](size_t b) {
+        size_t begin = bounds[b];
+        size_t count = bounds[b + 1] - begin;
+        if (b == 0) {
+            filter.processBatch(gps_y.subspan(0, count), gps_z.subspan(0, count), acc_y.subspan(0, count),
+                                acc_z.subspan(0, count), fix_data.subspan(0, count),
+                                displacement_y.subspan(0, count), displacement_z.subspan(0, count), hold_first);
+            return;
+        }
+
+        DualAxisKalmanFilter& chunk_filter = chunk_filters[b - 1];
+        size_t warmup_begin = begin - std::min(overlap, begin - start);
+        bool hold_warmup_first = true;
+        if (warmup_begin == start) {
+            // 입력 시작부터 다시 처리: 순차 필터와 같은 결과
+            chunk_filter.setState(start_y, start_z);
+            chunk_filter.setCovariance(start_cov_y, start_cov_z);
+            hold_warmup_first = false;
+        } else {
+            reset_from_first_valid(chunk_filter, gps_y, gps_z, fix_data, warmup_begin, bounds[b + 1]);
+        }
+
+        // 웜업 구간 (출력은 버림)
+        double warmup_y[WARMUP_BUFFER_ROWS];
+        double warmup_z[WARMUP_BUFFER_ROWS];
+        for (size_t i = warmup_begin; i < begin; i += WARMUP_BUFFER_ROWS) {
+            size_t warmup_count = std::min(WARMUP_BUFFER_ROWS, begin - i);
+            chunk_filter.processBatch(gps_y.subspan(i, warmup_count), gps_z.subspan(i, warmup_count),
+                                      acc_y.subspan(i, warmup_count), acc_z.subspan(i, warmup_count),
+                                      fix_data.subspan(i, warmup_count), Span<double>(warmup_y, warmup_count),
+                                      Span<double>(warmup_z, warmup_count), hold_warmup_first);
+            hold_warmup_first = false;
+        }
+        warmup_updates[b - 1] = chunk_filter.getUpdateSteps();
+        warmup_predict_only[b - 1] = chunk_filter.getPredictOnlySteps();
+
+        chunk_filter.processBatch(gps_y.subspan(begin, count), gps_z.subspan(begin, count),
+                                  acc_y.subspan(begin, count), acc_z.subspan(begin, count),
+                                  fix_data.subspan(begin, count), displacement_y.subspan(begin, count),
+                                  displacement_z.subspan(begin, count), hold_warmup_first);
+    });
+
+    const DualAxisKalmanFilter& last = chunk_filters.back();
+    filter.setState(last.getStateY(), last.getStateZ());
+    filter.setCovariance(last.getCovarianceY(), last.getCovarianceZ());
+
+    // 통계에는 웜업을 제외한 청크 샘플만 더함
+    size_t updates = 0;
+    size_t predict_only = 0;
+    for (size_t b = 0; b + 1 < chunks; b++) {
+        updates += chunk_filters[b].getUpdateSteps() - warmup_updates[b];
+        predict_only += chunk_filters[b].getPredictOnlySteps() - warmup_predict_only[b];
+    }
+    filter.addStepCounts(updates, predict_only);
+    return true;
+}
+
+} // namespace fusion
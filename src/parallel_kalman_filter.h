@@ -0,0 +1,81 @@
+#ifndef PARALLEL_KALMAN_FILTER_H
+#define PARALLEL_KALMAN_FILTER_H
+
+#include "data_structures.h"
+#include "dual_axis_kalman_filter.h"
+#include "thread_pool.h"
+
+namespace fusion {
+
+// 시간 축 병렬 처리에서 한 구간의 최소 샘플 수 (이보다 짧으면 순차 처리가 더 빠름)
+constexpr size_t MIN_PARALLEL_BLOCK_ROWS = 16384;
+
+/**
+ * 시간 축 병렬(parallel-in-time) 칼만 필터
+ *
+ * 선형 칼만 필터를 결합 법칙이 성립하는 연산으로 표현한 연관 스캔(associative scan) 형식
+ * (Särkkä & García-Fernández, 2021)을 사용한다. 샘플 k의 요소는 x(k-1)을 조건으로 한
+ * x(k)의 분포 N(A x(k-1) + b, C)와 y(k)가 x(k-1)에 주는 정보 (eta, J)이며,
+ * 모델은 KalmanFilter::predict/update와 같은 F, B, H = [1, 0], Q * I, R이다.
+ *
+ * 입력을 워커 수만큼 구간으로 나눈 뒤
+ *   1. 각 구간의 요소를 병렬로 결합해 구간 전체의 요소 하나로 줄이고 (첫 구간은 바로 필터 실행)
+ *   2. 구간 요소를 순서대로 결합해 각 구간 시작 시점의 필터 상태/공분산을 구한 다음 (구간 수만큼의 순차 스캔)
+ *   3. 각 구간을 그 시작 상태에서 DualAxisKalmanFilter로 병렬 처리해 샘플별 변위를 기록한다.
+ * 요소를 샘플마다 저장하지 않으므로 추가 메모리는 구간 수에만 비례한다.
+ * 전체 연산량은 순차 필터의 약 2~3배이므로 코어가 여러 개일 때만 빠르며,
+ * 결과는 순차 필터와 반올림 오차 수준에서 같다 (구간 시작 상태의 계산 순서만 다름).
+ *
+ * @param filter 시작 상태를 가진 필터 (처리 후 마지막 샘플의 상태/공분산으로 갱신, 정상 상태 모드는 사용하지 않음)
+ * @param pool 구간을 처리할 스레드 풀 (구간 수 = 워커 수, 단 구간당 MIN_PARALLEL_BLOCK_ROWS 이상)
+ * @param hold_first true면 첫 샘플은 현재 상태를 그대로 출력 (DualAxisKalmanFilter::processBatch와 같음)
+ * @return 입력/출력 크기가 맞지 않으면 false
+ */
+bool process_parallel_in_time(
+    DualAxisKalmanFilter& filter,
+    ThreadPool& pool,
+    Span<const double> gps_y,
+    Span<const double> gps_z,
+    Span<const double> acc_y,
+    Span<const double> acc_z,
+    Span<const int> fix_data,
+    Span<double> displacement_y,
+    Span<double> displacement_z,
+    bool hold_first
+);
+
+/**
+ * 웜업 겹침(warm-up overlap) 청크 병렬 처리 (근사)
+ *
+ * 입력을 chunks개 청크로 나눠 스레드 풀에서 동시에 필터링하고 출력을 순서대로 이어 붙인다.
+ * 첫 청크는 filter의 현재 상태에서 시작한다. 나머지 청크는 바로 앞 overlap개 샘플(웜업 구간)의
+ * 축별 첫 유효 GPS로 초기화한 새 필터(P = I)를 웜업 구간에 먼저 통과시킨 뒤 자기 청크를 처리하며,
+ * 웜업 구간의 출력은 버린다. 웜업 동안 공분산과 상태가 순차 필터 쪽으로 수렴하므로
+ * 청크 경계 직후의 오차는 overlap이 길수록 작아진다 (웜업이 입력 시작에 닿는 청크는 순차 필터와 같음).
+ * 연관 스캔 방식보다 근사적이지만 추가 연산이 청크당 overlap개 샘플뿐이라 코어 수에 거의 비례해 빨라진다.
+ *
+ * @param filter 시작 상태를 가진 필터 (첫 청크를 직접 처리하고, 처리 후 마지막 청크 필터의 상태/공분산으로 갱신)
+ * @param pool 청크를 처리할 스레드 풀
+ * @param chunks 청크 수 (2 미만이거나 입력이 짧으면 순차 처리, 청크당 최소 1개 샘플)
+ * @param overlap 웜업 구간 샘플 수
+ * @param hold_first true면 첫 샘플은 현재 상태를 그대로 출력 (DualAxisKalmanFilter::processBatch와 같음)
+ * @return 입력/출력 크기가 맞지 않으면 false
+ */
+bool process_chunked_overlap(
+    DualAxisKalmanFilter& filter,
+    ThreadPool& pool,
+    size_t chunks,
+    size_t overlap,
+    Span<const double> gps_y,
+    Span<const double> gps_z,
+    Span<const double> acc_y,
+    Span<const double> acc_z,
+    Span<const int> fix_data,
+    Span<double> displacement_y,
+    Span<double> displacement_z,
+    bool hold_first
+);
+
+} // namespace fusion
+
+#endif // PARALLEL_KALMAN_FILTER_H
@@ -0,0 +1,155 @@
+#include "param_sweep.h"
+#include "kalman_lanes.h"
+#include <algorithm>
+#include <cmath>
+
+namespace fusion {
+
+namespace {
+
+// 한 번에 모든 파라미터 세트를 통과시키는 샘플 블록 크기 (입력 컬럼이 L1/L2에 머무는 크기)
+const size_t SWEEP_BLOCK_ROWS = 2048;
+
+const double TWO_PI = 6.283185307179586476925286766559;
+
+// 파라미터 세트 두 개(레인 0, 1)의 한 축 필터 상태
+struct LanePairState {
+    alignas(16) double position[2];
+    alignas(16) double velocity[2];
+    alignas(16) double p00[2];
+    alignas(16) double p01[2];
+    alignas(16) double p10[2];
+    alignas(16) double p11[2];
+    double log_likelihood[2];
+    double squared_innovation[2];
+    size_t updates;
+    size_t pending_covariance_steps;  // 다음 업데이트 직전에 한 번에 적용할 공분산 예측 횟수
+};
+
+void init_lane_pair(LanePairState& state, double initial_position) {
+    for (int lane = 0; lane < 2; lane++) {
+        state.position[lane] = initial_position;
+        state.velocity[lane] = 0.0;
+        state.p00[lane] = 1.0;
+        state.p01[lane] = 0.0;
+        state.p10[lane] = 0.0;
+        state.p11[lane] = 1.0;
+        state.log_likelihood[lane] = 0.0;
+        state.squared_innovation[lane] = 0.0;
+    }
+    state.updates = 0;
+    state.pending_covariance_steps = 0;
+}
+
+// 한 축의 [begin, end) 구간을 레인 쌍으로 처리
+void run_lane_pair(LanePairState& state, const FilterConstants& c,
+                   const double* gps, const double* acc, const int* fix,
+                   size_t begin, size_t end) {
+    Vec2 pos = load2(state.position);
+    Vec2 vel = load2(state.velocity);
+    Covariance2 p{load2(state.p00), load2(state.p01), load2(state.p10), load2(state.p11)};
+    Vec2 k0;
+    Vec2 k1;
+    size_t deferred = state.pending_covariance_steps;
+
+    for (size_t i = begin; i < end; i++) {
+        predict_state(pos, vel, splat2(acc[i]), c);
+        deferred++;
+
+        // GPS 유효 여부는 데이터에만 의존하므로 두 레인이 같음
+        if (fix[i] >= 1 && std::isfinite(gps[i])) {
+            predict_covariance_steps(p, deferred, c);
+            deferred = 0;
+            Vec2 z = splat2(gps[i]);
+            Vec2 y = z - pos;
+            Vec2 s = p.p00 + c.r;
+            Vec2 y2 = y * y;
+            Vec2 nis = y2 / s;
+            state.log_likelihood[0] -= 0.5 * (std::log(TWO_PI * lane0(s)) + lane0(nis));
+            state.log_likelihood[1] -= 0.5 * (std::log(TWO_PI * lane1(s)) + lane1(nis));
+            state.squared_innovation[0] += lane0(y2);
+            state.squared_innovation[1] += lane1(y2);
+            state.updates++;
+
+            update_full(pos, vel, p, z, finite2(z), c, k0, k1);
+        }
+    }
+
+    store2(state.position, pos);
+    store2(state.velocity, vel);
+    store2(state.p00, p.p00);
+    store2(state.p01, p.p01);
+    store2(state.p10, p.p10);
+    store2(state.p11, p.p11);
+    state.pending_covariance_steps = deferred;
+}
+
+double first_valid_gps(const std::vector<double>& gps, const std::vector<int>& fix) {
+    for (size_t i = 0; i < gps.size(); i++) {
+        if (fix[i] >= 1 && std::isfinite(gps[i])) {
+            return gps[i];
+        }
+    }
+    return gps[0];
+}
+
+} // namespace
+
+bool sweep_parameters(const SampleBlock& samples, const std::vector<KalmanParams>& params,
+                      std::vector<SweepScore>& scores) {
+    size_t n = samples.size();
+    scores.assign(params.size(), SweepScore{0.0, 0.0, 0.0, 0, 0});
+    if (n == 0) {
+        return false;
+    }
+    if (params.empty()) {
+        return true;
+    }
+
+    // 초기화: 축별 첫 번째 유효한 GPS 측정값 (일반 처리 모드와 동일)
+    double initial_y = first_valid_gps(samples.gps_y, samples.fix);
+    double initial_z = first_valid_gps(samples.gps_z, samples.fix);
+
+    // 홀수 개면 마지막 레인은 마지막 세트를 복제해 채우고 결과는 버림
+    size_t pair_count = (params.size() + 1) / 2;
+    std::vector<FilterConstants> constants;
+    std::vector<LanePairState> states_y(pair_count);
+    std::vector<LanePairState> states_z(pair_count);
+    constants.reserve(pair_count);
+    for (size_t pair = 0; pair < pair_count; pair++) {
+        const KalmanParams& lane0_params = params[2 * pair];
+        const KalmanParams& lane1_params = params[std::min(2 * pair + 1, params.size() - 1)];
+        constants.emplace_back(lane0_params, lane1_params);
+        init_lane_pair(states_y[pair], initial_y);
+        init_lane_pair(states_z[pair], initial_z);
+    }
+
+    // 첫 샘플은 초기 상태를 그대로 사용하므로 두 번째 샘플부터 처리
+    for (size_t begin = 1; begin < n; begin += SWEEP_BLOCK_ROWS) {
+        size_t end = std::min(begin + SWEEP_BLOCK_ROWS, n);
+        for (size_t pair = 0; pair < pair_count; pair++) {
+            run_lane_pair(states_y[pair], constants[pair], samples.gps_y.data(), samples.acc_y.data(),
+                          samples.fix.data(), begin, end);
+            run_lane_pair(states_z[pair], constants[pair], samples.gps_z.data(), samples.acc_z.data(),
+                          samples.fix.data(), begin, end);
+        }
+    }
+
+    for (size_t index = 0; index < params.size(); index++) {
+        const LanePairState& state_y = states_y[index / 2];
+        const LanePairState& state_z = states_z[index / 2];
+        int lane = static_cast<int>(index % 2);
+        SweepScore& score = scores[index];
+        score.log_likelihood = state_y.log_likelihood[lane] + state_z.log_likelihood[lane];
+        score.updates_y = state_y.updates;
+        score.updates_z = state_z.updates;
+        score.innovation_rms_y = state_y.updates > 0
+            ? std::sqrt(state_y.squared_innovation[lane] / static_cast<double>(state_y.updates)) : 0.0;
+        score.innovation_rms_z = state_z.updates > 0
+            ? std::sqrt(state_z.squared_innovation[lane] / static_cast<double>(state_z.updates)) : 0.0;
+    }
+
+    return true;
+}
+
+} // namespace fusion
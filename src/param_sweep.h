@@ -0,0 +1,35 @@
+#ifndef PARAM_SWEEP_H
+#define PARAM_SWEEP_H
+
+#include "data_structures.h"
+#include <vector>
+
+namespace fusion {
+
+// 파라미터 세트 하나의 평가 점수
+struct SweepScore {
+    double log_likelihood;     // 혁신(innovation) 가우시안 로그 우도 합 (Y+Z, 클수록 좋음)
+    double innovation_rms_y;   // Y축 GPS 측정값 대비 예측 잔차 RMS
+    double innovation_rms_z;   // Z축 GPS 측정값 대비 예측 잔차 RMS
+    size_t updates_y;          // Y축 GPS 업데이트 수
+    size_t updates_z;          // Z축 GPS 업데이트 수
+};
+
+/**
+ * 여러 (Q, R) 조합을 한 번의 데이터 순회로 평가
+ *
+ * 파라미터 세트 두 개를 SIMD 레인 하나씩에 배치하고(상태/공분산은 세트별 SoA),
+ * 캐시에 맞는 블록 단위로 모든 세트를 같은 샘플 구간에 통과시킨다.
+ * 각 세트의 필터 연산은 일반 처리 모드(KalmanFilter::process)와 비트 단위로 같다.
+ *
+ * @param samples 입력 샘플 (전체 파일)
+ * @param params 평가할 파라미터 세트 목록
+ * @param scores 세트별 점수 (params와 같은 순서)
+ * @return 샘플이 비어 있으면 false
+ */
+bool sweep_parameters(const SampleBlock& samples, const std::vector<KalmanParams>& params,
+                      std::vector<SweepScore>& scores);
+
+} // namespace fusion
+
+#endif // PARAM_SWEEP_H
@@ -0,0 +1,16 @@
+#include "run_stats.h"
+
+namespace fusion {
+
+RunStats& run_stats() {
+    thread_local RunStats stats;
+    return stats;
+}
+
+RunStats& clear_run_stats() {
+    RunStats& stats = run_stats();
+    stats = RunStats();
+    return stats;
+}
+
+} // namespace fusion
@@ -0,0 +1,92 @@
+#ifndef RUN_STATS_H
+#define RUN_STATS_H
+
+#include <chrono>
+#include <cstdint>
+
+namespace fusion {
+
+// 처리 단계별 시간(ns)과 카운터 (fusion_get_last_stats)
+struct RunStats {
+    uint64_t total_ns = 0;
+    uint64_t parse_ns = 0;
+    uint64_t filter_ns = 0;
+    uint64_t write_ns = 0;
+    uint64_t snapshot_ns = 0;
+    uint64_t rows_parsed = 0;
+    uint64_t rows_rejected = 0;
+    uint64_t gps_updates = 0;
+    uint64_t predict_only_steps = 0;
+    uint64_t bytes_read = 0;
+    uint64_t bytes_written = 0;
+    uint64_t snapshot_writes = 0;
+
+    void add(const RunStats& other) {
+        total_ns += other.total_ns;
+        parse_ns += other.parse_ns;
+        filter_ns += other.filter_ns;
+        write_ns += other.write_ns;
+        snapshot_ns += other.snapshot_ns;
+        rows_parsed += other.rows_parsed;
+        rows_rejected += other.rows_rejected;
+        gps_updates += other.gps_updates;
+        predict_only_steps += other.predict_only_steps;
+        bytes_read += other.bytes_read;
+        bytes_written += other.bytes_written;
+        snapshot_writes += other.snapshot_writes;
+    }
+};
+
+/**
+ * 현재 스레드의 통계
+ *
+ * 스레드마다 따로 집계하므로 잠금이나 원자적 연산 없이 갱신한다.
+ */
+RunStats& run_stats();
+
+/**
+ * 범위를 벗어날 때 경과 시간(ns)을 지정한 항목에 더하는 타이머
+ */
+class StageTimer {
+public:
+    explicit StageTimer(uint64_t& target)
+        : target_(target), start_(std::chrono::steady_clock::now()) {}
+
+    ~StageTimer() {
+        target_ += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_).count());
+    }
+
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+private:
+    uint64_t& target_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * 현재 스레드의 통계를 비우고 반환
+ */
+RunStats& clear_run_stats();
+
+/**
+ * C API 호출 하나의 통계 범위
+ *
+ * 시작할 때 현재 스레드의 통계를 비우고, 끝날 때 전체 경과 시간을 기록한다.
+ */
+class RunStatsScope {
+public:
+    RunStatsScope() : stats_(clear_run_stats()), total_(stats_.total_ns) {}
+
+    RunStatsScope(const RunStatsScope&) = delete;
+    RunStatsScope& operator=(const RunStatsScope&) = delete;
+
+private:
+    RunStats& stats_;
+    StageTimer total_;
+};
+
+} // namespace fusion
+
+#endif // RUN_STATS_H
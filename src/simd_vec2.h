@@ -0,0 +1,72 @@
+#ifndef SIMD_VEC2_H
+#define SIMD_VEC2_H
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define FUSION_SIMD_SSE2 1
+#endif
+
+namespace fusion {
+
+/**
+ * 2개 레인 double 연산 (내부용)
+ *
+ * SSE2가 있으면 __m128d 하나로, 없으면 같은 연산을 레인별 스칼라로 수행한다.
+ * 레인마다 스칼라 코드와 같은 IEEE 연산을 하므로 연산 순서만 같으면 결과가 비트 단위로 일치한다.
+ */
+#ifdef FUSION_SIMD_SSE2
+struct Vec2 {
+    __m128d v;
+};
+struct Mask2 {
+    __m128d m;
+};
+
+inline Vec2 make2(double lane0, double lane1) { return Vec2{_mm_set_pd(lane1, lane0)}; }
+inline Vec2 splat2(double x) { return Vec2{_mm_set1_pd(x)}; }
+inline Vec2 load2(const double* p) { return Vec2{_mm_load_pd(p)}; }
+inline void store2(double* p, Vec2 a) { _mm_store_pd(p, a.v); }
+inline double lane0(Vec2 a) { return _mm_cvtsd_f64(a.v); }
+inline double lane1(Vec2 a) { return _mm_cvtsd_f64(_mm_unpackhi_pd(a.v, a.v)); }
+inline Vec2 operator+(Vec2 a, Vec2 b) { return Vec2{_mm_add_pd(a.v, b.v)}; }
+inline Vec2 operator-(Vec2 a, Vec2 b) { return Vec2{_mm_sub_pd(a.v, b.v)}; }
+inline Vec2 operator*(Vec2 a, Vec2 b) { return Vec2{_mm_mul_pd(a.v, b.v)}; }
+inline Vec2 operator/(Vec2 a, Vec2 b) { return Vec2{_mm_div_pd(a.v, b.v)}; }
+inline Vec2 operator-(Vec2 a) { return Vec2{_mm_xor_pd(a.v, _mm_set1_pd(-0.0))}; }
+// 유한한 값만 x - x == 0 (NaN, Inf는 NaN이 됨)
+inline Mask2 finite2(Vec2 a) { return Mask2{_mm_cmpeq_pd(_mm_sub_pd(a.v, a.v), _mm_setzero_pd())}; }
+inline int bits2(Mask2 m) { return _mm_movemask_pd(m.m); }
+inline Vec2 select2(Mask2 m, Vec2 a, Vec2 b) {
+    return Vec2{_mm_or_pd(_mm_and_pd(m.m, a.v), _mm_andnot_pd(m.m, b.v))};
+}
+#else
+struct Vec2 {
+    double v[2];
+};
+struct Mask2 {
+    bool m[2];
+};
+
+inline Vec2 make2(double lane0, double lane1) { return Vec2{{lane0, lane1}}; }
+inline Vec2 splat2(double x) { return Vec2{{x, x}}; }
+inline Vec2 load2(const double* p) { return Vec2{{p[0], p[1]}}; }
+inline void store2(double* p, Vec2 a) { p[0] = a.v[0]; p[1] = a.v[1]; }
+inline double lane0(Vec2 a) { return a.v[0]; }
+inline double lane1(Vec2 a) { return a.v[1]; }
+inline Vec2 operator+(Vec2 a, Vec2 b) { return Vec2{{a.v[0] + b.v[0], a.v[1] + b.v[1]}}; }
+inline Vec2 operator-(Vec2 a, Vec2 b) { return Vec2{{a.v[0] - b.v[0], a.v[1] - b.v[1]}}; }
+inline Vec2 operator*(Vec2 a, Vec2 b) { return Vec2{{a.v[0] * b.v[0], a.v[1] * b.v[1]}}; }
+inline Vec2 operator/(Vec2 a, Vec2 b) { return Vec2{{a.v[0] / b.v[0], a.v[1] / b.v[1]}}; }
+inline Vec2 operator-(Vec2 a) { return Vec2{{-a.v[0], -a.v[1]}}; }
+inline Mask2 finite2(Vec2 a) { return Mask2{{std::isfinite(a.v[0]), std::isfinite(a.v[1])}}; }
+inline int bits2(Mask2 m) { return (m.m[0] ? 1 : 0) | (m.m[1] ? 2 : 0); }
+inline Vec2 select2(Mask2 m, Vec2 a, Vec2 b) {
+    return Vec2{{m.m[0] ? a.v[0] : b.v[0], m.m[1] ? a.v[1] : b.v[1]}};
+}
+#endif
+
+} // namespace fusion
+
+#endif // SIMD_VEC2_H
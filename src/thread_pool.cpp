@@ -0,0 +1,121 @@
+#include "thread_pool.h"
+
+namespace fusion {
+
+ThreadPool::ThreadPool(size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = default_thread_count();
+    }
+    queues_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; i++) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+    workers_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; i++) {
+        workers_.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        stop_ = true;
+    }
+    work_available_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::default_thread_count() {
+    size_t count = std::thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    size_t index;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        index = next_queue_++ % queues_.size();
+        unfinished_++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        queued_++;
+    }
+    work_available_.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    all_done_.wait(lock, [this] { return unfinished_ == 0; });
+}
+
+bool ThreadPool::try_pop(size_t index, std::function<void()>& task) {
+    WorkQueue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    // 자기 큐는 앞에서부터 처리
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool ThreadPool::try_steal(size_t thief, std::function<void()>& task) {
+    size_t count = queues_.size();
+    for (size_t offset = 1; offset < count; offset++) {
+        WorkQueue& victim = *queues_[(thief + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            // 다른 워커 큐는 뒤에서 가져와 소유 워커와의 경합을 줄임
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::worker_loop(size_t index) {
+    for (;;) {
+        std::function<void()> task;
+        if (try_pop(index, task) || try_steal(index, task)) {
+            {
+                std::lock_guard<std::mutex> lock(state_mutex_);
+                queued_--;
+            }
+            try {
+                task();
+            } catch (...) {
+                // 작업 예외는 작업 안에서 처리하는 것이 원칙이며, 워커는 계속 동작한다
+            }
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            if (--unfinished_ == 0) {
+                all_done_.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(state_mutex_);
+        work_available_.wait(lock, [this] { return stop_ || queued_ > 0; });
+        if (stop_ && queued_ <= 0) {
+            return;
+        }
+    }
+}
+
+void parallel_for(ThreadPool& pool, size_t count, const std::function<void(size_t)>& body) {
+    for (size_t i = 0; i < count; i++) {
+        pool.submit([&body, i] { body(i); });
+    }
+    pool.wait();
+}
+
+} // namespace fusion
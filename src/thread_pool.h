@@ -0,0 +1,87 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fusion {
+
+/**
+ * 작업 훔치기(work-stealing) 스레드 풀
+ *
+ * 워커마다 작업 큐를 두고, 자기 큐가 비면 다른 워커 큐의 반대쪽 끝에서 작업을 가져온다.
+ * 파일 단위처럼 작업 시간이 고르지 않을 때도 모든 코어가 계속 일하도록 한다.
+ */
+class ThreadPool {
+public:
+    /**
+     * @param thread_count 워커 스레드 수 (0이면 하드웨어 스레드 수)
+     */
+    explicit ThreadPool(size_t thread_count);
+
+    /**
+     * 남은 작업을 모두 끝낸 뒤 워커를 종료
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * 작업 추가 (워커 큐에 순서대로 분배)
+     * 작업에서 던진 예외는 풀 밖으로 전파되지 않으므로 작업 안에서 처리해야 한다.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * 지금까지 추가된 모든 작업이 끝날 때까지 대기
+     */
+    void wait();
+
+    size_t size() const { return workers_.size(); }
+
+    /**
+     * 기본 워커 수 (하드웨어 스레드 수, 알 수 없으면 1)
+     */
+    static size_t default_thread_count();
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    bool try_pop(size_t index, std::function<void()>& task);
+    bool try_steal(size_t thief, std::function<void()>& task);
+    void worker_loop(size_t index);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex state_mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable all_done_;
+    long queued_ = 0;          // 큐에 남아 있는 작업 수
+    size_t unfinished_ = 0;    // 추가되었지만 아직 끝나지 않은 작업 수
+    size_t next_queue_ = 0;
+    bool stop_ = false;
+};
+
+/**
+ * [0, count) 구간을 풀에서 병렬로 실행하고 모두 끝날 때까지 대기
+ *
+ * @param pool 스레드 풀
+ * @param count 반복 횟수
+ * @param body 각 인덱스에 대해 호출할 함수
+ */
+void parallel_for(ThreadPool& pool, size_t count, const std::function<void(size_t)>& body);
+
+} // namespace fusion
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,441 @@
+#include "timestamp.h"
+#include <cstring>
+
+namespace fusion {
+
+namespace {
+
+const int64_t MICROS_PER_SECOND = 1000000;
+const int64_t SECONDS_PER_DAY = 86400;
+const size_t DATE_CHARS = 11;   // "yyyy-mm-dd "
+const size_t MAX_FRACTION_DIGITS = 6;
+const size_t MAX_LEAD_WIDTH = 9;
+
+inline int64_t floor_div(int64_t value, int64_t divisor) {
+    int64_t quotient = value / divisor;
+    return (value % divisor < 0) ? quotient - 1 : quotient;
+}
+
+// 연속된 숫자를 최대 max_digits자리까지 읽고 읽은 자릿수를 반환
+size_t read_digits(const char*& p, const char* end, int64_t& value, size_t max_digits) {
+    value = 0;
+    size_t digits = 0;
+    while (p < end && digits < max_digits && *p >= '0' && *p <= '9') {
+        value = value * 10 + (*p - '0');
+        ++p;
+        ++digits;
+    }
+    return digits;
+}
+
+// 00 ~ 99 두 자리 문자
+const char DIGIT_PAIRS[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+inline char* write2(char* out, uint32_t value) {
+    std::memcpy(out, DIGIT_PAIRS + value * 2, 2);
+    return out + 2;
+}
+
+// 정확히 width자리로 기록 (0 <= value < 10^width, 32비트 연산으로 두 자리씩)
+inline char* write_fixed(char* out, uint32_t value, size_t width) {
+    size_t i = width;
+    for (; i >= 2; i -= 2) {
+        std::memcpy(out + i - 2, DIGIT_PAIRS + (value % 100) * 2, 2);
+        value /= 100;
+    }
+    if (i == 1) {
+        out[0] = static_cast<char>('0' + value);
+    }
+    return out + width;
+}
+
+// width자리 이상으로 0을 채워 기록 (value >= 0)
+char* write_padded(char* out, int64_t value, size_t width) {
+    if (width == 2 && value < 100) {
+        return write2(out, static_cast<uint32_t>(value));
+    }
+    char digits[20];
+    size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    for (size_t i = count; i < width; i++) {
+        *out++ = '0';
+    }
+    while (count > 0) {
+        *out++ = digits[--count];
+    }
+    return out;
+}
+
+// 그레고리력 날짜 <-> 1970-01-01 기준 일 수 (H. Hinnant의 civil 알고리즘)
+int64_t days_from_civil(int64_t year, int64_t month, int64_t day) {
+    year -= month <= 2;
+    const int64_t era = floor_div(year, 400);
+    const int64_t year_of_era = year - era * 400;
+    const int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+void civil_from_days(int64_t days, int64_t& year, int64_t& month, int64_t& day) {
+    days += 719468;
+    const int64_t era = floor_div(days, 146097);
+    const int64_t day_of_era = days - era * 146097;
+    const int64_t year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    const int64_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    const int64_t mp = (5 * day_of_year + 2) / 153;
+    day = day_of_year - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = year_of_era + era * 400 + (month <= 2);
+}
+
+bool is_leap_year(int64_t year) {
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+int64_t days_in_month(int64_t year, int64_t month) {
+    static const int64_t DAYS[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return month == 2 && is_leap_year(year) ? 29 : DAYS[month - 1];
+}
+
+// 날짜와 날짜/시간 구분자 기록 (DATE_CHARS자, 연도가 4자리를 벗어나면 nullptr)
+char* write_date(char* p, int64_t days, const TimestampLayout& layout) {
+    int64_t year = 0, month = 0, day = 0;
+    civil_from_days(days, year, month, day);
+    if (year < 0 || year > 9999) {
+        return nullptr;
+    }
+    p = write_fixed(p, static_cast<uint32_t>(year), 4);
+    *p++ = layout.date_separator;
+    p = write2(p, static_cast<uint32_t>(month));
+    *p++ = layout.date_separator;
+    p = write2(p, static_cast<uint32_t>(day));
+    *p++ = layout.time_separator;
+    return p;
+}
+
+// 시각 부분 기록: seconds는 DateTime이면 그날의 초, 아니면 전체 초
+char* write_clock(char* p, int64_t seconds, int64_t fraction, const TimestampLayout& layout) {
+    const uint32_t second = static_cast<uint32_t>(seconds % 60);
+    if (layout.kind == TimestampKind::MinuteSecond) {
+        p = write_padded(p, seconds / 60, layout.lead_width);
+    } else {
+        if (layout.kind == TimestampKind::DateTime) {
+            p = write2(p, static_cast<uint32_t>(seconds / 3600));
+        } else {
+            p = write_padded(p, seconds / 3600, layout.lead_width);
+        }
+        *p++ = ':';
+        p = write2(p, static_cast<uint32_t>(seconds / 60 % 60));
+    }
+    *p++ = ':';
+    p = write2(p, second);
+
+    if (layout.fraction_digits > 0) {
+        static const uint32_t SCALE[MAX_FRACTION_DIGITS + 1] = {1000000, 100000, 10000, 1000, 100, 10, 1};
+        *p++ = '.';
+        p = write_fixed(p, static_cast<uint32_t>(fraction) / SCALE[layout.fraction_digits], layout.fraction_digits);
+    }
+    return p;
+}
+
+// 소수 부분 ([.f], 최대 6자리) 해석 후 끝까지 읽었는지 확인
+bool parse_fraction(const char* p, const char* end, int64_t& micros, uint8_t& fraction_digits) {
+    micros = 0;
+    fraction_digits = 0;
+    if (p < end && *p == '.') {
+        ++p;
+        size_t digits = read_digits(p, end, micros, MAX_FRACTION_DIGITS);
+        if (digits == 0) {
+            return false;
+        }
+        for (size_t i = digits; i < MAX_FRACTION_DIGITS; i++) {
+            micros *= 10;
+        }
+        fraction_digits = static_cast<uint8_t>(digits);
+    }
+    return p == end;
+}
+
+inline bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// 고정 위치 두 자리 숫자
+inline bool read2(const char* p, int64_t& value) {
+    if (!is_digit(p[0]) || !is_digit(p[1])) {
+        return false;
+    }
+    value = (p[0] - '0') * 10 + (p[1] - '0');
+    return true;
+}
+
+// DateTime의 시각 부분 (HH:MM:SS[.f]) 해석: 그날 0시 기준 마이크로초
+bool parse_day_clock(const char* p, const char* end, int64_t& micros, uint8_t& fraction_digits) {
+    int64_t hour = 0, minute = 0, second = 0;
+    if (end - p < 8 || !read2(p, hour) || p[2] != ':' || !read2(p + 3, minute) || p[5] != ':' ||
+        !read2(p + 6, second) || hour > 23 || minute > 59 || second > 59) {
+        return false;
+    }
+    int64_t fraction = 0;
+    if (!parse_fraction(p + 8, end, fraction, fraction_digits)) {
+        return false;
+    }
+    micros = (hour * 3600 + minute * 60 + second) * MICROS_PER_SECOND + fraction;
+    return true;
+}
+
+} // namespace
+
+bool parse_timestamp(std::string_view text, Timestamp& timestamp) {
+    if (text.empty() || text.size() >= MAX_TIMESTAMP_CHARS) {
+        return false;
+    }
+    const char* p = text.data();
+    const char* end = p + text.size();
+    Timestamp parsed;
+    TimestampLayout& layout = parsed.layout;
+
+    if (text.size() >= DATE_CHARS && (p[4] == '-' || p[4] == '/')) {
+        // yyyy-mm-dd HH:MM:SS[.f]
+        int64_t century = 0, year = 0, month = 0, day = 0;
+        layout.kind = TimestampKind::DateTime;
+        layout.date_separator = p[4];
+        layout.time_separator = p[10];
+        if (!read2(p, century) || !read2(p + 2, year) || !read2(p + 5, month) || p[7] != p[4] ||
+            !read2(p + 8, day) || (p[10] != ' ' && p[10] != 'T')) {
+            return false;
+        }
+        year += century * 100;
+        if (month < 1 || month > 12 || day < 1 || day > days_in_month(year, month)) {
+            return false;
+        }
+        int64_t clock = 0;
+        if (!parse_day_clock(p + DATE_CHARS, end, clock, layout.fraction_digits)) {
+            return false;
+        }
+        parsed.micros = days_from_civil(year, month, day) * SECONDS_PER_DAY * MICROS_PER_SECOND + clock;
+    } else {
+        // H:MM:SS[.f] 또는 M:SS[.f]
+        int64_t first = 0, second_field = 0;
+        size_t first_width = read_digits(p, end, first, MAX_LEAD_WIDTH);
+        if (first_width == 0 || end - p < 3 || *p != ':' || !read2(p + 1, second_field) || second_field > 59) {
+            return false;
+        }
+        p += 3;
+        layout.lead_width = static_cast<uint8_t>(first_width);
+        if (p < end && *p == ':') {
+            int64_t second = 0;
+            if (end - p < 3 || !read2(p + 1, second) || second > 59) {
+                return false;
+            }
+            p += 3;
+            layout.kind = TimestampKind::HourMinuteSecond;
+            parsed.micros = (first * 3600 + second_field * 60 + second) * MICROS_PER_SECOND;
+        } else {
+            layout.kind = TimestampKind::MinuteSecond;
+            parsed.micros = (first * 60 + second_field) * MICROS_PER_SECOND;
+        }
+        int64_t fraction = 0;
+        if (!parse_fraction(p, end, fraction, layout.fraction_digits)) {
+            return false;
+        }
+        parsed.micros += fraction;
+    }
+
+    // 필드 자릿수가 고정되어 있고 범위를 확인했으므로 다시 포맷하면 원문과 같음
+    timestamp = parsed;
+    return true;
+}
+
+size_t format_timestamp(const Timestamp& timestamp, char* out) {
+    const TimestampLayout& layout = timestamp.layout;
+    if (layout.kind == TimestampKind::None || layout.lead_width > MAX_LEAD_WIDTH ||
+        layout.fraction_digits > MAX_FRACTION_DIGITS) {
+        return 0;
+    }
+
+    const int64_t seconds = floor_div(timestamp.micros, MICROS_PER_SECOND);
+    const int64_t fraction = timestamp.micros - seconds * MICROS_PER_SECOND;
+    char* p = out;
+    if (layout.kind == TimestampKind::DateTime) {
+        const int64_t days = floor_div(seconds, SECONDS_PER_DAY);
+        p = write_date(p, days, layout);
+        if (!p) {
+            return 0;
+        }
+        p = write_clock(p, seconds - days * SECONDS_PER_DAY, fraction, layout);
+    } else {
+        if (seconds < 0) {
+            return 0;
+        }
+        p = write_clock(p, seconds, fraction, layout);
+    }
+    return static_cast<size_t>(p - out);
+}
+
+std::string_view TimestampBuffer::format(const Timestamp& timestamp) {
+    if (valid_ && last_.micros == timestamp.micros && last_.layout == timestamp.layout) {
+        return std::string_view(chars_, size_);
+    }
+    const TimestampLayout& layout = timestamp.layout;
+    const int64_t seconds = floor_div(timestamp.micros, MICROS_PER_SECOND);
+    const int64_t days = floor_div(seconds, SECONDS_PER_DAY);
+    if (valid_ && size_ > 0 && layout.kind == TimestampKind::DateTime && last_.layout == layout &&
+        days == floor_div(last_.micros, MICROS_PER_SECOND * SECONDS_PER_DAY)) {
+        // 같은 날짜: 앞의 날짜 부분은 그대로 두고 시각만 다시 기록
+        const int64_t fraction = timestamp.micros - seconds * MICROS_PER_SECOND;
+        char* end = write_clock(chars_ + DATE_CHARS, seconds - days * SECONDS_PER_DAY, fraction, layout);
+        size_ = static_cast<size_t>(end - chars_);
+    } else {
+        size_ = format_timestamp(timestamp, chars_);
+    }
+    last_ = timestamp;
+    valid_ = true;
+    return std::string_view(chars_, size_);
+}
+
+void RowTimestamp::assign(std::string_view datetime) {
+    if (parse_timestamp(datetime, timestamp)) {
+        unparsed.clear();
+        return;
+    }
+    timestamp = Timestamp();
+    unparsed.assign(datetime.data(), datetime.size());
+}
+
+std::string_view RowTimestamp::text(TimestampBuffer& buffer) const {
+    if (timestamp.layout.kind == TimestampKind::None) {
+        return unparsed;
+    }
+    return buffer.format(timestamp);
+}
+
+void TimestampColumn::clear() {
+    compact_ = true;
+    layout_ = TimestampLayout();
+    micros_.clear();
+    has_last_ = false;
+    text_.clear();
+    offsets_.clear();
+}
+
+void TimestampColumn::reserve(size_t rows) {
+    if (compact_) {
+        micros_.reserve(rows);
+    } else {
+        offsets_.reserve(rows + 1);
+    }
+}
+
+void TimestampColumn::push_back(std::string_view datetime) {
+    if (compact_) {
+        if (has_last_ && layout_.kind == TimestampKind::DateTime) {
+            // 직전 행과 날짜가 같으면 시각 부분만 해석
+            int64_t clock = 0;
+            uint8_t fraction_digits = 0;
+            if (datetime.size() >= DATE_CHARS && datetime.size() < MAX_TIMESTAMP_CHARS &&
+                std::memcmp(datetime.data(), last_text_, DATE_CHARS) == 0 &&
+                parse_day_clock(datetime.data() + DATE_CHARS, datetime.data() + datetime.size(), clock,
+                                fraction_digits) &&
+                fraction_digits == layout_.fraction_digits) {
+                micros_.push_back(last_day_micros_ + clock);
+                return;
+            }
+        } else if (has_last_ && datetime == std::string_view(last_text_, last_size_)) {
+            micros_.push_back(last_micros_);
+            return;
+        }
+        Timestamp timestamp;
+        if (parse_timestamp(datetime, timestamp) && (micros_.empty() || timestamp.layout == layout_)) {
+            layout_ = timestamp.layout;
+            micros_.push_back(timestamp.micros);
+            remember(datetime, timestamp.micros);
+            return;
+        }
+        convert_to_text();
+    }
+    push_text(datetime);
+}
+
+void TimestampColumn::append(std::string_view datetime, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    push_back(datetime);
+    if (compact_) {
+        micros_.insert(micros_.end(), count - 1, micros_.back());
+    } else {
+        for (size_t i = 1; i < count; i++) {
+            push_text(datetime);
+        }
+    }
+}
+
+void TimestampColumn::append(const int64_t* micros, size_t count, const TimestampLayout& layout) {
+    if (count == 0) {
+        return;
+    }
+    if (compact_ && (micros_.empty() || layout == layout_)) {
+        layout_ = layout;
+        micros_.insert(micros_.end(), micros, micros + count);
+        return;
+    }
+    if (compact_) {
+        convert_to_text();
+    }
+    TimestampBuffer buffer;
+    for (size_t i = 0; i < count; i++) {
+        push_text(buffer.format(Timestamp{micros[i], layout}));
+    }
+}
+
+void TimestampColumn::push_back(const TimestampColumn& other, size_t i) {
+    if (compact_ && other.compact_ && (micros_.empty() || other.layout_ == layout_)) {
+        layout_ = other.layout_;
+        micros_.push_back(other.micros_[i]);
+        return;
+    }
+    TimestampBuffer buffer;
+    push_back(other.text(i, buffer));
+}
+
+void TimestampColumn::remember(std::string_view datetime, int64_t micros) {
+    const int64_t micros_per_day = SECONDS_PER_DAY * MICROS_PER_SECOND;
+    std::memcpy(last_text_, datetime.data(), datetime.size());
+    last_size_ = datetime.size();
+    last_micros_ = micros;
+    last_day_micros_ = floor_div(micros, micros_per_day) * micros_per_day;
+    has_last_ = true;
+}
+
+void TimestampColumn::push_text(std::string_view datetime) {
+    if (offsets_.empty()) {
+        offsets_.push_back(0);
+    }
+    text_.append(datetime.data(), datetime.size());
+    offsets_.push_back(static_cast<uint32_t>(text_.size()));
+}
+
+void TimestampColumn::convert_to_text() {
+    compact_ = false;
+    has_last_ = false;
+    offsets_.clear();
+    offsets_.reserve(micros_.capacity() + 1);
+    offsets_.push_back(0);
+    text_.clear();
+    TimestampBuffer buffer;
+    for (int64_t micros : micros_) {
+        std::string_view datetime = buffer.format(Timestamp{micros, layout_});
+        text_.append(datetime.data(), datetime.size());
+        offsets_.push_back(static_cast<uint32_t>(text_.size()));
+    }
+    micros_.clear();
+}
+
+} // namespace fusion
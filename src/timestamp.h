@@ -0,0 +1,183 @@
+#ifndef TIMESTAMP_H
+#define TIMESTAMP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fusion {
+
+// 타임스탬프 원문 최대 길이 (지원하는 형식 기준)
+constexpr size_t MAX_TIMESTAMP_CHARS = 32;
+
+// 타임스탬프 원문 형식 종류
+enum class TimestampKind : uint8_t {
+    None,               // 해석하지 못함 (정수로 포맷하면 빈 문자열)
+    DateTime,           // yyyy-mm-dd HH:MM:SS[.f] (날짜 구분자 '-' 또는 '/', 날짜/시간 사이 ' ' 또는 'T')
+    HourMinuteSecond,   // H:MM:SS[.f] (날짜 없음)
+    MinuteSecond        // M:SS[.f] (날짜/시 없음, 예: 10:00.0)
+};
+
+// 원문을 그대로 다시 만들기 위한 형식 정보
+struct TimestampLayout {
+    TimestampKind kind = TimestampKind::None;
+    char date_separator = '-';      // DateTime: 연-월-일 구분자
+    char time_separator = ' ';      // DateTime: 날짜와 시간 사이 구분자
+    uint8_t lead_width = 2;         // 날짜가 없을 때 첫 필드(시 또는 분)의 자릿수 (0으로 채움)
+    uint8_t fraction_digits = 0;    // 소수점 아래 자릿수 (0이면 소수점 없음, 최대 6)
+
+    bool operator==(const TimestampLayout& other) const {
+        return kind == other.kind && date_separator == other.date_separator &&
+               time_separator == other.time_separator && lead_width == other.lead_width &&
+               fraction_digits == other.fraction_digits;
+    }
+    bool operator!=(const TimestampLayout& other) const { return !(*this == other); }
+};
+
+/**
+ * 정수 타임스탬프
+ *
+ * micros는 DateTime이면 1970-01-01 00:00:00(UTC로 간주) 기준 마이크로초,
+ * 날짜가 없는 형식이면 0:00(HourMinuteSecond) 또는 0분(MinuteSecond) 기준 마이크로초이다.
+ * layout과 함께 format_timestamp로 원문을 그대로 다시 만든다.
+ */
+struct Timestamp {
+    int64_t micros = 0;
+    TimestampLayout layout;
+};
+
+/**
+ * 타임스탬프 원문 해석
+ *
+ * 다시 포맷했을 때 원문과 정확히 같아지는 경우에만 성공한다
+ * (자릿수가 다르거나 범위를 벗어난 값, 마이크로초보다 정밀한 소수는 실패).
+ *
+ * @param text 원문
+ * @param timestamp 결과를 저장할 타임스탬프
+ * @return 성공 시 true
+ */
+bool parse_timestamp(std::string_view text, Timestamp& timestamp);
+
+/**
+ * 타임스탬프를 원문 형식으로 포맷
+ *
+ * @param timestamp 타임스탬프 (layout.kind가 None이면 빈 문자열)
+ * @param out 출력 버퍼 (MAX_TIMESTAMP_CHARS 이상)
+ * @return 기록한 문자 수
+ */
+size_t format_timestamp(const Timestamp& timestamp, char* out);
+
+/**
+ * 포맷한 타임스탬프 원문 버퍼 (같은 값이 이어지면 다시 포맷하지 않음)
+ */
+class TimestampBuffer {
+public:
+    std::string_view format(const Timestamp& timestamp);
+
+private:
+    char chars_[MAX_TIMESTAMP_CHARS];
+    size_t size_ = 0;
+    Timestamp last_;
+    bool valid_ = false;
+};
+
+/**
+ * 행 단위 타임스탬프 (InputData/OutputData)
+ *
+ * 지원하는 형식이면 정수로, 아니면 원문을 unparsed에 그대로 보관한다 (문자열은 그때만 할당).
+ */
+struct RowTimestamp {
+    Timestamp timestamp;
+    std::string unparsed;   // timestamp.layout.kind가 None일 때의 원문
+
+    /**
+     * 원문 설정 (해석할 수 없으면 원문을 보관)
+     */
+    void assign(std::string_view datetime);
+
+    /**
+     * 원문
+     *
+     * @param buffer 정수로 저장된 값을 포맷할 버퍼 (반환값은 buffer나 이 값이 바뀌기 전까지 유효)
+     */
+    std::string_view text(TimestampBuffer& buffer) const;
+};
+
+/**
+ * 타임스탬프 컬럼
+ *
+ * 모든 행이 같은 형식으로 해석되면 행마다 정수 하나(8바이트)만 저장하고 원문은 출력할 때 다시 만든다.
+ * 해석할 수 없거나 형식이 다른 행이 들어오면 그때까지의 행을 원문으로 바꿔
+ * 원문을 하나의 버퍼에 이어 붙여 저장하는 방식으로 전환한다 (clear() 전까지 유지).
+ * 어느 쪽이든 행마다 문자열을 할당하지 않으며, 출력은 입력 원문과 같다.
+ */
+class TimestampColumn {
+public:
+    size_t size() const { return compact_ ? micros_.size() : (offsets_.empty() ? 0 : offsets_.size() - 1); }
+
+    void clear();
+    void reserve(size_t rows);
+
+    /**
+     * 원문 한 행 추가 (직전 행과 원문 또는 날짜가 같으면 그 부분은 다시 해석하지 않음)
+     */
+    void push_back(std::string_view datetime);
+
+    /**
+     * 같은 원문을 count행 추가 (해석은 한 번)
+     */
+    void append(std::string_view datetime, size_t count);
+
+    /**
+     * layout 형식의 정수 타임스탬프 count행 추가 (컬럼과 형식이 같으면 정수만 복사)
+     */
+    void append(const int64_t* micros, size_t count, const TimestampLayout& layout);
+
+    /**
+     * 다른 컬럼의 i번째 행 추가 (두 컬럼의 형식이 같으면 정수만 복사)
+     */
+    void push_back(const TimestampColumn& other, size_t i);
+
+    /**
+     * i번째 행의 원문
+     *
+     * @param buffer 정수로 저장된 행을 포맷할 버퍼 (반환값은 buffer나 컬럼이 바뀌기 전까지 유효)
+     */
+    std::string_view text(size_t i, TimestampBuffer& buffer) const {
+        if (compact_) {
+            return buffer.format(Timestamp{micros_[i], layout_});
+        }
+        return std::string_view(text_.data() + offsets_[i], offsets_[i + 1] - offsets_[i]);
+    }
+
+    // 모든 행이 정수로 저장되어 있으면 true (이때만 micros()/layout() 사용 가능)
+    bool compact() const { return compact_; }
+    int64_t micros(size_t i) const { return micros_[i]; }
+    const TimestampLayout& layout() const { return layout_; }
+
+private:
+    void remember(std::string_view datetime, int64_t micros);
+    void push_text(std::string_view datetime);
+    void convert_to_text();
+
+    bool compact_ = true;
+    TimestampLayout layout_;
+    std::vector<int64_t> micros_;
+
+    // 마지막으로 해석한 원문 (연속된 같은 원문은 해석 결과를, DateTime은 같은 날짜를 재사용)
+    char last_text_[MAX_TIMESTAMP_CHARS];
+    size_t last_size_ = 0;
+    int64_t last_micros_ = 0;
+    int64_t last_day_micros_ = 0;
+    bool has_last_ = false;
+
+    // 원문 저장 방식
+    std::string text_;
+    std::vector<uint32_t> offsets_;
+};
+
+} // namespace fusion
+
+#endif // TIMESTAMP_H
@@ -0,0 +1,308 @@
+// 고정 지연 평활기 회귀 테스트
+//
+// 입력은 bin/input.csv 앞부분에 Fix=0 구간과 한 축만 GPS가 없는 행을 넣은 것이며,
+// 처리 호출을 나누고 중간 호출도 hold_first로 시작해 항등 게인 경로를 지나게 한다.
+// - lag >= 샘플 수이면 flush 출력이 전체 오프라인 RTS 평활과 같아야 한다.
+// - lag = L이면 샘플 k의 출력이 k + L까지의 입력으로 평활한 RTS 값과 같아야 한다.
+// - lag = 0이면 DualAxisKalmanFilter의 필터 출력과 같아야 한다.
+// 연산 순서가 달라 모두 SMOOTHER_TOLERANCE 안에서 비교한다.
+//
+// 사용법: fixed_lag_smoother_test <bin/input.csv>
+
+#include "csv_parser.h"
+#include "dual_axis_kalman_filter.h"
+#include "fixed_lag_smoother.h"
+#include "test_check.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace fusion;
+using test::check;
+
+namespace {
+
+// 참조 구현 대비 허용 편차 (변위 단위)
+constexpr double SMOOTHER_TOLERANCE = 1e-9;
+
+const size_t TEST_ROWS = 3000;
+const size_t MIDDLE_LAG = 50;
+
+// 처리 호출 경계와 호출별 hold_first (첫 호출과 세 번째 호출이 첫 샘플을 유지)
+struct Batch {
+    size_t begin;
+    size_t end;
+    bool hold_first;
+};
+const Batch BATCHES[] = {
+    {0, 700, true},
+    {700, 701, false},
+    {701, 1600, true},
+    {1600, TEST_ROWS, false},
+};
+
+struct Outputs {
+    std::vector<double> y;
+    std::vector<double> z;
+};
+
+// bin/input.csv 앞부분에 GPS 단절과 한 축만 NaN인 GPS 행을 넣음
+SampleBlock make_input(const SampleBlock& source) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    SampleBlock samples;
+    samples.gps_y.assign(source.gps_y.begin(), source.gps_y.begin() + TEST_ROWS);
+    samples.gps_z.assign(source.gps_z.begin(), source.gps_z.begin() + TEST_ROWS);
+    samples.acc_y.assign(source.acc_y.begin(), source.acc_y.begin() + TEST_ROWS);
+    samples.acc_z.assign(source.acc_z.begin(), source.acc_z.begin() + TEST_ROWS);
+    samples.fix.assign(source.fix.begin(), source.fix.begin() + TEST_ROWS);
+
+    for (size_t i = 1200; i < 1500; i++) {
+        samples.fix[i] = 0;
+    }
+    for (size_t i = 2000; i < 2400; i++) {
+        if (samples.fix[i] >= 1) {
+            ((i / 10) % 2 == 0 ? samples.gps_y[i] : samples.gps_z[i]) = nan;
+        }
+    }
+    return samples;
+}
+
+/**
+ * 한 축의 오프라인 RTS 평활 (참조 구현)
+ *
+ * held[j]가 true인 샘플은 예측/업데이트 없이 직전 상태를 유지하므로
+ * x(j|j-1) = x(j-1|j-1), 평활 게인 C(j-1) = I이다.
+ *
+ * @param count 앞에서부터 평활할 샘플 수
+ */
+std::vector<double> reference_rts(const KalmanParams& params, const std::vector<double>& gps,
+                                  const std::vector<double>& acc, const std::vector<int>& fix,
+                                  const std::vector<bool>& held, double initial, size_t count) {
+    const double dt = params.dt;
+    struct Step {
+        double x[2];        // x(j|j)
+        double p[2][2];     // P(j|j)
+        double x_next[2];   // x(j+1|j)
+        double p_next[2][2];
+        bool identity;      // C(j) = I
+    };
+    std::vector<Step> steps(count);
+
+    double x[2] = {initial, 0.0};
+    double p[2][2] = {{1.0, 0.0}, {0.0, 1.0}};
+    for (size_t j = 0; j < count; j++) {
+        if (!held[j]) {
+            // 예측: x = F x + B u, P = F P F^T + Q I
+            x[0] = x[0] + dt * x[1] + 0.5 * dt * dt * acc[j];
+            x[1] = x[1] + dt * acc[j];
+            double p00 = p[0][0] + dt * (p[0][1] + p[1][0]) + dt * dt * p[1][1] + params.Q;
+            double p01 = p[0][1] + dt * p[1][1];
+            double p10 = p[1][0] + dt * p[1][1];
+            double p11 = p[1][1] + params.Q;
+            p[0][0] = p00;
+            p[0][1] = p01;
+            p[1][0] = p10;
+            p[1][1] = p11;
+        }
+        if (j > 0) {
+            Step& previous = steps[j - 1];
+            std::copy(x, x + 2, previous.x_next);
+            std::copy(&p[0][0], &p[0][0] + 4, &previous.p_next[0][0]);
+            previous.identity = held[j];
+        }
+        if (!held[j] && fix[j] >= 1 && std::isfinite(gps[j])) {
+            // 업데이트: H = [1, 0]
+            double s = p[0][0] + params.R;
+            double k0 = p[0][0] / s;
+            double k1 = p[1][0] / s;
+            double innovation = gps[j] - x[0];
+            x[0] += k0 * innovation;
+            x[1] += k1 * innovation;
+            double p00 = (1.0 - k0) * p[0][0];
+            double p01 = (1.0 - k0) * p[0][1];
+            double p10 = p[1][0] - k1 * p[0][0];
+            double p11 = p[1][1] - k1 * p[0][1];
+            p[0][0] = p00;
+            p[0][1] = p01;
+            p[1][0] = p10;
+            p[1][1] = p11;
+        }
+        std::copy(x, x + 2, steps[j].x);
+        std::copy(&p[0][0], &p[0][0] + 4, &steps[j].p[0][0]);
+    }
+
+    // 역방향: x(j|n) = x(j|j) + C(j) (x(j+1|n) - x(j+1|j)), C(j) = P(j|j) F^T P(j+1|j)^-1
+    std::vector<double> smoothed(count);
+    double xs[2] = {steps[count - 1].x[0], steps[count - 1].x[1]};
+    smoothed[count - 1] = xs[0];
+    for (size_t j = count - 1; j-- > 0;) {
+        const Step& s = steps[j];
+        double d0 = xs[0] - s.x_next[0];
+        double d1 = xs[1] - s.x_next[1];
+        if (s.identity) {
+            xs[0] = s.x[0] + d0;
+            xs[1] = s.x[1] + d1;
+        } else {
+            double a00 = s.p[0][0] + dt * s.p[0][1];
+            double a01 = s.p[0][1];
+            double a10 = s.p[1][0] + dt * s.p[1][1];
+            double a11 = s.p[1][1];
+            double det = s.p_next[0][0] * s.p_next[1][1] - s.p_next[0][1] * s.p_next[1][0];
+            double inv00 = s.p_next[1][1] / det;
+            double inv01 = -s.p_next[0][1] / det;
+            double inv10 = -s.p_next[1][0] / det;
+            double inv11 = s.p_next[0][0] / det;
+            double c00 = a00 * inv00 + a01 * inv10;
+            double c01 = a00 * inv01 + a01 * inv11;
+            double c10 = a10 * inv00 + a11 * inv10;
+            double c11 = a10 * inv01 + a11 * inv11;
+            xs[0] = s.x[0] + c00 * d0 + c01 * d1;
+            xs[1] = s.x[1] + c10 * d0 + c11 * d1;
+        }
+        smoothed[j] = xs[0];
+    }
+    return smoothed;
+}
+
+std::vector<bool> held_samples() {
+    std::vector<bool> held(TEST_ROWS, false);
+    for (const Batch& batch : BATCHES) {
+        held[batch.begin] = held[batch.begin] || batch.hold_first;
+    }
+    return held;
+}
+
+// BATCHES대로 나눠 평활하고 flush까지 모은 출력
+Outputs run_smoother(const KalmanParams& params, const SampleBlock& samples, size_t lag) {
+    FixedLagSmoother smoother(params, lag);
+    smoother.reset(samples.gps_y[0], samples.gps_z[0]);
+
+    Outputs out{std::vector<double>(TEST_ROWS), std::vector<double>(TEST_ROWS)};
+    size_t written = 0;
+    for (const Batch& batch : BATCHES) {
+        size_t count = batch.end - batch.begin;
+        std::vector<double> y(count);
+        std::vector<double> z(count);
+        size_t emitted = 0;
+        bool ok = smoother.processBatch(
+            Span<const double>(samples.gps_y.data() + batch.begin, count),
+            Span<const double>(samples.gps_z.data() + batch.begin, count),
+            Span<const double>(samples.acc_y.data() + batch.begin, count),
+            Span<const double>(samples.acc_z.data() + batch.begin, count),
+            Span<const int>(samples.fix.data() + batch.begin, count), y, z, batch.hold_first, emitted);
+        check(ok, "smoother accepts matching sizes");
+        std::copy(y.begin(), y.begin() + emitted, out.y.begin() + written);
+        std::copy(z.begin(), z.begin() + emitted, out.z.begin() + written);
+        written += emitted;
+    }
+    check(written + smoother.pending() == TEST_ROWS && smoother.pending() == std::min(lag, TEST_ROWS),
+          "smoother holds back exactly lag samples (lag = " + std::to_string(lag) + ")");
+
+    std::vector<double> y(smoother.pending());
+    std::vector<double> z(smoother.pending());
+    size_t emitted = 0;
+    check(smoother.flush(y, z, emitted), "flush succeeds");
+    std::copy(y.begin(), y.begin() + emitted, out.y.begin() + written);
+    std::copy(z.begin(), z.begin() + emitted, out.z.begin() + written);
+    written += emitted;
+    check(written == TEST_ROWS && smoother.pending() == 0, "flush emits every pending sample");
+    return out;
+}
+
+double max_difference(const std::vector<double>& a, const std::vector<double>& b, size_t begin, size_t end) {
+    double result = 0.0;
+    for (size_t i = begin; i < end; i++) {
+        double d = std::fabs(a[i] - b[i]);
+        result = std::max(result, std::isnan(d) ? std::numeric_limits<double>::infinity() : d);
+    }
+    return result;
+}
+
+void test_full_lag(const KalmanParams& params, const SampleBlock& samples, const std::vector<bool>& held) {
+    Outputs smoothed = run_smoother(params, samples, TEST_ROWS);
+    std::vector<double> rts_y = reference_rts(params, samples.gps_y, samples.acc_y, samples.fix, held,
+                                              samples.gps_y[0], TEST_ROWS);
+    std::vector<double> rts_z = reference_rts(params, samples.gps_z, samples.acc_z, samples.fix, held,
+                                              samples.gps_z[0], TEST_ROWS);
+    double deviation = std::max(max_difference(smoothed.y, rts_y, 0, TEST_ROWS),
+                                max_difference(smoothed.z, rts_z, 0, TEST_ROWS));
+    check(deviation < SMOOTHER_TOLERANCE,
+          "lag >= rows matches offline RTS (max |d| = " + std::to_string(deviation) + ")");
+}
+
+void test_middle_lag(const KalmanParams& params, const SampleBlock& samples, const std::vector<bool>& held) {
+    Outputs smoothed = run_smoother(params, samples, MIDDLE_LAG);
+
+    // 호출 경계, 유지한 샘플, GPS 단절, NaN 축 구간 근처의 샘플 (k + L까지의 RTS와 비교)
+    const size_t samples_to_check[] = {0, 1, 650, 699, 700, 701, 702, 1190, 1250, 1499, 1600, 2005, 2398,
+                                       TEST_ROWS - MIDDLE_LAG - 1};
+    double deviation = 0.0;
+    for (size_t k : samples_to_check) {
+        size_t count = k + MIDDLE_LAG + 1;
+        std::vector<double> rts_y = reference_rts(params, samples.gps_y, samples.acc_y, samples.fix, held,
+                                                  samples.gps_y[0], count);
+        std::vector<double> rts_z = reference_rts(params, samples.gps_z, samples.acc_z, samples.fix, held,
+                                                  samples.gps_z[0], count);
+        deviation = std::max(deviation, std::max(max_difference(smoothed.y, rts_y, k, k + 1),
+                                                 max_difference(smoothed.z, rts_z, k, k + 1)));
+    }
+
+    // 입력 끝의 lag개 샘플은 마지막 샘플까지의 전체 평활
+    std::vector<double> rts_y = reference_rts(params, samples.gps_y, samples.acc_y, samples.fix, held,
+                                              samples.gps_y[0], TEST_ROWS);
+    std::vector<double> rts_z = reference_rts(params, samples.gps_z, samples.acc_z, samples.fix, held,
+                                              samples.gps_z[0], TEST_ROWS);
+    deviation = std::max(deviation, std::max(max_difference(smoothed.y, rts_y, TEST_ROWS - MIDDLE_LAG, TEST_ROWS),
+                                             max_difference(smoothed.z, rts_z, TEST_ROWS - MIDDLE_LAG, TEST_ROWS)));
+    check(deviation < SMOOTHER_TOLERANCE,
+          "lag = " + std::to_string(MIDDLE_LAG) + " matches RTS over k + lag (max |d| = " +
+              std::to_string(deviation) + ")");
+}
+
+void test_zero_lag(const KalmanParams& params, const SampleBlock& samples) {
+    Outputs smoothed = run_smoother(params, samples, 0);
+
+    DualAxisKalmanFilter filter(params);
+    filter.reset(samples.gps_y[0], samples.gps_z[0]);
+    Outputs filtered{std::vector<double>(TEST_ROWS), std::vector<double>(TEST_ROWS)};
+    for (const Batch& batch : BATCHES) {
+        size_t count = batch.end - batch.begin;
+        filter.processBatch(Span<const double>(samples.gps_y.data() + batch.begin, count),
+                            Span<const double>(samples.gps_z.data() + batch.begin, count),
+                            Span<const double>(samples.acc_y.data() + batch.begin, count),
+                            Span<const double>(samples.acc_z.data() + batch.begin, count),
+                            Span<const int>(samples.fix.data() + batch.begin, count),
+                            Span<double>(filtered.y.data() + batch.begin, count),
+                            Span<double>(filtered.z.data() + batch.begin, count), batch.hold_first);
+    }
+    double deviation = std::max(max_difference(smoothed.y, filtered.y, 0, TEST_ROWS),
+                                max_difference(smoothed.z, filtered.z, 0, TEST_ROWS));
+    check(deviation < SMOOTHER_TOLERANCE,
+          "lag = 0 matches DualAxisKalmanFilter (max |d| = " + std::to_string(deviation) + ")");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: fixed_lag_smoother_test <input.csv>" << std::endl;
+        return 2;
+    }
+
+    SampleBlock source;
+    if (!parse_csv(argv[1], source) || source.size() < TEST_ROWS) {
+        std::cerr << "cannot read " << argv[1] << std::endl;
+        return 2;
+    }
+    SampleBlock samples = make_input(source);
+    std::vector<bool> held = held_samples();
+    const KalmanParams params(0.1, 0.01);
+
+    test_full_lag(params, samples, held);
+    test_middle_lag(params, samples, held);
+    test_zero_lag(params, samples);
+
+    return test::finish("fixed_lag_smoother_test");
+}
@@ -0,0 +1,91 @@
+// 공분산 k단계 닫힌 형식 예측 회귀 테스트
+//
+// predict_covariance_steps(p, k)는 predict_covariance를 k번 반복한 결과와
+// k = 1이면 비트 단위로, 그 외에는 상대 오차 STEPS_TOLERANCE 안에서 같아야 한다.
+// 레인마다 Q가 다른 경우(파라미터 스윕)와 대칭이 아닌 공분산도 검사한다.
+
+#include "kalman_lanes.h"
+#include "test_check.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+using namespace fusion;
+using test::check;
+
+namespace {
+
+// 반복 예측 대비 허용 상대 오차 (측정값은 k = 1000에서도 1e-14 수준)
+constexpr double STEPS_TOLERANCE = 1e-12;
+
+double relative_difference(Vec2 closed, Vec2 repeated) {
+    double result = 0.0;
+    double lanes_closed[2] = {lane0(closed), lane1(closed)};
+    double lanes_repeated[2] = {lane0(repeated), lane1(repeated)};
+    for (int lane = 0; lane < 2; lane++) {
+        double scale = std::max(std::fabs(lanes_repeated[lane]), 1.0);
+        result = std::max(result, std::fabs(lanes_closed[lane] - lanes_repeated[lane]) / scale);
+    }
+    return result;
+}
+
+bool bitwise_equal(Vec2 a, Vec2 b) {
+    return lane0(a) == lane0(b) && lane1(a) == lane1(b);
+}
+
+void check_steps(const char* label, const Covariance2& start, const FilterConstants& c) {
+    const size_t step_counts[] = {1, 2, 10, 1000};
+    for (size_t steps : step_counts) {
+        Covariance2 closed = start;
+        predict_covariance_steps(closed, steps, c);
+
+        Covariance2 repeated = start;
+        for (size_t i = 0; i < steps; i++) {
+            predict_covariance(repeated, c);
+        }
+
+        std::string name = std::string(label) + ", k = " + std::to_string(steps);
+        if (steps == 1) {
+            check(bitwise_equal(closed.p00, repeated.p00) && bitwise_equal(closed.p01, repeated.p01) &&
+                  bitwise_equal(closed.p10, repeated.p10) && bitwise_equal(closed.p11, repeated.p11),
+                  name + ": closed form is bit-identical to one predict_covariance");
+            continue;
+        }
+
+        double deviation = std::max({relative_difference(closed.p00, repeated.p00),
+                                     relative_difference(closed.p01, repeated.p01),
+                                     relative_difference(closed.p10, repeated.p10),
+                                     relative_difference(closed.p11, repeated.p11)});
+        check(deviation < STEPS_TOLERANCE,
+              name + ": closed form matches repeated prediction (relative |d| = " + std::to_string(deviation) +
+                  ")");
+    }
+
+    Covariance2 unchanged = start;
+    predict_covariance_steps(unchanged, 0, c);
+    check(bitwise_equal(unchanged.p00, start.p00) && bitwise_equal(unchanged.p01, start.p01) &&
+          bitwise_equal(unchanged.p10, start.p10) && bitwise_equal(unchanged.p11, start.p11),
+          std::string(label) + ": k = 0 leaves the covariance unchanged");
+}
+
+} // namespace
+
+int main() {
+    const KalmanParams params(0.1, 0.01);
+    const FilterConstants same(params);
+    const FilterConstants sweep(KalmanParams(0.001, 0.01), KalmanParams(5.0, 0.5));
+
+    // 초기 공분산 (P = I)
+    const Covariance2 identity{splat2(1.0), splat2(0.0), splat2(0.0), splat2(1.0)};
+    // GPS 업데이트 직후 수준의 작은 공분산 (레인마다 다름)
+    const Covariance2 updated{make2(0.0091, 0.0087), make2(0.012, 0.011), make2(0.012, 0.011), make2(0.52, 0.49)};
+    // p01 != p10 (반올림으로 대칭이 깨진 경우)
+    const Covariance2 asymmetric{make2(2.5, 0.3), make2(-0.4, 0.07), make2(-0.3, 0.05), make2(0.8, 1.7)};
+
+    check_steps("identity", identity, same);
+    check_steps("updated", updated, same);
+    check_steps("asymmetric", asymmetric, same);
+    check_steps("per-lane Q", updated, sweep);
+
+    return test::finish("kalman_lanes_test");
+}
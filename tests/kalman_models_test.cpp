@@ -0,0 +1,204 @@
+// KalmanFilterT 모델 회귀 테스트
+//
+// - FixedDt<ConstantVelocityModel, 10000>은 dt = 0.01인 KalmanFilter와 비트 단위로 같아야 한다.
+// - AccelBiasModel은 가속도계에 일정한 바이어스가 있으면 그 값을 추정하고,
+//   GPS 단절 구간의 드리프트가 바이어스를 모르는 2상태 모델보다 작아야 한다.
+// - ConstantJerkModel은 가속도 측정과 GPS로 위치/가속도/저크를 추적해야 한다.
+//
+// 사용법: kalman_models_test <bin/input.csv>
+
+#include "csv_parser.h"
+#include "kalman_filter.h"
+#include "kalman_models.h"
+#include "test_check.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace fusion;
+using test::check;
+
+namespace {
+
+const double DT = 0.01;
+const size_t GPS_INTERVAL = 10;
+
+// 합성 궤적 (위치와 가속도계 입력, GPS는 GPS_INTERVAL 샘플마다, 구간 [gap_begin, gap_end)는 Fix = 0)
+struct Trajectory {
+    std::vector<double> position;
+    std::vector<double> acceleration;
+    std::vector<double> gps;
+    std::vector<double> acc;
+    std::vector<int> fix;
+};
+
+// 결정적인 작은 측정 잡음 ([-amplitude, amplitude] 균등 분포)
+class NoiseSource {
+public:
+    explicit NoiseSource(double amplitude) : amplitude_(amplitude) {}
+
+    double next() {
+        state_ = state_ * 6364136223846793005ULL + 1442695040888963407ULL;
+        double unit = static_cast<double>(state_ >> 11) / static_cast<double>(1ULL << 53);
+        return amplitude_ * (2.0 * unit - 1.0);
+    }
+
+private:
+    unsigned long long state_ = 0x2545F4914F6CDD1DULL;
+    double amplitude_;
+};
+
+// jerk가 0이 아니면 등저크 궤적, 아니면 사인파 가속도 궤적
+Trajectory make_trajectory(size_t rows, double acc_bias, double jerk, size_t gap_begin, size_t gap_end) {
+    Trajectory t;
+    NoiseSource gps_noise(0.02);
+    NoiseSource acc_noise(0.01);
+    for (size_t i = 0; i < rows; i++) {
+        double time = static_cast<double>(i) * DT;
+        double position;
+        double acceleration;
+        if (jerk != 0.0) {
+            position = jerk * time * time * time / 6.0;
+            acceleration = jerk * time;
+        } else {
+            double w = 0.5;
+            position = 2.0 * std::sin(w * time) / -(w * w) + 2.0 * time / w;
+            acceleration = 2.0 * std::sin(w * time);
+        }
+        bool has_gps = i % GPS_INTERVAL == 0 && (i < gap_begin || i >= gap_end);
+        t.position.push_back(position);
+        t.acceleration.push_back(acceleration);
+        t.gps.push_back(position + gps_noise.next());
+        t.acc.push_back(acceleration + acc_bias + acc_noise.next());
+        t.fix.push_back(has_gps ? 3 : 0);
+    }
+    return t;
+}
+
+template <typename Model>
+std::vector<double> run_filter(KalmanFilterT<Model>& filter, const Trajectory& t) {
+    std::vector<double> displacement(t.gps.size());
+    filter.reset(t.gps[0]);
+    filter.processBatch(t.gps, t.acc, t.fix, displacement, true);
+    return displacement;
+}
+
+// [begin, end) 구간의 참값 대비 최대 위치 오차 (NaN이면 무한대)
+double max_position_error(const std::vector<double>& displacement, const Trajectory& t, size_t begin, size_t end) {
+    double result = 0.0;
+    for (size_t i = begin; i < end; i++) {
+        double error = std::fabs(displacement[i] - t.position[i]);
+        result = std::max(result, std::isnan(error) ? INFINITY : error);
+    }
+    return result;
+}
+
+// KalmanFilter::process와 같은 초기 위치 (첫 번째 유효한 GPS)
+double first_valid_gps(const std::vector<double>& gps, const std::vector<int>& fix) {
+    for (size_t i = 0; i < gps.size(); i++) {
+        if (fix[i] >= 1 && std::isfinite(gps[i])) {
+            return gps[i];
+        }
+    }
+    return gps[0];
+}
+
+void test_fixed_dt(const SampleBlock& samples) {
+    const KalmanParams params(0.1, 0.01);
+    const std::vector<double>* gps_axes[2] = {&samples.gps_y, &samples.gps_z};
+    const std::vector<double>* acc_axes[2] = {&samples.acc_y, &samples.acc_z};
+    for (int axis = 0; axis < 2; axis++) {
+        KalmanFilter reference(params);
+        std::vector<double> expected = reference.process(*gps_axes[axis], *acc_axes[axis], samples.fix);
+
+        KalmanFilterT<FixedDt<ConstantVelocityModel, 10000>> fixed(params);
+        fixed.reset(first_valid_gps(*gps_axes[axis], samples.fix));
+        std::vector<double> actual(samples.size());
+        fixed.processBatch(*gps_axes[axis], *acc_axes[axis], samples.fix, actual, true);
+
+        std::string name = axis == 0 ? "Y" : "Z";
+        check(actual == expected, "FixedDt<ConstantVelocityModel, 10000> matches KalmanFilter bitwise (" + name + ")");
+        check(fixed.getStateVector()[1] == reference.getStateVector()[1] &&
+              fixed.getCovarianceMatrix()[0][0] == reference.getCovarianceMatrix()[0][0],
+              "FixedDt final velocity and covariance match KalmanFilter (" + name + ")");
+    }
+}
+
+void test_accel_bias() {
+    // 0.05 m/s^2 바이어스, 60초 중 40~45초 GPS 단절
+    const double bias = 0.05;
+    const size_t rows = 6000;
+    const size_t gap_begin = 4000;
+    const size_t gap_end = 4500;
+    Trajectory t = make_trajectory(rows, bias, 0.0, gap_begin, gap_end);
+    const KalmanParams params(1e-4, 0.01);
+
+    KalmanFilterT<AccelBiasModel> bias_filter(params);
+    std::vector<double> bias_output = run_filter(bias_filter, t);
+    KalmanFilterT<ConstantVelocityModel> plain_filter(params);
+    std::vector<double> plain_output = run_filter(plain_filter, t);
+
+    double estimated_bias = bias_filter.getStateVector()[2];
+    check(std::fabs(estimated_bias - bias) < 0.2 * bias,
+          "AccelBiasModel estimates the accelerometer bias (" + std::to_string(estimated_bias) + ")");
+    check(max_position_error(bias_output, t, 1000, rows) < 0.1, "AccelBiasModel tracks the trajectory");
+
+    double bias_drift = max_position_error(bias_output, t, gap_begin, gap_end);
+    double plain_drift = max_position_error(plain_output, t, gap_begin, gap_end);
+    check(bias_drift < 0.5 * plain_drift,
+          "AccelBiasModel drifts less than ConstantVelocityModel in a GPS gap (" + std::to_string(bias_drift) +
+              " vs " + std::to_string(plain_drift) + ")");
+}
+
+void test_constant_jerk() {
+    // 등저크 0.3 m/s^3, 가속도 측정은 매 샘플, GPS는 10샘플마다
+    const double jerk = 0.3;
+    const size_t rows = 3000;
+    Trajectory t = make_trajectory(rows, 0.0, jerk, rows, rows);
+    const KalmanParams params(1e-4, 0.01);
+
+    KalmanFilterT<ConstantJerkModel> filter(params);
+    std::vector<double> output = run_filter(filter, t);
+
+    const KalmanFilterT<ConstantJerkModel>::Vector& state = filter.getStateVector();
+    check(max_position_error(output, t, 500, rows) < 0.1, "ConstantJerkModel tracks the trajectory");
+    check(std::fabs(state[2] - t.acceleration.back()) < 0.05,
+          "ConstantJerkModel tracks the acceleration (" + std::to_string(state[2]) + ")");
+    check(std::fabs(state[3] - jerk) < 0.2 * jerk, "ConstantJerkModel estimates the jerk (" +
+                                                        std::to_string(state[3]) + ")");
+}
+
+// 실제 입력(GPS 10샘플마다, 빈 행 포함)에서 3/4상태 모델 출력이 모두 유한한지
+template <typename Model>
+void check_finite_on_input(const SampleBlock& samples, const char* name) {
+    KalmanFilterT<Model> filter(KalmanParams(0.1, 0.01));
+    std::vector<double> displacement(samples.size());
+    filter.reset(samples.gps_y[0]);
+    filter.processBatch(samples.gps_y, samples.acc_y, samples.fix, displacement, true);
+    bool finite = std::all_of(displacement.begin(), displacement.end(), [](double x) { return std::isfinite(x); });
+    check(finite, std::string(name) + " output is finite on the sample input");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: kalman_models_test <input.csv>" << std::endl;
+        return 2;
+    }
+
+    SampleBlock samples;
+    if (!parse_csv(argv[1], samples) || samples.empty()) {
+        std::cerr << "cannot read " << argv[1] << std::endl;
+        return 2;
+    }
+
+    test_fixed_dt(samples);
+    test_accel_bias();
+    test_constant_jerk();
+    check_finite_on_input<AccelBiasModel>(samples, "AccelBiasModel");
+    check_finite_on_input<ConstantJerkModel>(samples, "ConstantJerkModel");
+
+    return test::finish("kalman_models_test");
+}
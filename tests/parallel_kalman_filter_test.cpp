@@ -0,0 +1,223 @@
+// 시간 축 병렬 칼만 필터 회귀 테스트
+//
+// process_parallel_in_time은 구간 시작 상태의 계산 순서만 다를 뿐 순차 DualAxisKalmanFilter와
+// 같은 필터이므로, Fix=0 구간과 한 축만 GPS가 없는 행이 섞인 입력에서도 출력이
+// 반올림 오차 수준(PARALLEL_TOLERANCE)에서 같아야 한다.
+//
+// process_chunked_overlap은 근사이므로 청크 경계의 편차에 상한을 두고,
+// 웜업이 입력 시작에 닿으면 순차 필터와 비트 단위로 같아야 한다.
+//
+// 사용법: parallel_kalman_filter_test <bin/input.csv>
+
+#include "csv_parser.h"
+#include "dual_axis_kalman_filter.h"
+#include "fusion_api.h"
+#include "parallel_kalman_filter.h"
+#include "test_check.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace fusion;
+using test::check;
+
+namespace {
+
+// 순차 필터 대비 허용 편차 (변위 단위, 측정값은 1e-12 미만)
+constexpr double PARALLEL_TOLERANCE = 1e-9;
+
+// 웜업 없는 청크 처리의 경계 편차 상한 (P = I에서 다시 시작, 측정값 약 4.3e-4)
+constexpr double SEAM_TOLERANCE = 1e-3;
+// 경계에서 SEAM_SETTLE_ROWS 샘플 이후의 편차 상한 (측정값 약 6.4e-5)
+constexpr size_t SEAM_SETTLE_ROWS = 200;
+constexpr double SETTLED_SEAM_TOLERANCE = 2e-4;
+// 1000샘플 웜업 후의 경계 편차 상한 (측정값 약 4.6e-9)
+constexpr size_t WARMUP_ROWS = 1000;
+constexpr double WARMUP_SEAM_TOLERANCE = 1e-7;
+
+struct Outputs {
+    std::vector<double> y;
+    std::vector<double> z;
+};
+
+// 입력에 Fix=0 구간과 한 축만 NaN인 GPS 행을 넣어 구간 경계가 그 근처에 오도록 함
+void inject_gaps(SampleBlock& samples) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    size_t n = samples.size();
+
+    // 첫 구간 경계(n/3) 주변의 긴 GPS 단절
+    for (size_t i = n / 3 - 2000; i < n / 3 + 2000; i++) {
+        samples.fix[i] = 0;
+    }
+
+    // Fix >= 1이지만 Y 축만 없는 행, Z 축만 없는 행
+    for (size_t i = n / 2; i < n / 2 + 3000; i++) {
+        if (samples.fix[i] >= 1) {
+            ((i / 10) % 2 == 0 ? samples.gps_y[i] : samples.gps_z[i]) = nan;
+        }
+    }
+
+    // 두 번째 구간 경계(2n/3) 직전부터 Y 축만 계속 없음
+    for (size_t i = 2 * n / 3 - 500; i < 2 * n / 3 + 500; i++) {
+        if (samples.fix[i] >= 1) {
+            samples.gps_y[i] = nan;
+        }
+    }
+}
+
+size_t first_fix_row(const SampleBlock& samples) {
+    for (size_t i = 0; i < samples.size(); i++) {
+        if (samples.fix[i] >= 1 && std::isfinite(samples.gps_y[i]) && std::isfinite(samples.gps_z[i])) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+DualAxisKalmanFilter make_filter(const KalmanParams& params, const SampleBlock& samples) {
+    DualAxisKalmanFilter filter(params);
+    size_t first = first_fix_row(samples);
+    filter.reset(samples.gps_y[first], samples.gps_z[first]);
+    return filter;
+}
+
+Outputs run_serial(const KalmanParams& params, const SampleBlock& samples) {
+    Outputs out{std::vector<double>(samples.size()), std::vector<double>(samples.size())};
+    DualAxisKalmanFilter filter = make_filter(params, samples);
+    filter.processBatch(samples.gps_y, samples.gps_z, samples.acc_y, samples.acc_z, samples.fix,
+                        out.y, out.z, true);
+    return out;
+}
+
+double max_difference(const Outputs& a, const Outputs& b) {
+    double result = 0.0;
+    for (size_t i = 0; i < a.y.size(); i++) {
+        double dy = std::fabs(a.y[i] - b.y[i]);
+        double dz = std::fabs(a.z[i] - b.z[i]);
+        // NaN 출력은 최대 편차를 무한대로 만들어 실패시킴
+        result = std::max(result, std::isnan(dy) || std::isnan(dz) ? std::numeric_limits<double>::infinity()
+                                                                    : std::max(dy, dz));
+    }
+    return result;
+}
+
+void test_parallel_in_time(const KalmanParams& params, const SampleBlock& samples, const Outputs& serial) {
+    // 입력 길이에 관계없이 구간이 여러 개 생기도록 워커 수를 고정
+    ThreadPool pool(4);
+    check(samples.size() >= 2 * MIN_PARALLEL_BLOCK_ROWS, "input is long enough for at least two blocks");
+
+    Outputs parallel{std::vector<double>(samples.size()), std::vector<double>(samples.size())};
+    DualAxisKalmanFilter filter = make_filter(params, samples);
+    bool ok = process_parallel_in_time(filter, pool, samples.gps_y, samples.gps_z, samples.acc_y, samples.acc_z,
+                                       samples.fix, parallel.y, parallel.z, true);
+    check(ok, "process_parallel_in_time accepts matching sizes");
+
+    double deviation = max_difference(parallel, serial);
+    check(deviation < PARALLEL_TOLERANCE,
+          "parallel-in-time output matches the serial filter (max |d| = " + std::to_string(deviation) + ")");
+
+    // 처리 후 상태도 순차 필터의 마지막 상태와 같아야 함
+    DualAxisKalmanFilter serial_filter = make_filter(params, samples);
+    std::vector<double> y(samples.size());
+    std::vector<double> z(samples.size());
+    serial_filter.processBatch(samples.gps_y, samples.gps_z, samples.acc_y, samples.acc_z, samples.fix, y, z, true);
+    check(std::fabs(filter.getStateY().position - serial_filter.getStateY().position) < PARALLEL_TOLERANCE &&
+          std::fabs(filter.getStateZ().position - serial_filter.getStateZ().position) < PARALLEL_TOLERANCE,
+          "final state matches the serial filter");
+}
+
+Outputs run_chunked(const KalmanParams& params, const SampleBlock& samples, ThreadPool& pool, size_t chunks,
+                    size_t overlap) {
+    Outputs out{std::vector<double>(samples.size()), std::vector<double>(samples.size())};
+    DualAxisKalmanFilter filter = make_filter(params, samples);
+    bool ok = process_chunked_overlap(filter, pool, chunks, overlap, samples.gps_y, samples.gps_z, samples.acc_y,
+                                      samples.acc_z, samples.fix, out.y, out.z, true);
+    check(ok, "process_chunked_overlap accepts matching sizes");
+    return out;
+}
+
+// 청크 경계 뒤 settle개 샘플을 제외한 최대 편차 (경계는 process_chunked_overlap과 같이 나눔)
+double max_settled_difference(const Outputs& a, const Outputs& b, size_t chunks, size_t settle) {
+    size_t rows = a.y.size() - 1;
+    double result = 0.0;
+    for (size_t i = 0; i < a.y.size(); i++) {
+        bool near_seam = false;
+        for (size_t c = 1; c < chunks; c++) {
+            size_t seam = 1 + rows * c / chunks;
+            near_seam = near_seam || (i >= seam && i < seam + settle);
+        }
+        if (!near_seam) {
+            result = std::max(result, std::max(std::fabs(a.y[i] - b.y[i]), std::fabs(a.z[i] - b.z[i])));
+        }
+    }
+    return result;
+}
+
+void test_chunked_overlap(const KalmanParams& params, const SampleBlock& samples, const Outputs& serial,
+                          const char* input_path) {
+    ThreadPool pool(4);
+    const size_t chunks = 4;
+    size_t n = samples.size();
+
+    // 웜업 없음: 경계 직후에만 편차가 있고 상한 안에서 줄어듦
+    Outputs no_overlap = run_chunked(params, samples, pool, chunks, 0);
+    double seam = max_difference(no_overlap, serial);
+    double settled = max_settled_difference(no_overlap, serial, chunks, SEAM_SETTLE_ROWS);
+    check(seam > 0.0 && seam < SEAM_TOLERANCE,
+          "overlap = 0 seam deviation is bounded (max |d| = " + std::to_string(seam) + ")");
+    check(settled < SETTLED_SEAM_TOLERANCE && settled < seam,
+          "overlap = 0 deviation decays after the seam (max |d| = " + std::to_string(settled) + ")");
+
+    // 웜업 1000샘플: 경계 편차가 거의 사라짐
+    Outputs warm = run_chunked(params, samples, pool, chunks, WARMUP_ROWS);
+    double warm_seam = max_difference(warm, serial);
+    check(warm_seam < WARMUP_SEAM_TOLERANCE,
+          "overlap = 1000 seam deviation is bounded (max |d| = " + std::to_string(warm_seam) + ")");
+
+    // 두 청크에서 overlap이 청크 길이 이상이면 두 번째 청크의 웜업이 입력 시작에 닿음
+    Outputs two_chunks = run_chunked(params, samples, pool, 2, n / 2);
+    check(two_chunks.y == serial.y && two_chunks.z == serial.z,
+          "two chunks with overlap >= chunk length match the serial filter exactly");
+
+    // overlap이 입력 길이 이상이면 모든 청크가 입력 시작부터 다시 처리
+    Outputs full_overlap = run_chunked(params, samples, pool, chunks, n);
+    check(full_overlap.y == serial.y && full_overlap.z == serial.z,
+          "overlap >= input length matches the serial filter exactly");
+
+    // fusion_chunked_deviation은 같은 규칙으로 파일 전체를 비교 (입력이 청크 하나에 들어감)
+    double deviation = -1.0;
+    int result = fusion_chunked_deviation(input_path, params.Q, params.R, chunks, 0, &deviation);
+    check(result == FUSION_SUCCESS && deviation > 0.0 && deviation < SEAM_TOLERANCE,
+          "fusion_chunked_deviation reports the bounded overlap = 0 seam");
+    result = fusion_chunked_deviation(input_path, params.Q, params.R, chunks, n, &deviation);
+    check(result == FUSION_SUCCESS && deviation == 0.0, "fusion_chunked_deviation is zero for full overlap");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: parallel_kalman_filter_test <input.csv>" << std::endl;
+        return 2;
+    }
+
+    SampleBlock samples;
+    if (!parse_csv(argv[1], samples) || samples.empty()) {
+        std::cerr << "cannot read " << argv[1] << std::endl;
+        return 2;
+    }
+
+    // 청크 처리는 fusion_chunked_deviation과 같은 원본 입력으로 검사
+    const KalmanParams params(0.1, 0.01);
+    test_chunked_overlap(params, samples, run_serial(params, samples), argv[1]);
+
+    inject_gaps(samples);
+    Outputs serial = run_serial(params, samples);
+
+    test_parallel_in_time(params, samples, serial);
+
+    return test::finish("parallel_kalman_filter_test");
+}
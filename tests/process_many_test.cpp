@@ -0,0 +1,87 @@
+// fusion_process_many 출력 경로 처리 회귀 테스트
+//
+// 표기만 다른 같은 출력 경로는 중복으로 거부해야 하고,
+// 실시간 모드의 출력별 상태 파일은 확장자만 다른 출력끼리 섞이지 않아야 한다.
+
+#include "fusion_api.h"
+#include "test_check.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace fs = std::filesystem;
+using test::check;
+
+namespace {
+
+void write_input(const fs::path& path, int rows, double offset) {
+    std::ofstream file(path, std::ios::binary);
+    file << "DateTime,GPS_Y,GPS_Z,Acc_Y,Acc_Z,Fix\n";
+    for (int i = 0; i < rows; i++) {
+        file << "10:" << (i / 10 < 10 ? "0" : "") << i / 10 << "." << i % 10 << ","
+             << offset + i * 0.01 << "," << 100.0 + i * 0.02 << ",0.001,-0.002,3\n";
+    }
+}
+
+size_t count_output_rows(const fs::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::string line;
+    size_t rows = 0;
+    while (std::getline(file, line)) {
+        rows += line.empty() ? 0 : 1;
+    }
+    return rows > 0 ? rows - 1 : 0;
+}
+
+} // namespace
+
+int main() {
+    fs::path dir = fs::temp_directory_path() / "fusion_process_many_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "sub");
+    fs::path input_a = dir / "a.csv";
+    fs::path input_b = dir / "b.csv";
+    write_input(input_a, 40, 0.0);
+    write_input(input_b, 60, 5.0);
+
+    // 같은 파일을 가리키는 세 가지 표기: 첫 항목만 실행
+    {
+        std::string paths[3] = {
+            (dir / "out.csv").string(),
+            (dir / "." / "out.csv").string(),
+            (dir / "sub" / ".." / "out.csv").string()
+        };
+        std::string input = input_a.string();
+        const char* inputs[3] = {input.c_str(), input.c_str(), input.c_str()};
+        const char* outputs[3] = {paths[0].c_str(), paths[1].c_str(), paths[2].c_str()};
+        int results[3] = {};
+        fusion_process_many(inputs, outputs, 3, 0.1, 0.01, FUSION_MODE_NORMAL, 0, 2, results);
+        check(results[0] == FUSION_SUCCESS, "first spelling of the output path runs");
+        check(results[1] == FUSION_ERROR_INVALID_DATA, "\"./out.csv\" is rejected as a duplicate");
+        check(results[2] == FUSION_ERROR_INVALID_DATA, "\"sub/../out.csv\" is rejected as a duplicate");
+        check(count_output_rows(dir / "out.csv") == 40, "output is written once");
+    }
+
+    // 확장자만 다른 출력: 상태 파일이 따로 있어야 다시 호출해도 각자 새 행이 없음
+    {
+        std::string a = input_a.string();
+        std::string b = input_b.string();
+        std::string out_csv = (dir / "rt.csv").string();
+        std::string out_txt = (dir / "rt.txt").string();
+        const char* inputs[2] = {a.c_str(), b.c_str()};
+        const char* outputs[2] = {out_csv.c_str(), out_txt.c_str()};
+        for (int call = 0; call < 2; call++) {
+            int results[2] = {};
+            fusion_process_many(inputs, outputs, 2, 0.1, 0.01, FUSION_MODE_REALTIME, 0, 2, results);
+            check(results[0] == FUSION_SUCCESS && results[1] == FUSION_SUCCESS, "realtime jobs succeed");
+        }
+        check(fs::exists(dir / "rt.csv_laststate.txt"), "state file for rt.csv keeps the extension");
+        check(fs::exists(dir / "rt.txt_laststate.txt"), "state file for rt.txt keeps the extension");
+        check(count_output_rows(dir / "rt.csv") == 40, "rt.csv resumes from its own state");
+        check(count_output_rows(dir / "rt.txt") == 60, "rt.txt resumes from its own state");
+    }
+
+    fs::remove_all(dir);
+    return test::finish("process_many_test");
+}
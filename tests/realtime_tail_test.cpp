@@ -0,0 +1,94 @@
+// 실시간 모드 마지막 줄 처리 회귀 테스트
+//
+// 줄바꿈으로 끝나지 않은 마지막 줄은 파일이 그대로이면 처리하고,
+// 이전 호출 이후 파일이 바뀌었으면 기록 중인 줄로 보고 다음 호출로 미뤄야 한다.
+
+#include "fusion_api.h"
+#include "test_check.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace fs = std::filesystem;
+using test::check;
+
+namespace {
+
+std::string make_row(int index) {
+    std::ostringstream row;
+    row << "10:" << (index / 10 < 10 ? "0" : "") << index / 10 << "." << index % 10
+        << "," << index * 0.01 << "," << 100.0 + index * 0.02 << ",0.001,-0.002,3";
+    return row.str();
+}
+
+void append(const fs::path& path, const std::string& text) {
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    file << text;
+}
+
+// 헤더를 제외한 출력 행 수와 마지막 줄
+size_t count_output_rows(const fs::path& path, std::string& last_line) {
+    std::ifstream file(path, std::ios::binary);
+    std::string line;
+    size_t rows = 0;
+    bool header = true;
+    while (std::getline(file, line)) {
+        if (header) {
+            header = false;
+            continue;
+        }
+        if (!line.empty()) {
+            rows++;
+            last_line = line;
+        }
+    }
+    return rows;
+}
+
+int process(const fs::path& input, const fs::path& output) {
+    return fusion_process_csv_realtime(input.string().c_str(), output.string().c_str(), 0.1, 0.01);
+}
+
+} // namespace
+
+int main() {
+    fs::path dir = fs::temp_directory_path() / "fusion_realtime_tail_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    fs::path input = dir / "input.csv";
+    fs::path output = dir / "output.csv";
+
+    // 마지막 줄에 줄바꿈이 없는 입력
+    std::string text = "DateTime,GPS_Y,GPS_Z,Acc_Y,Acc_Z,Fix\n";
+    for (int i = 0; i < 30; i++) {
+        text += make_row(i);
+        text += i + 1 < 30 ? "\n" : "";
+    }
+    append(input, text);
+
+    std::string last_line;
+    check(process(input, output) == FUSION_SUCCESS, "first call succeeds");
+    check(count_output_rows(output, last_line) == 30, "first call outputs the row without a final newline");
+    check(last_line.rfind("10:02.9,", 0) == 0, "last output row is the unterminated input row");
+
+    // 파일이 그대로이면 다시 호출해도 행이 늘거나 빠지지 않음
+    check(process(input, output) == FUSION_SUCCESS, "second call succeeds");
+    check(count_output_rows(output, last_line) == 30, "unchanged input adds no rows");
+
+    // 완성된 행과 기록 중인 행을 덧붙임: 완성된 행만 처리
+    append(input, "\n" + make_row(30) + "\n" + make_row(31).substr(0, 10));
+    check(process(input, output) == FUSION_SUCCESS, "call on growing input succeeds");
+    check(count_output_rows(output, last_line) == 31, "partial row of a growing input is held back");
+
+    // 로거가 줄을 마치지 않고 멈춤: 파일이 그대로이면 마지막 줄도 처리
+    append(input, make_row(31).substr(10));
+    check(process(input, output) == FUSION_SUCCESS, "call after the row is completed succeeds");
+    check(process(input, output) == FUSION_SUCCESS, "call on unchanged input succeeds");
+    check(count_output_rows(output, last_line) == 32, "unterminated row is processed once the input stops changing");
+    check(last_line.rfind("10:03.1,", 0) == 0, "last output row is the completed input row");
+
+    fs::remove_all(dir);
+    return test::finish("realtime_tail_test");
+}
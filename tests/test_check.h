@@ -0,0 +1,36 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+// 회귀 테스트 공용 검사 함수 (실패는 모두 출력하고 종료 코드로 보고)
+
+#include <iostream>
+#include <string>
+
+namespace test {
+
+inline int& failure_count() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        failure_count()++;
+    }
+}
+
+/**
+ * 테스트 종료 코드 (실패가 없으면 통과 메시지 출력)
+ */
+inline int finish(const char* test_name) {
+    if (failure_count() == 0) {
+        std::cout << test_name << " passed" << std::endl;
+        return 0;
+    }
+    return 1;
+}
+
+} // namespace test
+
+#endif // TEST_CHECK_H
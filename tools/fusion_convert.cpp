@@ -0,0 +1,63 @@
+// 입력 CSV를 바이너리 컬럼 입력 파일로 변환
+//
+// 사용법: fusion_convert INPUT.csv [OUTPUT]  (INPUT은 gzip/zstd로 압축된 CSV도 가능)
+// OUTPUT을 생략하면 입력 파일의 확장자를 FUSION_BINARY_INPUT_EXTENSION(.fcin)으로 바꾼 경로에 저장한다
+// (압축된 입력은 .gz/.zst 앞의 확장자까지 바꿈: input.csv.gz → input.fcin).
+// 라이브러리의 경고/오류 메시지는 표준 오류로 출력한다.
+
+#include "fusion_api.h"
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace {
+
+void print_log(int level, const char* message, void* /*user_data*/) {
+    std::cerr << (level >= FUSION_LOG_ERROR ? "Error: " : "Warning: ") << message << std::endl;
+}
+
+bool ends_with(const std::string& text, const char* suffix) {
+    size_t length = std::strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+std::string default_output_path(std::string input_path) {
+    if (ends_with(input_path, ".gz") || ends_with(input_path, ".zst")) {
+        input_path.erase(input_path.find_last_of('.'));
+    }
+    size_t slash = input_path.find_last_of("/\\");
+    size_t dot = input_path.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return input_path + FUSION_BINARY_INPUT_EXTENSION;
+    }
+    return input_path.substr(0, dot) + FUSION_BINARY_INPUT_EXTENSION;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: fusion_convert INPUT.csv [OUTPUT]" << std::endl;
+        return 2;
+    }
+    std::string input_path = argv[1];
+    std::string output_path = argc == 3 ? argv[2] : default_output_path(input_path);
+
+    fusion_set_log_callback(FUSION_LOG_WARNING, print_log, nullptr);
+
+    size_t rows = 0;
+    int result = fusion_convert_csv_to_binary(input_path.c_str(), output_path.c_str(), &rows);
+    if (result != FUSION_SUCCESS) {
+        std::cerr << "Conversion failed: " << fusion_get_error_message(result) << std::endl;
+        return 1;
+    }
+
+    FusionStats stats;
+    fusion_get_last_stats(&stats);
+    std::cout << output_path << ": " << rows << " rows";
+    if (stats.rows_rejected > 0) {
+        std::cout << " (" << stats.rows_rejected << " malformed rows skipped)";
+    }
+    std::cout << std::endl;
+    return 0;
+}